@@ -1,5 +1,6 @@
 #include "stdafx.h"
 
+#include <Path.h>
 #include <Str.h>
 
 #include "Inject.h"
@@ -104,13 +105,15 @@ InjectReply InjectWindow::AskInjectProcess(Process* target_process)
     }
 
     uintptr_t charname_rva;
-    const ProcessScanner scanner(processes.data());
-    if (!scanner.FindPatternRva("\x8B\xF8\x6A\x03\x68\x0F\x00\x00\xC0\x8B\xCF\xE8", "xxxxxxxxxxxx", -0x42, &charname_rva)) {
-        return InjectReply_PatternError;
-    }
-
     uintptr_t email_rva;
-    if (!scanner.FindPatternRva("\x33\xC0\x5D\xC2\x10\x00\xCC\x68\x80\x00\x00\x00", "xxxxxxxxxxxx", 0xE, &email_rva)) {
+    PatternRequest patterns[] = {
+        {"\x8B\xF8\x6A\x03\x68\x0F\x00\x00\xC0\x8B\xCF\xE8", "xxxxxxxxxxxx", -0x42, &charname_rva},
+        {"\x33\xC0\x5D\xC2\x10\x00\xCC\x68\x80\x00\x00\x00", "xxxxxxxxxxxx", 0xE, &email_rva}
+    };
+    const ProcessScanner scanner(processes.data());
+    std::filesystem::path scan_cache_path;
+    const bool has_cache_path = PathGetDocumentsPath(scan_cache_path, L"GWToolboxpp\\scan_cache.json");
+    if (!scanner.FindPatternsRva(patterns, ARRAY_SIZE(patterns), has_cache_path ? &scan_cache_path : nullptr)) {
         return InjectReply_PatternError;
     }
 
@@ -1,5 +1,9 @@
 #include "stdafx.h"
 
+#include <intrin.h>
+
+#include <Path.h>
+
 #include "Process.h"
 
 Process::Process(const uint32_t pid, const DWORD rights) noexcept
@@ -341,19 +345,237 @@ uintptr_t ProcessScanner::FindPattern(const char* pattern, const char* mask, con
 
 bool ProcessScanner::FindPatternRva(const char* pattern, const char* mask, const int offset, uintptr_t* rva) const
 {
-    const size_t length = strlen(mask);
-    const auto upattern = reinterpret_cast<const uint8_t*>(pattern);
-    for (size_t i = 0; i < m_size; i++) {
-        size_t j;
-        for (j = 0; j < length; j++) {
-            if (mask[j] == 'x' && m_buffer[i + j] != upattern[j]) {
-                break;
+    PatternRequest request = {pattern, mask, offset, rva};
+    return ScanPatternsRva(&request, 1);
+}
+
+uint64_t ProcessScanner::GetBuildId() const
+{
+    if (!m_buffer || m_size < sizeof(IMAGE_DOS_HEADER)) {
+        return 0;
+    }
+    const auto dos_header = reinterpret_cast<const IMAGE_DOS_HEADER*>(m_buffer);
+    if (dos_header->e_magic != IMAGE_DOS_SIGNATURE || dos_header->e_lfanew < 0
+        || static_cast<size_t>(dos_header->e_lfanew) + sizeof(IMAGE_NT_HEADERS32) > m_size) {
+        return 0;
+    }
+    const auto nt_headers = reinterpret_cast<const IMAGE_NT_HEADERS32*>(m_buffer + dos_header->e_lfanew);
+    if (nt_headers->Signature != IMAGE_NT_SIGNATURE) {
+        return 0;
+    }
+    const uint64_t timestamp = nt_headers->FileHeader.TimeDateStamp;
+    const uint64_t checksum = nt_headers->OptionalHeader.CheckSum ^ nt_headers->OptionalHeader.SizeOfImage;
+    return timestamp << 32 | checksum;
+}
+
+namespace {
+    // Identifies a request in the cache file: pattern bytes as hex with "??" for wildcards, then the offset
+    std::string PatternKey(const PatternRequest& request)
+    {
+        std::string key;
+        const size_t length = strlen(request.mask);
+        key.reserve(length * 2 + 12);
+        char buf[16];
+        for (size_t i = 0; i < length; i++) {
+            if (request.mask[i] == 'x') {
+                snprintf(buf, sizeof(buf), "%02X", static_cast<uint8_t>(request.pattern[i]));
+                key += buf;
             }
+            else {
+                key += "??";
+            }
+        }
+        snprintf(buf, sizeof(buf), "%+d", request.offset);
+        key += buf;
+        return key;
+    }
+
+    std::string BuildIdString(const uint64_t build_id)
+    {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%016llX", build_id);
+        return buf;
+    }
+
+    bool ReadScanCache(const std::filesystem::path& path, const uint64_t build_id, PatternRequest* requests, const size_t count)
+    {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            return false;
+        }
+        nlohmann::json json = nlohmann::json::parse(file, nullptr, false);
+        if (json.is_discarded() || !json.is_object()) {
+            return false;
+        }
+        const auto it_build = json.find("build");
+        const auto it_patterns = json.find("patterns");
+        if (it_build == json.end() || !it_build->is_string() || it_build->get<std::string>() != BuildIdString(build_id)) {
+            return false;
+        }
+        if (it_patterns == json.end() || !it_patterns->is_object()) {
+            return false;
+        }
+        std::vector<uintptr_t> found(count);
+        for (size_t i = 0; i < count; i++) {
+            const auto it = it_patterns->find(PatternKey(requests[i]));
+            if (it == it_patterns->end() || !it->is_number_unsigned()) {
+                return false;
+            }
+            found[i] = it->get<uintptr_t>();
+        }
+        for (size_t i = 0; i < count; i++) {
+            *requests[i].rva = found[i];
+        }
+        return true;
+    }
+
+    void WriteScanCache(const std::filesystem::path& path, const uint64_t build_id, const PatternRequest* requests, const size_t count)
+    {
+        nlohmann::json json;
+        json["build"] = BuildIdString(build_id);
+        auto& patterns = json["patterns"] = nlohmann::json::object();
+        for (size_t i = 0; i < count; i++) {
+            patterns[PatternKey(requests[i])] = *requests[i].rva;
+        }
+        if (!PathCreateDirectorySafe(path.parent_path())) {
+            return;
+        }
+        std::ofstream file(path, std::ios::trunc);
+        if (!file.is_open()) {
+            fprintf(stderr, "Couldn't write scan cache '%ls'\n", path.c_str());
+            return;
+        }
+        file << json.dump();
+    }
+}
+
+bool ProcessScanner::FindPatternsRva(PatternRequest* requests, const size_t count, const std::filesystem::path* cache_path) const
+{
+    const uint64_t build_id = cache_path ? GetBuildId() : 0;
+    if (build_id && ReadScanCache(*cache_path, build_id, requests, count)) {
+        // The build id comes from header fields that don't have to change between builds; make sure the module still has each pattern where the cache says
+        bool valid = true;
+        for (size_t i = 0; i < count && valid; i++) {
+            valid = MatchesAt(requests[i], *requests[i].rva - requests[i].offset);
         }
-        if (j == length) {
-            *rva = i + offset;
+        if (valid) {
             return true;
         }
     }
-    return false;
+    if (!ScanPatternsRva(requests, count)) {
+        return false;
+    }
+    if (build_id) {
+        WriteScanCache(*cache_path, build_id, requests, count);
+    }
+    return true;
+}
+
+bool ProcessScanner::MatchesAt(const PatternRequest& request, const uintptr_t rva) const
+{
+    const size_t length = strlen(request.mask);
+    if (!m_buffer || rva > m_size || length > m_size - rva) {
+        return false;
+    }
+    for (size_t i = 0; i < length; i++) {
+        if (request.mask[i] == 'x' && m_buffer[rva + i] != static_cast<uint8_t>(request.pattern[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ProcessScanner::ScanPatternsRva(PatternRequest* requests, const size_t count) const
+{
+    // Each pattern is anchored on its first non-wildcard byte. The sweep only stops at positions holding one of the anchor bytes,
+    // then checks the patterns anchored on that byte; every pattern is found in the same pass over the module.
+    struct Compiled {
+        const uint8_t* bytes;
+        const char* mask;
+        size_t length;
+        size_t anchor;
+        bool found;
+    };
+    std::vector<Compiled> compiled(count);
+    std::vector<uint32_t> by_anchor[256];
+    std::vector<uint8_t> anchor_bytes;
+    size_t remaining = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        Compiled& c = compiled[i];
+        c.bytes = reinterpret_cast<const uint8_t*>(requests[i].pattern);
+        c.mask = requests[i].mask;
+        c.length = strlen(c.mask);
+        c.anchor = 0;
+        while (c.anchor < c.length && c.mask[c.anchor] != 'x') {
+            c.anchor++;
+        }
+        c.found = false;
+        if (c.length > m_size) {
+            continue;
+        }
+        if (c.anchor == c.length) {
+            // all wildcards; matches at the start of the module
+            *requests[i].rva = requests[i].offset;
+            c.found = true;
+            continue;
+        }
+        const uint8_t anchor_byte = c.bytes[c.anchor];
+        if (by_anchor[anchor_byte].empty()) {
+            anchor_bytes.push_back(anchor_byte);
+        }
+        by_anchor[anchor_byte].push_back(static_cast<uint32_t>(i));
+        remaining++;
+    }
+
+    const auto try_match = [&](const size_t pos) {
+        for (const uint32_t idx : by_anchor[m_buffer[pos]]) {
+            Compiled& c = compiled[idx];
+            if (c.found || pos < c.anchor) {
+                continue;
+            }
+            const size_t start = pos - c.anchor;
+            if (start + c.length > m_size) {
+                continue;
+            }
+            size_t j = c.anchor + 1;
+            while (j < c.length && (c.mask[j] != 'x' || m_buffer[start + j] == c.bytes[j])) {
+                j++;
+            }
+            if (j == c.length) {
+                c.found = true;
+                *requests[idx].rva = start + requests[idx].offset;
+                remaining--;
+            }
+        }
+    };
+
+    size_t pos = 0;
+    if (!anchor_bytes.empty() && anchor_bytes.size() <= 4) {
+        // Few distinct anchors: compare 16 bytes at a time and only look closer at blocks containing one of them
+        __m128i anchors[4];
+        for (size_t i = 0; i < 4; i++) {
+            anchors[i] = _mm_set1_epi8(static_cast<char>(anchor_bytes[std::min(i, anchor_bytes.size() - 1)]));
+        }
+        for (; remaining && pos + 16 <= m_size; pos += 16) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_buffer + pos));
+            const __m128i hits = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(block, anchors[0]), _mm_cmpeq_epi8(block, anchors[1])),
+                _mm_or_si128(_mm_cmpeq_epi8(block, anchors[2]), _mm_cmpeq_epi8(block, anchors[3])));
+            auto bits = static_cast<unsigned>(_mm_movemask_epi8(hits));
+            while (bits && remaining) {
+                unsigned long bit;
+                _BitScanForward(&bit, bits);
+                bits &= bits - 1;
+                try_match(pos + bit);
+            }
+        }
+    }
+    for (; remaining && pos < m_size; pos++) {
+        if (!by_anchor[m_buffer[pos]].empty()) {
+            try_match(pos);
+        }
+    }
+
+    return std::ranges::all_of(compiled, [](const Compiled& c) { return c.found; });
 }
@@ -40,6 +40,13 @@ private:
 bool GetProcesses(std::vector<Process>& processes, const wchar_t* name, DWORD rights = PROCESS_ALL_ACCESS);
 bool GetProcessesFromWindowClass(std::vector<Process>& processes, const wchar_t* classname, DWORD rights = PROCESS_ALL_ACCESS);
 
+struct PatternRequest {
+    const char* pattern = nullptr;
+    const char* mask = nullptr;
+    int offset = 0;
+    uintptr_t* rva = nullptr; // out
+};
+
 class ProcessScanner {
 public:
     ProcessScanner(Process* process);
@@ -49,7 +56,18 @@ public:
     uintptr_t FindPattern(const char* pattern, const char* mask, int Offset) const;
     bool FindPatternRva(const char* pattern, const char* mask, int offset, uintptr_t* rva) const;
 
+    // Finds all patterns in a single sweep over the module; returns false if any of them wasn't found.
+    // If cache_path is given, results for the same game build are read from / written to that file instead of scanning.
+    bool FindPatternsRva(PatternRequest* requests, size_t count, const std::filesystem::path* cache_path = nullptr) const;
+
+    // Identifies the game build from its PE header (timestamp, checksum and image size); 0 if the header can't be read
+    uint64_t GetBuildId() const;
+
 private:
+    bool ScanPatternsRva(PatternRequest* requests, size_t count) const;
+    // Whether the pattern matches the module at rva, i.e. where a match would start before applying the request's offset
+    bool MatchesAt(const PatternRequest& request, uintptr_t rva) const;
+
     uintptr_t m_base = 0;
     size_t m_size = 0;
     uint8_t* m_buffer = nullptr;
@@ -0,0 +1,530 @@
+#include "stdafx.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <share.h>
+
+#include <BinaryLog.h>
+#include <Utf8.h>
+
+namespace {
+    using namespace BinaryLog;
+
+    // Per thread; must be a power of two
+    constexpr size_t ring_size = 64 * 1024;
+    constexpr size_t max_entry_size = 2048;
+    constexpr size_t max_string_units = 512;
+    constexpr auto flush_interval = std::chrono::milliseconds(100);
+
+    // Single producer (the thread it belongs to), single consumer (whoever is flushing) queue of encoded records,
+    // each prefixed with its uint16 size
+    struct ThreadRing {
+        explicit ThreadRing(const uint32_t _thread_id)
+            : thread_id(_thread_id) { }
+
+        const uint32_t thread_id;
+        // Total bytes ever written and read; positions in data are these modulo ring_size
+        std::atomic<size_t> head = 0;
+        std::atomic<size_t> tail = 0;
+        std::atomic<uint32_t> dropped = 0;
+        std::atomic<bool> exited = false;
+        // Format ids this thread has looked up before; only touched by the owning thread
+        std::unordered_map<const void*, uint32_t> format_ids;
+        uint8_t data[ring_size];
+
+        bool Push(const uint8_t* record, const uint16_t size)
+        {
+            const size_t h = head.load(std::memory_order_relaxed);
+            const size_t t = tail.load(std::memory_order_acquire);
+            if (ring_size - (h - t) < sizeof(size) + size) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            CopyIn(h, &size, sizeof(size));
+            CopyIn(h + sizeof(size), record, size);
+            head.store(h + sizeof(size) + size, std::memory_order_release);
+            return true;
+        }
+
+        // Appends every waiting record to out, without the size prefixes
+        void Drain(std::vector<uint8_t>& out)
+        {
+            const size_t h = head.load(std::memory_order_acquire);
+            size_t t = tail.load(std::memory_order_relaxed);
+            while (t != h) {
+                uint16_t size;
+                CopyOut(t, &size, sizeof(size));
+                const size_t offset = out.size();
+                out.resize(offset + size);
+                CopyOut(t + sizeof(size), out.data() + offset, size);
+                t += sizeof(size) + size;
+            }
+            tail.store(t, std::memory_order_release);
+        }
+
+        // Same, but written record by record straight to out through a stack buffer; for the crash path, which mustn't allocate
+        void DrainTo(FILE* out)
+        {
+            uint8_t record[max_entry_size];
+            const size_t h = head.load(std::memory_order_acquire);
+            size_t t = tail.load(std::memory_order_relaxed);
+            while (t != h) {
+                uint16_t size;
+                CopyOut(t, &size, sizeof(size));
+                if (size > sizeof(record)) {
+                    break; // Can't happen unless the ring is corrupt, which when crashing it might be
+                }
+                CopyOut(t + sizeof(size), record, size);
+                fwrite(record, 1, size, out);
+                t += sizeof(size) + size;
+            }
+            tail.store(t, std::memory_order_release);
+        }
+
+        [[nodiscard]] bool Empty() const { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_relaxed); }
+        [[nodiscard]] size_t Used() const { return head.load(std::memory_order_relaxed) - tail.load(std::memory_order_relaxed); }
+
+    private:
+        void CopyIn(const size_t pos, const void* src, const size_t len)
+        {
+            const size_t offset = pos & (ring_size - 1);
+            const size_t first = std::min(len, ring_size - offset);
+            memcpy(data + offset, src, first);
+            memcpy(data, static_cast<const uint8_t*>(src) + first, len - first);
+        }
+
+        void CopyOut(const size_t pos, void* dst, const size_t len) const
+        {
+            const size_t offset = pos & (ring_size - 1);
+            const size_t first = std::min(len, ring_size - offset);
+            memcpy(dst, data + offset, first);
+            memcpy(static_cast<uint8_t*>(dst) + first, data, len - first);
+        }
+    };
+
+    // Keeps the thread's ring alive for the flush thread after the thread exits
+    struct LocalRing {
+        std::shared_ptr<ThreadRing> ring;
+
+        ~LocalRing()
+        {
+            if (ring) {
+                ring->exited = true;
+            }
+        }
+    };
+
+    thread_local LocalRing local_ring;
+
+    std::mutex rings_mutex;
+    std::vector<std::shared_ptr<ThreadRing>> rings;
+
+    struct PendingFormat {
+        uint32_t id;
+        bool wide;
+        const void* text;
+    };
+
+    std::mutex formats_mutex;
+    std::unordered_map<const void*, uint32_t> format_ids;
+    // Registered since the last flush
+    std::vector<PendingFormat> pending_formats;
+
+    std::atomic<bool> is_open = false;
+    std::chrono::steady_clock::time_point start_time;
+    // Read only sections of this dll; a format in one of these is a string literal, and its address identifies it
+    std::vector<std::pair<uintptr_t, uintptr_t>> literal_ranges;
+
+    std::timed_mutex file_mutex;
+    FILE* file = nullptr;
+    std::vector<uint8_t> drained;
+
+    std::thread flush_thread;
+    std::mutex wake_mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    // An encoded record, built on the stack of the logging thread
+    struct Record {
+        uint8_t data[max_entry_size];
+        size_t size = 0;
+
+        template <typename T>
+        void Put(const T value)
+        {
+            memcpy(data + size, &value, sizeof(value));
+            size += sizeof(value);
+        }
+
+        // Truncated to fit
+        template <typename Char>
+        void PutString(const Char* str)
+        {
+            if (!str) {
+                Put(ArgType::NullString);
+                return;
+            }
+            constexpr size_t prefix = sizeof(ArgType) + sizeof(uint16_t);
+            const size_t space = size + prefix < sizeof(data) ? (sizeof(data) - size - prefix) / sizeof(Char) : 0;
+            size_t len = 0;
+            while (len < space && len < max_string_units && str[len]) {
+                len++;
+            }
+            Put(std::is_same_v<Char, wchar_t> ? ArgType::WideString : ArgType::String);
+            Put(static_cast<uint16_t>(len));
+            memcpy(data + size, str, len * sizeof(Char));
+            size += len * sizeof(Char);
+        }
+
+        // Room for the next specification's arguments, unless it's a string; those are truncated instead
+        [[nodiscard]] bool HasRoom() const { return size + 32 <= sizeof(data); }
+    };
+
+    void FindLiteralRanges()
+    {
+        literal_ranges.clear();
+        HMODULE module = nullptr;
+        if (!GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                                reinterpret_cast<LPCWSTR>(&FindLiteralRanges), &module)) {
+            return;
+        }
+        const auto base = reinterpret_cast<uintptr_t>(module);
+        const auto dos_header = reinterpret_cast<const IMAGE_DOS_HEADER*>(base);
+        const auto nt_headers = reinterpret_cast<const IMAGE_NT_HEADERS*>(base + dos_header->e_lfanew);
+        const IMAGE_SECTION_HEADER* section = IMAGE_FIRST_SECTION(nt_headers);
+        for (WORD i = 0; i < nt_headers->FileHeader.NumberOfSections; i++, section++) {
+            if (!(section->Characteristics & IMAGE_SCN_MEM_WRITE)) {
+                const uintptr_t start = base + section->VirtualAddress;
+                literal_ranges.emplace_back(start, start + section->Misc.VirtualSize);
+            }
+        }
+    }
+
+    bool IsLiteral(const void* format)
+    {
+        const auto address = reinterpret_cast<uintptr_t>(format);
+        return std::ranges::any_of(literal_ranges, [address](const auto& range) {
+            return address >= range.first && address < range.second;
+        });
+    }
+
+    ThreadRing& GetThreadRing()
+    {
+        auto& ring = local_ring.ring;
+        if (!ring) {
+            ring = std::make_shared<ThreadRing>(GetCurrentThreadId());
+            std::lock_guard lock(rings_mutex);
+            rings.push_back(ring);
+        }
+        return *ring;
+    }
+
+    uint32_t GetFormatId(ThreadRing& ring, const void* format, const bool wide)
+    {
+        if (const auto found = ring.format_ids.find(format); found != ring.format_ids.end()) {
+            return found->second;
+        }
+        uint32_t id;
+        {
+            std::lock_guard lock(formats_mutex);
+            const auto [found, added] = format_ids.emplace(format, static_cast<uint32_t>(format_ids.size() + 1));
+            if (added) {
+                pending_formats.push_back({found->second, wide, format});
+            }
+            id = found->second;
+        }
+        ring.format_ids.emplace(format, id);
+        return id;
+    }
+
+    void PutEntryHeader(Record& record, const RecordType type, const ThreadRing& ring, const Level level, const Category category)
+    {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time);
+        record.Put(type);
+        record.Put(static_cast<uint64_t>(elapsed.count()));
+        record.Put(ring.thread_id);
+        record.Put(level);
+        record.Put(category);
+    }
+
+    // Copies the arguments format uses into record; false if format has a specification we can't follow
+    template <typename Char>
+    bool PutArguments(Record& record, const Char* format, va_list args)
+    {
+        constexpr bool wide = std::is_same_v<Char, wchar_t>;
+        FormatSpec<Char> spec;
+        const Char* next = format;
+        while ((next = NextFormatSpec(next, wide, spec)) != nullptr) {
+            if (!record.HasRoom()) {
+                return false;
+            }
+            for (uint8_t i = 0; i < spec.star_args; i++) {
+                record.Put(ArgType::Int32);
+                record.Put(va_arg(args, int));
+            }
+            switch (spec.conversion) {
+                case Conversion::Int:
+                case Conversion::Char:
+                case Conversion::WideChar:
+                    record.Put(ArgType::Int32);
+                    record.Put(va_arg(args, int));
+                    break;
+                case Conversion::LongLong:
+                    record.Put(ArgType::Int64);
+                    record.Put(va_arg(args, long long));
+                    break;
+                case Conversion::Size:
+                    record.Put(sizeof(size_t) == sizeof(int64_t) ? ArgType::Int64 : ArgType::Int32);
+                    record.Put(va_arg(args, size_t));
+                    break;
+                case Conversion::Double:
+                    record.Put(ArgType::Double);
+                    record.Put(va_arg(args, double));
+                    break;
+                case Conversion::Pointer:
+                    record.Put(ArgType::Pointer);
+                    record.Put(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(va_arg(args, void*))));
+                    break;
+                case Conversion::String:
+                    record.PutString(va_arg(args, const char*));
+                    break;
+                case Conversion::WideString:
+                    record.PutString(va_arg(args, const wchar_t*));
+                    break;
+                default:
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    int FormatText(char* buffer, const size_t size, const char* format, va_list args)
+    {
+        return vsnprintf(buffer, size, format, args);
+    }
+
+    int FormatText(wchar_t* buffer, const size_t size, const wchar_t* format, va_list args)
+    {
+        return vswprintf(buffer, size, format, args);
+    }
+
+    template <typename Char>
+    void WriteEntry(const Level level, const Category category, const Char* format, va_list args)
+    {
+        if (!is_open || !format) {
+            return;
+        }
+        auto& ring = GetThreadRing();
+        Record record;
+        bool encoded = false;
+        if (IsLiteral(format)) {
+            PutEntryHeader(record, RecordType::Entry, ring, level, category);
+            record.Put(GetFormatId(ring, format, std::is_same_v<Char, wchar_t>));
+            const size_t length_offset = record.size;
+            record.Put(uint16_t{0});
+            va_list args_copy;
+            va_copy(args_copy, args);
+            encoded = PutArguments(record, format, args_copy);
+            va_end(args_copy);
+            const auto length = static_cast<uint16_t>(record.size - length_offset - sizeof(uint16_t));
+            memcpy(record.data + length_offset, &length, sizeof(length));
+        }
+        if (!encoded) {
+            // Built at runtime, or too much to capture; format it here instead
+            Char text[max_string_units];
+            if (FormatText(text, _countof(text), format, args) < 0) {
+                text[_countof(text) - 1] = 0;
+            }
+            record.size = 0;
+            PutEntryHeader(record, RecordType::Text, ring, level, category);
+            record.PutString(text);
+        }
+        ring.Push(record.data, static_cast<uint16_t>(record.size));
+        if (ring.Used() > ring_size / 2) {
+            wake.notify_one();
+        }
+    }
+
+    template <typename T>
+    void Append(std::vector<uint8_t>& out, const T value)
+    {
+        const auto bytes = reinterpret_cast<const uint8_t*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(value));
+    }
+
+    // file_mutex is held
+    void FlushLocked()
+    {
+        if (!file) {
+            return;
+        }
+        // Drain before taking the new formats: anything drained was encoded after its format was registered
+        drained.clear();
+        {
+            std::lock_guard lock(rings_mutex);
+            for (auto it = rings.begin(); it != rings.end();) {
+                auto& ring = **it;
+                ring.Drain(drained);
+                if (const auto dropped = ring.dropped.exchange(0)) {
+                    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time);
+                    Append(drained, RecordType::Dropped);
+                    Append(drained, static_cast<uint64_t>(elapsed.count()));
+                    Append(drained, ring.thread_id);
+                    Append(drained, dropped);
+                }
+                if (ring.exited && ring.Empty()) {
+                    it = rings.erase(it);
+                }
+                else {
+                    ++it;
+                }
+            }
+        }
+        std::vector<PendingFormat> formats;
+        {
+            std::lock_guard lock(formats_mutex);
+            formats.swap(pending_formats);
+        }
+        std::vector<uint8_t> definitions;
+        std::string text;
+        for (const auto& format : formats) {
+            if (format.wide) {
+                utf8::FromWide(static_cast<const wchar_t*>(format.text), text);
+            }
+            else {
+                text = static_cast<const char*>(format.text);
+            }
+            text.resize(std::min<size_t>(text.size(), UINT16_MAX));
+            Append(definitions, RecordType::Format);
+            Append(definitions, format.id);
+            Append(definitions, static_cast<uint8_t>(format.wide));
+            Append(definitions, static_cast<uint16_t>(text.size()));
+            definitions.insert(definitions.end(), text.begin(), text.end());
+        }
+        fwrite(definitions.data(), 1, definitions.size(), file);
+        fwrite(drained.data(), 1, drained.size(), file);
+        fflush(file);
+    }
+
+    // Writes a Format record without allocating; text longer than max_string_units is cut short
+    void WriteFormatDirect(const PendingFormat& format)
+    {
+        char text[max_string_units * 3];
+        int len;
+        if (format.wide) {
+            const auto wide = static_cast<const wchar_t*>(format.text);
+            len = WideCharToMultiByte(CP_UTF8, 0, wide, static_cast<int>(wcsnlen(wide, max_string_units)), text, static_cast<int>(sizeof(text)), nullptr, nullptr);
+        }
+        else {
+            len = static_cast<int>(strnlen(static_cast<const char*>(format.text), max_string_units));
+            memcpy(text, format.text, static_cast<size_t>(len));
+        }
+        const auto type = RecordType::Format;
+        const auto wide = static_cast<uint8_t>(format.wide);
+        const auto length = static_cast<uint16_t>(std::max(len, 0));
+        fwrite(&type, sizeof(type), 1, file);
+        fwrite(&format.id, sizeof(format.id), 1, file);
+        fwrite(&wide, sizeof(wide), 1, file);
+        fwrite(&length, sizeof(length), 1, file);
+        fwrite(text, 1, length, file);
+    }
+
+    // file_mutex is held. For the crash handler: the crashing thread may itself be holding rings_mutex or formats_mutex, and
+    // the heap may be in any state, so this gives up rather than wait on either, and writes straight to the file.
+    void FlushCrashing()
+    {
+        if (!file) {
+            return;
+        }
+        std::unique_lock rings_lock(rings_mutex, std::try_to_lock);
+        std::unique_lock formats_lock(formats_mutex, std::try_to_lock);
+        if (!rings_lock.owns_lock() || !formats_lock.owns_lock()) {
+            return;
+        }
+        // Formats first; holding formats_mutex while draining means no entry can refer to a format registered after these
+        for (const auto& format : pending_formats) {
+            WriteFormatDirect(format);
+        }
+        pending_formats.clear();
+        for (const auto& ring : rings) {
+            ring->DrainTo(file);
+        }
+        fflush(file);
+    }
+
+    void FlushThread()
+    {
+        std::unique_lock lock(wake_mutex);
+        while (!stopping) {
+            wake.wait_for(lock, flush_interval);
+            lock.unlock();
+            {
+                std::lock_guard file_lock(file_mutex);
+                FlushLocked();
+            }
+            lock.lock();
+        }
+    }
+}
+
+bool BinaryLog::Open(const std::filesystem::path& path)
+{
+    if (is_open) {
+        return true;
+    }
+    file = _wfsopen(path.c_str(), L"wb", _SH_DENYWR);
+    if (!file) {
+        return false;
+    }
+    FindLiteralRanges();
+    start_time = std::chrono::steady_clock::now();
+    const auto start_unix_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch());
+    std::vector<uint8_t> header(std::begin(magic), std::end(magic));
+    Append(header, version);
+    Append(header, static_cast<uint32_t>(sizeof(void*)));
+    Append(header, static_cast<int64_t>(start_unix_us.count()));
+    fwrite(header.data(), 1, header.size(), file);
+
+    stopping = false;
+    flush_thread = std::thread(FlushThread);
+    is_open = true;
+    return true;
+}
+
+void BinaryLog::Close()
+{
+    if (!is_open) {
+        return;
+    }
+    is_open = false;
+    {
+        std::lock_guard lock(wake_mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    if (flush_thread.joinable()) {
+        flush_thread.join();
+    }
+    std::lock_guard lock(file_mutex);
+    FlushLocked();
+    fclose(file);
+    file = nullptr;
+}
+
+void BinaryLog::Flush()
+{
+    std::unique_lock lock(file_mutex, std::defer_lock);
+    if (lock.try_lock_for(std::chrono::milliseconds(500))) {
+        FlushCrashing();
+    }
+}
+
+void BinaryLog::Write(const Level level, const Category category, const char* format, va_list args)
+{
+    WriteEntry(level, category, format, args);
+}
+
+void BinaryLog::Write(const Level level, const Category category, const wchar_t* format, va_list args)
+{
+    WriteEntry(level, category, format, args);
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <BinaryLogFormat.h>
+
+// Writer for the binary log; see BinaryLogFormat.h for the layout, and the LogDecoder tool to read it.
+// Logging an entry copies its arguments into a buffer belonging to the calling thread, without locking, formatting or touching
+// the disk; a background thread writes the buffers out every 100ms. A thread that logs faster than that loses entries, and the
+// number lost is logged instead.
+namespace BinaryLog {
+    bool Open(const std::filesystem::path& path);
+    // Writes out everything logged so far and stops the background thread
+    void Close();
+    // Writes out everything logged so far, for the crash handler: never allocates, gives up after a short wait if another thread is
+    // in the middle of writing, and skips the flush if the log's internal locks are taken, e.g. by the thread that crashed.
+    void Flush();
+
+    void Write(Level level, Category category, const char* format, va_list args);
+    void Write(Level level, Category category, const wchar_t* format, va_list args);
+}
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+// Layout of the binary log that Log::Log and Log::LogW write (log.bin), shared with the LogDecoder tool; standard C++ only.
+// Instead of formatting on the calling thread, a log entry stores the id of its printf format and the raw arguments; the format
+// text is written once, the first time it's used. Values are little endian and unaligned.
+//
+// The file starts with: magic, uint32 version, uint32 pointer size of the process, int64 unix time in microseconds of time 0.
+// Then records, each a RecordType byte followed by:
+//   Format:  uint32 id, uint8 1 if it was a wide format, uint16 length, utf8 text
+//   Entry:   entry header, uint32 format id, uint16 length, arguments as ArgType byte + value, one per argument the format uses
+//   Text:    entry header, ArgType::String or ArgType::WideString; for messages with a format that isn't a string literal
+//   Dropped: uint64 microseconds since time 0, uint32 thread id, uint32 number of entries lost because the thread's buffer was full
+// where the entry header is uint64 microseconds since time 0, uint32 thread id, uint8 Level, uint8 Category.
+// Strings are a uint16 count of code units followed by the units (utf16 for WideString); other values are stored as is,
+// pointers as uint64.
+namespace BinaryLog {
+    constexpr char magic[8] = {'G', 'W', 'T', 'B', 'L', 'O', 'G', '\0'};
+    constexpr uint32_t version = 1;
+
+    enum class RecordType : uint8_t {
+        Format = 1,
+        Entry,
+        Text,
+        Dropped
+    };
+
+    enum class Level : uint8_t {
+        Debug,
+        Info,
+        Warning,
+        Error,
+        Count
+    };
+    constexpr const char* level_names[] = {"Debug", "Info", "Warning", "Error"};
+    static_assert(std::size(level_names) == static_cast<size_t>(Level::Count));
+
+    enum class Category : uint8_t {
+        General,
+        Gwca,
+        Chat,
+        Resources,
+        Count
+    };
+    constexpr const char* category_names[] = {"General", "GWCA", "Chat", "Resources"};
+    static_assert(std::size(category_names) == static_cast<size_t>(Category::Count));
+
+    enum class ArgType : uint8_t {
+        Int32 = 1,
+        Int64,
+        Double,
+        Pointer,
+        String,
+        WideString,
+        NullString
+    };
+
+    // What a conversion specification in a printf format consumes, using the MSVC rules: in a wide format %s is a wide
+    // string and %S a narrow one, and the other way around in a narrow format; h forces narrow, l and w force wide.
+    enum class Conversion : uint8_t {
+        // %% or the end of the format
+        None,
+        Int,
+        LongLong,
+        // z, t, I: size of a pointer in the process that logged it
+        Size,
+        Double,
+        Pointer,
+        Char,
+        WideChar,
+        String,
+        WideString,
+        // Anything else; the arguments can't be followed past this point
+        Invalid
+    };
+
+    template <typename Char>
+    struct FormatSpec {
+        // The whole specification, from the % up to and including the conversion character
+        const Char* begin = nullptr;
+        const Char* end = nullptr;
+        // Width and precision given as *, each taking an int argument before the value
+        uint8_t star_args = 0;
+        Conversion conversion = Conversion::None;
+    };
+
+    // Finds the next conversion specification in format; spec.conversion is None once there are no more
+    template <typename Char>
+    const Char* NextFormatSpec(const Char* format, const bool wide, FormatSpec<Char>& spec)
+    {
+        spec = {};
+        for (const Char* p = format; *p; p++) {
+            if (*p != '%') {
+                continue;
+            }
+            spec.begin = p++;
+            if (*p == '%') {
+                continue;
+            }
+            while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0') {
+                p++;
+            }
+            if (*p == '*') {
+                spec.star_args++;
+                p++;
+            }
+            while (*p >= '0' && *p <= '9') {
+                p++;
+            }
+            if (*p == '.') {
+                p++;
+                if (*p == '*') {
+                    spec.star_args++;
+                    p++;
+                }
+                while (*p >= '0' && *p <= '9') {
+                    p++;
+                }
+            }
+            // Length modifier: 0 none, 'h' short/narrow, 'l' long/wide, 'L' long long, 'z' pointer sized
+            char length = 0;
+            switch (*p) {
+                case 'h':
+                    length = 'h';
+                    p += p[1] == 'h' ? 2 : 1;
+                    break;
+                case 'l':
+                    length = p[1] == 'l' ? 'L' : 'l';
+                    p += p[1] == 'l' ? 2 : 1;
+                    break;
+                case 'w':
+                    length = 'l';
+                    p++;
+                    break;
+                case 'L':
+                case 'j':
+                    length = 'L';
+                    p++;
+                    break;
+                case 'z':
+                case 't':
+                    length = 'z';
+                    p++;
+                    break;
+                case 'I':
+                    if (p[1] == '6' && p[2] == '4') {
+                        length = 'L';
+                        p += 3;
+                    }
+                    else if (p[1] == '3' && p[2] == '2') {
+                        p += 3;
+                    }
+                    else {
+                        length = 'z';
+                        p++;
+                    }
+                    break;
+                default:
+                    break;
+            }
+            spec.end = p + 1;
+            switch (*p) {
+                case 'd':
+                case 'i':
+                case 'u':
+                case 'o':
+                case 'x':
+                case 'X':
+                    spec.conversion = length == 'L' ? Conversion::LongLong : length == 'z' ? Conversion::Size : Conversion::Int;
+                    break;
+                case 'f':
+                case 'F':
+                case 'e':
+                case 'E':
+                case 'g':
+                case 'G':
+                case 'a':
+                case 'A':
+                    spec.conversion = Conversion::Double;
+                    break;
+                case 'p':
+                case 'n':
+                    spec.conversion = Conversion::Pointer;
+                    break;
+                case 'c':
+                case 'C':
+                case 's':
+                case 'S': {
+                    // Same width as the format unless the upper case letter or a length modifier says otherwise
+                    bool wide_arg = wide != (*p == 'C' || *p == 'S');
+                    if (length == 'h') {
+                        wide_arg = false;
+                    }
+                    else if (length == 'l') {
+                        wide_arg = true;
+                    }
+                    if (*p == 'c' || *p == 'C') {
+                        spec.conversion = wide_arg ? Conversion::WideChar : Conversion::Char;
+                    }
+                    else {
+                        spec.conversion = wide_arg ? Conversion::WideString : Conversion::String;
+                    }
+                    break;
+                }
+                default:
+                    spec.conversion = Conversion::Invalid;
+                    spec.end = *p ? p + 1 : p;
+                    break;
+            }
+            return spec.end;
+        }
+        return nullptr;
+    }
+}
@@ -14,7 +14,10 @@
 #include <GWCA/Managers/RenderMgr.h>
 
 #include <Defines.h>
+#include <Utils/AgentSnapshot.h>
+#include <Utils/GenericPacketBus.h>
 #include <Utils/GuiUtils.h>
+#include <Utils/TextureAtlas.h>
 #include <GWToolbox.h>
 #include <Logger.h>
 
@@ -212,6 +215,7 @@ namespace {
             return true;
         }
         GW::Render::SetResetCallback(nullptr);
+        TextureAtlas::Clear();
         ImGui_ImplDX9_Shutdown();
         ImGui_ImplWin32_Shutdown();
         ImGui::DestroyContext();
@@ -773,6 +777,7 @@ void GWToolbox::Update(GW::HookStatus*)
     for (const auto m : all_modules_enabled) {
         m->Update(delta_f);
     }
+    GenericPacketBus::Update();
     last_tick_count = tick;
 }
 
@@ -809,6 +814,8 @@ void GWToolbox::Draw(IDirect3DDevice9* device)
 
     // Draw loop
     Resources::DxUpdate(device);
+    TextureAtlas::NewFrame();
+    AgentSnapshot::NewFrame();
 
     ImGui_ImplDX9_NewFrame();
     ImGui_ImplWin32_NewFrame();
@@ -4,6 +4,7 @@
 #include <ImGuiAddons.h>
 #include <string>
 #include <Keys.h>
+#include <Utils/TextureAtlas.h>
 
 namespace {
     ImGui::ImGuiContextMenuCallback imguiaddons_context_menu_callback = nullptr;
@@ -254,7 +255,8 @@ namespace ImGui {
             if (!icons[i])
                 continue;
             if (uv0.x == uv1.x && uv0.y == uv1.y) {
-                GetWindowDrawList()->AddImage(icons[i], top_left, bottom_right, uv0, CalculateUvCrop(icons[i], img_size));
+                const auto region = TextureAtlas::GetCropped(static_cast<IDirect3DTexture9*>(icons[i]), img_size);
+                GetWindowDrawList()->AddImage(region.texture, top_left, bottom_right, region.uv0, region.uv1);
             }
             else {
                 GetWindowDrawList()->AddImage(icons[i], top_left, bottom_right, uv0, uv1);
@@ -451,7 +453,8 @@ namespace ImGui {
 
     void ImageCropped(const ImTextureID user_texture_id, const ImVec2& size)
     {
-        Image(user_texture_id, size, {0, 0}, CalculateUvCrop(user_texture_id, size));
+        const auto region = TextureAtlas::GetCropped(static_cast<IDirect3DTexture9*>(user_texture_id), size);
+        Image(region.texture, size, region.uv0, region.uv1);
     }
 
     bool IsMouseInRect(const ImVec2& top_left, const ImVec2& bottom_right)
@@ -463,7 +466,8 @@ namespace ImGui {
     void AddImageCropped(const ImTextureID user_texture_id, const ImVec2& top_left, const ImVec2& bottom_right)
     {
         const ImVec2 size = {bottom_right.x - top_left.x, bottom_right.y - top_left.y};
-        GetWindowDrawList()->AddImage(user_texture_id, top_left, bottom_right, {0, 0}, CalculateUvCrop(user_texture_id, size));
+        const auto region = TextureAtlas::GetCropped(static_cast<IDirect3DTexture9*>(user_texture_id), size);
+        GetWindowDrawList()->AddImage(region.texture, top_left, bottom_right, region.uv0, region.uv1);
     }
 
     bool ColorPalette(const char* label, size_t* palette_index, const ImVec4* palette, const size_t count, const size_t max_per_line, const ImGuiColorEditFlags flags)
@@ -1,9 +1,12 @@
 #include "stdafx.h"
 
+#include <atomic>
+
 #include <GWCA/Utilities/Debug.h>
 #include <GWCA/Managers/ChatMgr.h>
 #include <GWCA/Managers/GameThreadMgr.h>
 
+#include <BinaryLog.h>
 #include <Logger.h>
 #include <Utils/GuiUtils.h>
 
@@ -23,6 +26,9 @@ namespace {
     };
 
     [[maybe_unused]] bool crash_dumped = false;
+
+    std::atomic<uint8_t> minimum_level = std::to_underlying(Log::Level::Info);
+    std::atomic<uint32_t> enabled_categories = 0xFFFFFFFF;
 }
 
 static void GWCALogHandler(
@@ -33,7 +39,7 @@ static void GWCALogHandler(
     [[maybe_unused]] const unsigned int line,
     [[maybe_unused]] const char* function)
 {
-    Log::Log("[GWCA] %s", msg);
+    Log::Log(Log::Category::Gwca, Log::Level::Info, "%s", msg);
 }
 
 void Log::FatalAssert(const char* expr, const char* file, const unsigned line)
@@ -62,6 +68,7 @@ BOOL WINAPI ConsoleCtrlHandler(const DWORD dwCtrlType)
 // === Setup and cleanup ====
 bool Log::InitializeLog()
 {
+    Resources::EnsureFolderExists(Resources::GetComputerFolderPath());
 #ifdef _DEBUG
     logfile = stdout;
     AllocConsole();
@@ -70,13 +77,16 @@ bool Log::InitializeLog()
     SetConsoleTitle("GWTB++ Debug Console");
     SetConsoleCtrlHandler(ConsoleCtrlHandler, TRUE);
 #else
-    Resources::EnsureFolderExists(Resources::GetComputerFolderPath());
     logfile = _wfreopen(Resources::GetPath(L"log.txt").c_str(), L"w", stdout);
     if (!logfile) {
         return false;
     }
 #endif
 
+    if (!BinaryLog::Open(Resources::GetPath(L"log.bin"))) {
+        return false;
+    }
+
     RegisterLogHandler(GWCALogHandler, nullptr);
     return true;
 }
@@ -91,6 +101,7 @@ void Log::Terminate()
 {
     GW::RegisterLogHandler(nullptr, nullptr);
     GW::RegisterPanicHandler(nullptr, nullptr);
+    BinaryLog::Close();
 
 #ifdef _DEBUG
     if (stdout_file) {
@@ -111,6 +122,7 @@ void Log::Terminate()
 }
 
 // === File/console logging ===
+#ifdef _DEBUG
 static void PrintTimestamp()
 {
     time_t rawtime{};
@@ -125,36 +137,107 @@ static void PrintTimestamp()
     fprintf(logfile, "[%s] ", buffer);
 }
 
-void Log::Log(const char* msg, ...)
+static void PrintToConsole(const char* msg, va_list args)
 {
-    if (!logfile) {
+    vfprintf(logfile, msg, args);
+    if (msg[0] && msg[strlen(msg) - 1] != '\n') {
+        fprintf(logfile, "\n");
+    }
+}
+
+static void PrintToConsole(const wchar_t* msg, va_list args)
+{
+    vfwprintf(logfile, msg, args);
+    if (msg[0] && msg[wcslen(msg) - 1] != '\n') {
+        fprintf(logfile, "\n");
+    }
+}
+#endif
+
+template <typename Char>
+static void LogV(const Log::Category category, const Log::Level level, const Char* msg, va_list args)
+{
+    if (!Log::IsEnabled(category, level)) {
         return;
     }
-    PrintTimestamp();
+#ifdef _DEBUG
+    if (logfile) {
+        PrintTimestamp();
+        va_list args_copy;
+        va_copy(args_copy, args);
+        PrintToConsole(msg, args_copy);
+        va_end(args_copy);
+    }
+#endif
+    BinaryLog::Write(level, category, msg, args);
+}
 
+void Log::Log(const char* msg, ...)
+{
     va_list args;
     va_start(args, msg);
-    vfprintf(logfile, msg, args);
+    LogV(Category::General, Level::Info, msg, args);
+    va_end(args);
+}
+
+void Log::Log(const Category category, const Level level, const char* msg, ...)
+{
+    va_list args;
+    va_start(args, msg);
+    LogV(category, level, msg, args);
     va_end(args);
-    if (msg[strlen(msg) - 1] != '\n') {
-        fprintf(logfile, "\n");
-    }
 }
 
 void Log::LogW(const wchar_t* msg, ...)
 {
-    if (!logfile) {
-        return;
-    }
-    PrintTimestamp();
+    va_list args;
+    va_start(args, msg);
+    LogV(Category::General, Level::Info, msg, args);
+    va_end(args);
+}
 
+void Log::LogW(const Category category, const Level level, const wchar_t* msg, ...)
+{
     va_list args;
     va_start(args, msg);
-    vfwprintf(logfile, msg, args);
+    LogV(category, level, msg, args);
     va_end(args);
-    if (msg[wcslen(msg) - 1] != '\n') {
-        fprintf(logfile, "\n");
+}
+
+void Log::SetMinimumLevel(const Level level)
+{
+    minimum_level = std::to_underlying(level);
+}
+
+Log::Level Log::GetMinimumLevel()
+{
+    return static_cast<Level>(minimum_level.load());
+}
+
+void Log::SetCategoryEnabled(const Category category, const bool enabled)
+{
+    const uint32_t bit = 1u << std::to_underlying(category);
+    if (enabled) {
+        enabled_categories |= bit;
     }
+    else {
+        enabled_categories &= ~bit;
+    }
+}
+
+bool Log::IsCategoryEnabled(const Category category)
+{
+    return (enabled_categories.load(std::memory_order_relaxed) & (1u << std::to_underlying(category))) != 0;
+}
+
+bool Log::IsEnabled(const Category category, const Level level)
+{
+    return std::to_underlying(level) >= minimum_level.load(std::memory_order_relaxed) && IsCategoryEnabled(category);
+}
+
+void Log::Flush()
+{
+    BinaryLog::Flush();
 }
 
 // === Game chat logging ===
@@ -181,19 +264,17 @@ static void _chatlog(const LogType log_type, const wchar_t* message)
         delete[] to_send;
     });
 
-    const wchar_t* c = [](const LogType log_type) -> const wchar_t* {
+    const auto level = [](const LogType log_type) {
         switch (log_type) {
-            case LogType_Info:
-                return L"Info";
             case LogType_Warning:
-                return L"Warning";
+                return Log::Level::Warning;
             case LogType_Error:
-                return L"Error";
+                return Log::Level::Error;
             default:
-                return L"";
+                return Log::Level::Info;
         }
     }(log_type);
-    Log::LogW(L"[%s] %s\n", c, message);
+    Log::LogW(Log::Category::Chat, level, L"%s\n", message);
 }
 
 static void _vchatlogW(const LogType log_type, const wchar_t* format, const va_list argv)
@@ -3,6 +3,7 @@
 #define ASSERT(expr) ((void)(!!(expr) || (Log::FatalAssert(#expr, __FILE__, (unsigned)__LINE__), 0)))
 #define IM_ASSERT(expr) ASSERT(expr)
 #include <GWCA/Managers/ChatMgr.h>
+#include <BinaryLogFormat.h>
 
 constexpr auto GWTOOLBOX_CHAN = GW::Chat::Channel::CHANNEL_GWCA2;
 constexpr auto GWTOOLBOX_SENDER = L"GWToolbox++";
@@ -12,22 +13,36 @@ constexpr auto GWTOOLBOX_ERROR_COL = 0xFF4444;
 constexpr auto GWTOOLBOX_INFO_COL = 0xFFFFFF;
 
 namespace Log {
+    using Level = BinaryLog::Level;
+    using Category = BinaryLog::Category;
+
     // === Setup and cleanup ====
+    // opens the binary log, log.bin; read it with the LogDecoder tool
     // in release redirects stdout and stderr to log file
-    // in debug creates console
+    // in debug creates console, and echoes log entries to it
     bool InitializeLog();
     void InitializeChat();
     void Terminate();
 
     // === File/console logging ===
-    // printf-style log
+    // printf-style log, at Info level in the General category.
+    // Only the format and arguments are copied; formatting happens when the log is decoded. The format should be a string literal.
     void Log(const char* msg, ...);
+    void Log(Category category, Level level, const char* msg, ...);
 
     // printf-style wide-string log
     void LogW(const wchar_t* msg, ...);
+    void LogW(Category category, Level level, const wchar_t* msg, ...);
+
+    // Entries below the minimum level, or in a disabled category, are skipped before anything is copied
+    void SetMinimumLevel(Level level);
+    [[nodiscard]] Level GetMinimumLevel();
+    void SetCategoryEnabled(Category category, bool enabled);
+    [[nodiscard]] bool IsCategoryEnabled(Category category);
+    [[nodiscard]] bool IsEnabled(Category category, Level level);
 
-    // flushes log file.
-    //static void FlushFile() { fflush(logfile); }
+    // writes out entries still buffered in memory
+    void Flush();
 
     // === Game chat logging ===
     // Shows to the user in the form of a white chat message from toolbox
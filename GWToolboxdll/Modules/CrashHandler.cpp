@@ -75,6 +75,9 @@ int failed(const char* failure_message)
 
 LONG WINAPI CrashHandler::Crash(EXCEPTION_POINTERS* pExceptionPointers)
 {
+    // Entries logged just before the crash are the most useful ones
+    Log::Flush();
+
     const std::wstring crash_folder = Resources::GetPath(L"crashes");
 
     const DWORD ProcessId = GetCurrentProcessId();
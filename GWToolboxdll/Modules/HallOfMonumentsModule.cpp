@@ -1,6 +1,8 @@
 #include "stdafx.h"
 
 #include <Utils/GuiUtils.h>
+#include <Utils/HtmlTokenizer.h>
+#include <Utils/WikiCache.h>
 
 #include <GWCA/Managers/GameThreadMgr.h>
 #include <GWCA/Managers/UIMgr.h>
@@ -11,6 +13,39 @@
 
 
 namespace {
+    constexpr std::string_view hom_cache_name = "hall_of_monuments";
+    // Cached codes younger than this are used without asking the server again
+    constexpr std::chrono::hours hom_cache_fresh(1);
+    // Older ones are only used when the server can't be reached
+    constexpr std::chrono::days hom_cache_max_age(30);
+
+    struct PendingHomRequest {
+        HallOfMonumentsAchievements* out;
+        OnAchievementsLoadedCallback* callback;
+    };
+
+    // Characters being fetched, and everyone waiting on each of them. Requests come from the render and game threads and
+    // finish on workers, so guarded by pending_hom_mutex; callbacks are never run with it held.
+    std::mutex pending_hom_mutex;
+    std::unordered_map<std::string, std::vector<PendingHomRequest>> pending_hom_requests;
+
+    void FinishHomRequest(HallOfMonumentsAchievements* out, OnAchievementsLoadedCallback* callback, const std::string& hom_code);
+
+    void FinishPendingHomRequests(const std::string& character_name, const std::string& hom_code)
+    {
+        decltype(pending_hom_requests)::node_type pending;
+        {
+            std::lock_guard lock(pending_hom_mutex);
+            pending = pending_hom_requests.extract(character_name);
+        }
+        if (pending.empty()) {
+            return;
+        }
+        for (const auto& [out, callback] : pending.mapped()) {
+            FinishHomRequest(out, callback, hom_code);
+        }
+    }
+
     constexpr char _Base64ToValue[128] = {
         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // [0,   16)
         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // [16,  32)
@@ -289,6 +324,25 @@ bool HallOfMonumentsModule::DecodeHomCode(HallOfMonumentsAchievements* out)
     return true;
 }
 
+namespace {
+    void FinishHomRequest(HallOfMonumentsAchievements* out, OnAchievementsLoadedCallback* callback, const std::string& hom_code)
+    {
+        out->state = HallOfMonumentsAchievements::State::Error;
+        if (hom_code.empty()) {
+            Log::Log("Failed to load account hom code %ls", out->character_name.c_str());
+        }
+        else if (hom_code.size() >= _countof(out->hom_code) || !HallOfMonumentsModule::DecodeHomCode(hom_code.c_str(), out)) {
+            Log::Log("Failed to DecodeHomCode from %s", hom_code.c_str());
+        }
+        else {
+            out->state = HallOfMonumentsAchievements::State::Done;
+        }
+        if (callback) {
+            callback(out);
+        }
+    }
+}
+
 void HallOfMonumentsModule::AsyncGetAccountAchievements(const std::wstring& character_name, HallOfMonumentsAchievements* out, OnAchievementsLoadedCallback callback)
 {
     out->state = HallOfMonumentsAchievements::State::Loading;
@@ -303,42 +357,51 @@ void HallOfMonumentsModule::AsyncGetAccountAchievements(const std::wstring& char
     }
     out->character_name = character_name;
 
-    std::string char_name_escaped;
-    EscapeUrl(char_name_escaped, character_name_s.c_str());
-    const auto url_str = std::format("https://hom.guildwars2.com/character/{}", char_name_escaped);
-
-    Resources::Instance().Download(url_str, [out, callback](const bool success, const std::string& response, void*) {
-        if (!success) {
-            Log::Log("Failed to load account hom code %s\n%s", out->character_name.c_str(), response.c_str());
-            out->state = HallOfMonumentsAchievements::State::Error;
-            if (callback) {
-                callback(out);
-            }
+    // The completion window asks for every character at once; only go to the server once per character
+    {
+        std::lock_guard lock(pending_hom_mutex);
+        auto& waiting = pending_hom_requests[character_name_s];
+        waiting.push_back({out, callback});
+        if (waiting.size() > 1) {
             return;
         }
-        static const std::regex json_regex("legacy_bits\":\"([^\"]+)");
-        std::smatch m;
-        if (!std::regex_search(response, m, json_regex)) {
-            Log::Log("Failed to find regex code from %s", response.c_str());
-            out->state = HallOfMonumentsAchievements::State::Error;
-            if (callback) {
-                callback(out);
-            }
+    }
+
+    // The cache may still have to be read from disk, so look it up on a worker rather than the calling thread
+    Resources::EnqueueWorkerTask([character_name_s] {
+        if (nlohmann::json cached; WikiCache::Get(hom_cache_name, character_name_s, cached, hom_cache_fresh) && cached.is_string()) {
+            // Callbacks run on the main thread, same as after a download
+            Resources::EnqueueMainTask([character_name_s, hom_code = cached.get<std::string>()] {
+                FinishPendingHomRequests(character_name_s, hom_code);
+            });
             return;
         }
-        const std::string hom_code = m[1].str();
-        if (!Instance().DecodeHomCode(hom_code.c_str(), out)) {
-            Log::Log("Failed to DecodeHomCode from %s", m[1].str().c_str());
-            out->state = HallOfMonumentsAchievements::State::Error;
-            if (callback) {
-                callback(out);
+
+        std::string char_name_escaped;
+        EscapeUrl(char_name_escaped, character_name_s.c_str());
+        const auto url_str = std::format("https://hom.guildwars2.com/character/{}", char_name_escaped);
+
+        Resources::Instance().Download(url_str, [character_name_s](const bool success, const std::string& response, void*) {
+            std::string hom_code;
+            if (!success) {
+                Log::Log("Failed to load account hom code for %s\n%s", character_name_s.c_str(), response.c_str());
             }
-            return;
-        }
-        out->state = HallOfMonumentsAchievements::State::Done;
-        if (callback) {
-            callback(out);
-        }
+            else {
+                hom_code = Html::FindJsonValue(response, "legacy_bits");
+                if (hom_code.empty()) {
+                    Log::Log("Failed to find legacy_bits from %s", response.c_str());
+                }
+            }
+            nlohmann::json stale;
+            if (!hom_code.empty()) {
+                WikiCache::Set(hom_cache_name, character_name_s, 0, hom_code);
+            }
+            else if (WikiCache::Get(hom_cache_name, character_name_s, stale, hom_cache_max_age) && stale.is_string()) {
+                // Better out of date than nothing
+                hom_code = stale.get<std::string>();
+            }
+            FinishPendingHomRequests(character_name_s, hom_code);
+        });
     });
 }
 
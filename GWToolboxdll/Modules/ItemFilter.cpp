@@ -23,14 +23,10 @@
     }
 
 namespace {
-    struct ItemOwner {
-        GW::ItemID item;
-        GW::AgentID owner;
-    };
-
     using ItemModelID = decltype(GW::Item::model_id);
-    std::vector<GW::Packet::StoC::AgentAdd> suppressed_packets{};
-    std::vector<ItemOwner> item_owners{};
+    // Keyed by agent id; every AgentRemove looks up whether its agent was one we never spawned
+    std::unordered_map<GW::AgentID, GW::Packet::StoC::AgentAdd> suppressed_packets{};
+    std::unordered_map<GW::ItemID, GW::AgentID> item_owners{};
 
     bool hide_player_white = false;
     bool hide_player_blue = false;
@@ -45,6 +41,37 @@ namespace {
     std::map<ItemModelID, std::string> dont_hide_for_player{};
     std::map<ItemModelID, std::string> dont_hide_for_party{};
 
+    // The dont_hide maps above as one bit per model id, checked for every dropped item; call UpdateDontHideLookup() after changing the maps.
+    // Model ids past the end of the bitset (unreasonably large, typed in by hand) fall back to the map.
+    constexpr size_t max_model_id_bits = 0x10000;
+    std::vector<bool> dont_hide_for_player_lookup{};
+    std::vector<bool> dont_hide_for_party_lookup{};
+
+    std::vector<bool> ToModelIdLookup(const std::map<ItemModelID, std::string>& model_ids)
+    {
+        std::vector<bool> lookup(model_ids.empty() ? 0 : std::min<size_t>(model_ids.rbegin()->first + 1, max_model_id_bits), false);
+        for (const auto model_id : model_ids | std::views::keys) {
+            if (model_id < lookup.size()) {
+                lookup[model_id] = true;
+            }
+        }
+        return lookup;
+    }
+
+    void UpdateDontHideLookup()
+    {
+        dont_hide_for_player_lookup = ToModelIdLookup(dont_hide_for_player);
+        dont_hide_for_party_lookup = ToModelIdLookup(dont_hide_for_party);
+    }
+
+    bool ContainsModelId(const std::vector<bool>& lookup, const std::map<ItemModelID, std::string>& model_ids, const ItemModelID model_id)
+    {
+        if (model_id < lookup.size()) {
+            return lookup[model_id];
+        }
+        return lookup.size() == max_model_id_bits && model_ids.contains(model_id);
+    }
+
     void OnAgentAdd(GW::HookStatus*, const GW::Packet::StoC::AgentAdd*);
     void OnAgentRemove(GW::HookStatus*, GW::Packet::StoC::AgentRemove*);
     void OnMapLoad(GW::HookStatus*, GW::Packet::StoC::MapLoaded*);
@@ -204,10 +231,8 @@ namespace {
 
     GW::AgentID GetItemOwner(const GW::ItemID item_id)
     {
-        const auto it = std::ranges::find_if(item_owners, [item_id](auto owner) {
-            return owner.item == item_id;
-        });
-        return it == item_owners.end() ? 0 : it->owner;
+        const auto it = item_owners.find(item_id);
+        return it == item_owners.end() ? 0 : it->second;
     }
 
     bool WantToHide(const GW::Item& item, const bool can_pick_up)
@@ -226,7 +251,7 @@ namespace {
         const auto rarity = GetRarity(item);
 
         if (can_pick_up) {
-            if (dont_hide_for_player.contains(item.model_id)) {
+            if (ContainsModelId(dont_hide_for_player_lookup, dont_hide_for_player, item.model_id)) {
                 return false;
             }
 
@@ -246,7 +271,7 @@ namespace {
             }
         }
 
-        if (dont_hide_for_party.contains(item.model_id)) {
+        if (ContainsModelId(dont_hide_for_party_lookup, dont_hide_for_party, item.model_id)) {
             return false;
         }
 
@@ -283,23 +308,16 @@ namespace {
 
         if (WantToHide(*item, can_pick_up)) {
             status->blocked = true;
-            suppressed_packets.push_back(*packet);
+            suppressed_packets.insert_or_assign(packet->agent_id, *packet);
         }
     }
 
     void OnAgentRemove(GW::HookStatus* status, GW::Packet::StoC::AgentRemove* packet)
     {
         // Block despawning the agent if the client never spawned it.
-        const auto it = std::ranges::find_if(suppressed_packets, [agent_id = packet->agent_id](const auto& suppressed_packet) {
-            return suppressed_packet.agent_id == agent_id;
-        });
-
-        if (it == suppressed_packets.end()) {
-            return;
+        if (suppressed_packets.erase(packet->agent_id)) {
+            status->blocked = true;
         }
-
-        suppressed_packets.erase(it);
-        status->blocked = true;
     }
 
     void OnMapLoad(GW::HookStatus*, GW::Packet::StoC::MapLoaded*)
@@ -310,32 +328,17 @@ namespace {
 
     void OnItemReuseId(GW::HookStatus*, GW::Packet::StoC::ItemGeneral_ReuseID* packet)
     {
-        const auto it = std::ranges::find_if(item_owners, [item_id = packet->item_id](auto owner) {
-            return owner.item == item_id;
-        });
-
-        if (it != item_owners.end()) {
-            item_owners.erase(it);
-        }
+        item_owners.erase(packet->item_id);
     }
 
     void OnItemUpdateOwner(GW::HookStatus*, GW::Packet::StoC::ItemUpdateOwner* packet)
     {
-        const auto it = std::ranges::find_if(item_owners, [item_id = packet->item_id](auto owner) {
-            return owner.item == item_id;
-        });
-
-        if (it == item_owners.end()) {
-            item_owners.push_back({packet->item_id, packet->owner_agent_id});
-        }
-        else {
-            it->owner = packet->owner_agent_id;
-        }
+        item_owners[packet->item_id] = packet->owner_agent_id;
     }
 
     void SpawnSuppressedItems()
     {
-        for (const auto& packet : suppressed_packets) {
+        for (const auto& packet : suppressed_packets | std::views::values) {
             GW::GameThread::Enqueue([cpy = packet]() mutable {
                 // since a user can log out and exit the game with suppressed items still in memory,
                 // only spawn if there is still a valid map context.
@@ -394,6 +397,7 @@ void ItemFilter::LoadSettings(ToolboxIni* ini)
 
     dont_hide_for_player = GuiUtils::IniToMap<decltype(dont_hide_for_player)>(ini, Name(), "dont_hide_for_player", default_dont_hide_for_player);
     dont_hide_for_party = GuiUtils::IniToMap<decltype(dont_hide_for_party)>(ini, Name(), "dont_hide_for_party", default_dont_hide_for_party);
+    UpdateDontHideLookup();
 }
 
 void ItemFilter::SaveSettings(ToolboxIni* ini)
@@ -455,6 +459,7 @@ void ItemFilter::DrawSettingsInternal()
 
         if (ImGui::Button("Restore defaults##player")) {
             dont_hide_for_player = default_dont_hide_for_player;
+            UpdateDontHideLookup();
         }
         ImGui::BeginChild("dont_block_for_player", ImVec2(0.0f, dont_hide_for_player.size() * 26.f));
         for (const auto& [item_id, item_name] : dont_hide_for_player) {
@@ -465,6 +470,7 @@ void ItemFilter::DrawSettingsInternal()
             ImGui::PopID();
             if (clicked) {
                 dont_hide_for_player.erase(item_id);
+                UpdateDontHideLookup();
                 break;
             }
         }
@@ -481,6 +487,7 @@ void ItemFilter::DrawSettingsInternal()
             const auto new_id = static_cast<uint32_t>(new_item_id);
             if (!dont_hide_for_player.contains(new_id)) {
                 dont_hide_for_player[new_id] = std::string(buf);
+                UpdateDontHideLookup();
                 Log::Info("Added Item %s with ID (%d)", buf, new_id);
                 std::ranges::fill(buf, '\0');
                 new_item_id = 0;
@@ -495,6 +502,7 @@ void ItemFilter::DrawSettingsInternal()
         ImGui::PushID("BlockPartyItems");
         if (ImGui::Button("Restore defaults##party")) {
             dont_hide_for_party = default_dont_hide_for_party;
+            UpdateDontHideLookup();
         }
         ImGui::BeginChild("dont_block_for_party", ImVec2(0.0f, dont_hide_for_party.size() * 26.f));
         for (const auto& [item_id, item_name] : dont_hide_for_party) {
@@ -505,6 +513,7 @@ void ItemFilter::DrawSettingsInternal()
             ImGui::PopID();
             if (clicked) {
                 dont_hide_for_party.erase(item_id);
+                UpdateDontHideLookup();
                 break;
             }
         }
@@ -521,6 +530,7 @@ void ItemFilter::DrawSettingsInternal()
             const auto new_id = static_cast<uint32_t>(new_item_id_party);
             if (!dont_hide_for_party.contains(new_id)) {
                 dont_hide_for_party[new_id] = std::string(buf);
+                UpdateDontHideLookup();
                 Log::Info("Added Item %s with ID (%d)", buf, new_id);
                 std::ranges::fill(buf, '\0');
                 new_item_id_party = 0;
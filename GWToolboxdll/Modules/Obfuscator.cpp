@@ -22,6 +22,8 @@
 #include <Modules/ChatSettings.h>
 #include <Modules/Obfuscator.h>
 #include <Utils/GuiUtils.h>
+#include <Utils/StringPool.h>
+#include <Utils/StringReplacer.h>
 #include <Windows/FriendListWindow.h>
 
 #include <Defines.h>
@@ -262,10 +264,29 @@ namespace {
     std::wstring speech_message_temp_message;
 
 
+    // Original and obfuscated names seen since the last Reset(); the maps below hold handles into this pool
+    StringPool obfuscated_names;
     // List of obfuscated names, keyed by obfuscated
-    std::map<std::wstring, std::wstring> obfuscated_by_obfuscation;
+    std::unordered_map<StringPool::Handle, StringPool::Handle> obfuscated_by_obfuscation;
     // List of obfuscated names, keyed by original
-    std::map<std::wstring, std::wstring> obfuscated_by_original;
+    std::unordered_map<StringPool::Handle, StringPool::Handle> obfuscated_by_original;
+    // Automata for ObfuscateMessage(), rebuilt on next use whenever the maps above change
+    StringReplacer obfuscate_replacer;
+    StringReplacer unobfuscate_replacer;
+    bool replacers_dirty = true;
+    // Scratch output for ObfuscateMessage(); the message being rewritten may be one of our own temp buffers
+    std::wstring replace_buffer;
+
+    // Handle mapped to name in the given map, or InvalidHandle. Doesn't allocate.
+    StringPool::Handle FindMapped(const std::unordered_map<StringPool::Handle, StringPool::Handle>& map, const std::wstring_view name)
+    {
+        const auto handle = obfuscated_names.Find(name);
+        if (handle == StringPool::InvalidHandle) {
+            return StringPool::InvalidHandle;
+        }
+        const auto found = map.find(handle);
+        return found == map.end() ? StringPool::InvalidHandle : found->second;
+    }
     // Current position in the list of obfuscated names
     size_t pool_index = 0;
 
@@ -330,13 +351,12 @@ namespace {
 
     bool ObfuscateName(const std::wstring& _original_name, std::wstring& out, const bool in_char_select = false)
     {
-        std::wstring original_name = GuiUtils::SanitizePlayerName(_original_name);
-        if (_original_name.empty()) {
+        const std::wstring original_name = GuiUtils::SanitizePlayerName(_original_name);
+        if (original_name.empty()) {
             return false;
         }
-        const auto found_original = obfuscated_by_original.find(original_name);
-        if (found_original != obfuscated_by_original.end()) {
-            out.assign(found_original->second);
+        if (const auto found_original = FindMapped(obfuscated_by_original, original_name)) {
+            out.assign(obfuscated_names.Get(found_original));
             return true;
         }
 
@@ -344,24 +364,19 @@ namespace {
         if (tmp_out.empty()) {
             return false;
         }
-        if (obfuscated_by_original.contains(original_name)) {
-            out.assign(obfuscated_by_original.at(original_name));
-            return true;
-        }
-        if (obfuscated_by_obfuscation.contains(original_name)) {
-            const auto& obfuscated_orig = obfuscated_by_obfuscation.at(original_name);
+        if (const auto obfuscated_orig = FindMapped(obfuscated_by_obfuscation, original_name)) {
             if (obfuscated_by_original.contains(obfuscated_orig)) {
-                out.assign(obfuscated_orig);
+                out.assign(obfuscated_names.Get(obfuscated_orig));
                 return true;
             }
         }
-        if (!obfuscated_by_original.contains(original_name)) {
-            obfuscated_by_obfuscation.emplace(tmp_out, original_name);
-            obfuscated_by_original.emplace(original_name, tmp_out);
-            out.assign(tmp_out);
-            return true;
-        }
-        return false;
+        const auto original_handle = obfuscated_names.Intern(original_name);
+        const auto obfuscated_handle = obfuscated_names.Intern(tmp_out);
+        obfuscated_by_obfuscation.emplace(obfuscated_handle, original_handle);
+        obfuscated_by_original.emplace(original_handle, obfuscated_handle);
+        replacers_dirty = true;
+        out.assign(tmp_out);
+        return true;
     }
 
     bool UnobfuscateName(const std::wstring_view _obfuscated_name, std::wstring& out)
@@ -370,34 +385,30 @@ namespace {
             return false;
         }
         const auto obfuscated_name = GuiUtils::SanitizePlayerName(std::wstring(_obfuscated_name));
-        const auto found = obfuscated_by_obfuscation.find(obfuscated_name);
-        if (found == obfuscated_by_obfuscation.end()) {
+        const auto found = FindMapped(obfuscated_by_obfuscation, obfuscated_name);
+        if (found == StringPool::InvalidHandle) {
             return false;
         }
-        out.assign(found->second);
+        out.assign(obfuscated_names.Get(found));
         return true;
     }
 
     bool ObfuscateMessage(const std::wstring_view message, std::wstring& out, const bool obfuscate = true)
     {
-        if (!wcschr(message.data(),0x107))
+        if (message.find(0x107) == std::wstring_view::npos) {
             return false; // Message contains no player names
-        std::wstring replacemsg{message};
-        const auto& to_search = obfuscate ? obfuscated_by_original : obfuscated_by_obfuscation;
-        bool was_changed = false;
-        for (const auto& [from, to] : to_search) {
-            if (from.empty()) {
-                break;
-            }
-            size_t start_pos = 0;
-            while ((start_pos = replacemsg.find(from, start_pos)) != std::string::npos) {
-                replacemsg.replace(start_pos, from.length(), to);
-                start_pos += to.length(); // In case 'to' contains 'from', like replacing 'x' with 'yx'
-                was_changed = true;
-            }
         }
-        out.assign(replacemsg);
-        return !out.empty() && was_changed;
+        if (replacers_dirty) {
+            obfuscate_replacer.Build(obfuscated_names, obfuscated_by_original);
+            unobfuscate_replacer.Build(obfuscated_names, obfuscated_by_obfuscation);
+            replacers_dirty = false;
+        }
+        auto& replacer = obfuscate ? obfuscate_replacer : unobfuscate_replacer;
+        if (!replacer.Replace(message, replace_buffer) || replace_buffer.empty()) {
+            return false;
+        }
+        out.assign(replace_buffer);
+        return true;
     }
 
     bool UnobfuscateMessage(const wchar_t* message, std::wstring& out)
@@ -550,6 +561,10 @@ namespace {
         pool_index = 0;
         obfuscated_by_obfuscation.clear();
         obfuscated_by_original.clear();
+        obfuscate_replacer.Clear();
+        unobfuscate_replacer.Clear();
+        replacers_dirty = true;
+        obfuscated_names.Clear();
         // Don't use clear() on this; the game uses the pointer so we don't want to mess with it
         account_info_obfuscated_name[0] = '\0';
         // Don't use clear() on this; the game uses the pointer so we don't want to mess with it
@@ -1029,5 +1044,6 @@ void Obfuscator::DrawSettingsInternal()
 
 bool Obfuscator::IsObfuscatedName(const std::wstring& name)
 {
-    return obfuscated_by_original.contains(name) || obfuscated_by_obfuscation.contains(name);
+    const auto handle = obfuscated_names.Find(name);
+    return handle != StringPool::InvalidHandle && (obfuscated_by_original.contains(handle) || obfuscated_by_obfuscation.contains(handle));
 }
@@ -16,6 +16,7 @@
 #include <GWCA/Managers/UIMgr.h>
 
 #include <GWToolbox.h>
+#include <Utils/GenericPacketBus.h>
 #include <Utils/GuiUtils.h>
 
 #include <Modules/Resources.h>
@@ -161,9 +162,12 @@ void ObserverModule::Initialize()
             HandleAgentProjectileLaunched(packet);
         });
 
-    GW::StoC::RegisterPacketCallback<GW::Packet::StoC::GenericModifier>(
-        &GenericModifier_Entry,
-        [this](const GW::HookStatus*, const GW::Packet::StoC::GenericModifier* packet) -> void {
+    GenericPacketBus::Subscribe(&GenericPacket_Entry, {
+            GenericPacketBus::Header::GenericModifier,
+            GenericPacketBus::Header::GenericValueTarget,
+            GenericPacketBus::Header::GenericValue,
+            GenericPacketBus::Header::GenericFloat
+        }, [this](const GW::HookStatus*, const GenericPacketBus::Event& packet) -> void {
             if (!IsActive()) {
                 return;
             }
@@ -171,69 +175,19 @@ void ObserverModule::Initialize()
                 return;
             }
 
-            const uint32_t value_id = packet->type;
-            const uint32_t caster_id = packet->cause_id;
-            const uint32_t target_id = packet->target_id;
-            const float value = packet->value;
-            constexpr bool no_target = false;
-            HandleGenericPacket(value_id, caster_id, target_id, value, no_target);
-        }
-    );
-
-    GW::StoC::RegisterPacketCallback<GW::Packet::StoC::GenericValueTarget>(
-        &GenericValueTarget_Entry,
-        [this](const GW::HookStatus*, const GW::Packet::StoC::GenericValueTarget* packet) -> void {
-            if (!IsActive()) {
-                return;
-            }
-            if (!InitializeObserverSession()) {
-                return;
-            }
-
-            const uint32_t value_id = packet->Value_id;
-            const uint32_t caster_id = packet->caster;
-            const uint32_t target_id = packet->target;
-            const uint32_t value = packet->value;
-            constexpr bool no_target = false;
-            HandleGenericPacket(value_id, caster_id, target_id, value, no_target);
-        });
-
-    GW::StoC::RegisterPacketCallback<GW::Packet::StoC::GenericValue>(
-        &GenericValue_Entry,
-        [this](const GW::HookStatus*, const GW::Packet::StoC::GenericValue* packet) -> void {
-            if (!IsActive()) {
-                return;
+            const bool no_target = !packet.HasTarget();
+            const uint32_t target_id = no_target ? NO_AGENT : packet.target_id;
+            switch (packet.header) {
+                case GenericPacketBus::Header::GenericModifier:
+                case GenericPacketBus::Header::GenericFloat:
+                    HandleGenericPacket(packet.value_id, packet.caster_id, target_id, packet.float_value, no_target);
+                    break;
+                default:
+                    HandleGenericPacket(packet.value_id, packet.caster_id, target_id, packet.value, no_target);
+                    break;
             }
-            if (!InitializeObserverSession()) {
-                return;
-            }
-
-            const uint32_t value_id = packet->value_id;
-            const uint32_t caster_id = packet->agent_id;
-            constexpr uint32_t target_id = NO_AGENT;
-            const uint32_t value = packet->value;
-            constexpr bool no_target = true;
-            HandleGenericPacket(value_id, caster_id, target_id, value, no_target);
         });
 
-    GW::StoC::RegisterPacketCallback<GW::Packet::StoC::GenericFloat>(
-        &GenericFloat_Entry, [this](const GW::HookStatus*, const GW::Packet::StoC::GenericFloat* packet) -> void {
-            if (!IsActive()) {
-                return;
-            }
-            if (!InitializeObserverSession()) {
-                return;
-            }
-
-            const uint32_t value_id = packet->type;
-            const uint32_t caster_id = packet->agent_id;
-            constexpr uint32_t target_id = NO_AGENT;
-            const float value = packet->value;
-            constexpr bool no_target = true;
-            HandleGenericPacket(value_id, caster_id, target_id, value, no_target);
-        }
-    );
-
     if (IsActive() && !observer_session_initialized) {
         InitializeObserverSession();
     }
@@ -247,7 +201,8 @@ void ObserverModule::Terminate()
     GW::Chat::DeleteCommand(L"observer:reset");
     Reset();
 
-    // TODO: Clear stoc callbacks
+    GenericPacketBus::Unsubscribe(&GenericPacket_Entry);
+    // TODO: Clear the other stoc callbacks
 }
 
 
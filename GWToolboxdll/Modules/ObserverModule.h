@@ -563,8 +563,5 @@ private:
     GW::HookEntry AgentState_Entry;
     GW::HookEntry AgentAdd_Entry;
     GW::HookEntry AgentProjectileLaunched_Entry;
-    GW::HookEntry GenericModifier_Entry;
-    GW::HookEntry GenericValueTarget_Entry;
-    GW::HookEntry GenericValue_Entry;
-    GW::HookEntry GenericFloat_Entry;
+    GW::HookEntry GenericPacket_Entry;
 };
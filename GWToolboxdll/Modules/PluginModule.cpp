@@ -6,6 +6,8 @@
 #include <GWToolbox.h>
 #include <GWCA/Managers/ChatMgr.h>
 
+#include <Defines.h>
+#include <ImGuiAddons.h>
 #include <Modules/Resources.h>
 #include <filesystem>
 #include <string>
@@ -21,10 +23,53 @@ namespace {
 
     std::vector<PluginModule::Plugin*> plugins_loaded;
 
+    // Guards plugins_available against lookups from ToolboxPluginEnqueueTask, which can be called from any thread
+    std::mutex plugins_available_mutex;
+
+    // Time a single plugin callback may take before it is counted (and warned about) as over budget; 0 to disable
+    float plugin_budget_ms = 4.f;
+    bool warn_plugin_over_budget = true;
+    constexpr clock_t budget_warning_interval = 30 * CLOCKS_PER_SEC;
+
+    template <typename Fn>
+    void TimePluginCallback(PluginModule::Plugin* plugin, PluginModule::CallbackTiming& timing, const char* callback_name, Fn&& fn)
+    {
+        const auto started = std::chrono::steady_clock::now();
+        fn();
+        const double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+        timing.Add(elapsed_ms, plugin_budget_ms);
+        if (!warn_plugin_over_budget || plugin_budget_ms <= 0.f || elapsed_ms <= plugin_budget_ms) {
+            return;
+        }
+        const clock_t now = clock();
+        clock_t last_warning = plugin->last_budget_warning;
+        if (last_warning && now - last_warning < budget_warning_interval) {
+            return;
+        }
+        // Whichever thread gets here first in the interval warns
+        if (!plugin->last_budget_warning.compare_exchange_strong(last_warning, now)) {
+            return;
+        }
+        Log::Warning("Plugin %s took %.2f ms in %s (budget %.2f ms)", plugin->path.filename().string().c_str(), elapsed_ms, callback_name, plugin_budget_ms);
+    }
+
+    PluginModule::Plugin* GetPluginByDll(const HMODULE dll)
+    {
+        if (!dll) {
+            return nullptr;
+        }
+        std::lock_guard lock(plugins_available_mutex);
+        const auto found = std::ranges::find_if(plugins_available, [dll](const auto plugin) {
+            return plugin->dll == dll;
+        });
+        return found == plugins_available.end() ? nullptr : *found;
+    }
+
     bool UnloadPlugin(PluginModule::Plugin* plugin_ptr)
     {
         auto& plugin = *plugin_ptr;
         if (!plugin.terminating) {
+            plugin.accepting_tasks = false;
             if (plugin.instance) {
                 plugin.instance->SignalTerminate();
             }
@@ -33,6 +78,9 @@ namespace {
         if (plugin.instance && !plugin.instance->CanTerminate()) {
             return false; // Pending
         }
+        if (plugin.pending_tasks) {
+            return false; // Queued tasks still point into the dll
+        }
 
         if (plugin.instance) {
             plugin.instance->Terminate();
@@ -89,6 +137,9 @@ namespace {
         }
         ImGuiAllocFns fns;
         ImGui::GetAllocatorFunctions(&fns.alloc_func, &fns.free_func, &fns.user_data);
+        plugin.reset_update_timing = true;
+        plugin.draw_timing.Reset();
+        plugin.accepting_tasks = true;
         plugin.instance->Initialize(context, fns, GWToolbox::GetDLLModule());
         plugin.instance->LoadSettings(pluginsfoldername.c_str());
         plugin.initialized = true;
@@ -120,6 +171,7 @@ namespace {
                     return plugin->path == file_path;
                 });
                 if (found == plugins_available.end()) {
+                    std::lock_guard lock(plugins_available_mutex);
                     plugins_available.push_back(new PluginModule::Plugin(file_path));
                 }
             }
@@ -127,6 +179,49 @@ namespace {
     }
 }
 
+// Called by plugins through ToolboxPlugin::EnqueueWorkerTask/EnqueueMainTask, from any thread
+extern "C" __declspec(dllexport) bool __cdecl ToolboxPluginEnqueueTask(const HMODULE plugin_dll, const PluginTaskThread thread, const PluginTaskFn fn, void* context)
+{
+    const auto plugin = fn ? GetPluginByDll(plugin_dll) : nullptr;
+    if (!plugin) {
+        return false;
+    }
+    // Count the task before checking that the plugin accepts them, so UnloadPlugin can't miss it
+    ++plugin->pending_tasks;
+    if (!plugin->accepting_tasks) {
+        --plugin->pending_tasks;
+        return false;
+    }
+    const auto run = [plugin, fn, context] {
+        const auto started = std::chrono::steady_clock::now();
+        fn(context);
+        plugin->task_time_us += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started).count();
+        ++plugin->tasks_completed;
+        --plugin->pending_tasks;
+    };
+    switch (thread) {
+        case PluginTaskThread::Worker:
+            Resources::EnqueueWorkerTask(run);
+            return true;
+        case PluginTaskThread::Main:
+            Resources::EnqueueMainTask(run);
+            return true;
+        default:
+            --plugin->pending_tasks;
+            return false;
+    }
+}
+
+void PluginModule::CallbackTiming::Add(const double ms, const float budget_ms)
+{
+    last_ms = ms;
+    avg_ms = avg_ms == 0.0 ? ms : avg_ms * 0.95 + ms * 0.05;
+    max_ms = std::max(max_ms, ms);
+    if (budget_ms > 0.f && ms > budget_ms) {
+        over_budget++;
+    }
+}
+
 void PluginModule::DrawSettingsInternal()
 {
     ImGui::PushID("Plugins");
@@ -175,6 +270,14 @@ void PluginModule::DrawSettingsInternal()
             }
         }
 
+        if (plugin->initialized) {
+            const auto& update = plugin->update_timing;
+            const auto& draw = plugin->draw_timing;
+            ImGui::TextDisabled("Update %.2f ms (max %.2f)  Draw %.2f ms (max %.2f)  Over budget: %u  Tasks: %llu (%.1f ms)",
+                                update.avg_ms, update.max_ms, draw.avg_ms, draw.max_ms, update.over_budget + draw.over_budget,
+                                plugin->tasks_completed.load(), static_cast<double>(plugin->task_time_us.load()) / 1000.0);
+        }
+
         if (is_showing && InitializePlugin(plugin) && has_settings) {
             plugin->instance->DrawSettings();
         }
@@ -185,6 +288,20 @@ void PluginModule::DrawSettingsInternal()
     if (ImGui::Button("Refresh")) {
         RefreshDlls();
     }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset timings")) {
+        for (const auto plugin : plugins_loaded) {
+            // Update timing belongs to the game thread; it picks this up next frame
+            plugin->reset_update_timing = true;
+            plugin->draw_timing.Reset();
+        }
+    }
+
+    ImGui::PushItemWidth(120.f * ImGui::GetIO().FontGlobalScale);
+    ImGui::DragFloat("Plugin frame budget", &plugin_budget_ms, 0.1f, 0.f, 100.f, "%.1f ms");
+    ImGui::PopItemWidth();
+    ImGui::ShowHelp("Time a plugin's Update or Draw may take per frame before it counts as over budget. 0 to disable.");
+    ImGui::Checkbox("Warn when a plugin goes over budget", &warn_plugin_over_budget);
 
     ImGui::PopID();
 }
@@ -248,13 +365,17 @@ void PluginModule::Draw(IDirect3DDevice9* device)
         }
 
         if (plugin->instance->GetVisiblePtr() && *plugin->instance->GetVisiblePtr()) {
-            plugin->instance->Draw(device);
+            TimePluginCallback(plugin, plugin->draw_timing, "Draw", [plugin, device] {
+                plugin->instance->Draw(device);
+            });
         }
     }
 }
 
 void PluginModule::LoadSettings(ToolboxIni* ini)
 {
+    LOAD_FLOAT(plugin_budget_ms);
+    LOAD_BOOL(warn_plugin_over_budget);
     std::list<CSimpleIniA::Entry> dlls_to_load;
     std::vector<Plugin*> plugins_loaded_from_ini;
     if (ini->GetAllKeys(plugins_enabled_section, dlls_to_load)) {
@@ -285,6 +406,8 @@ void PluginModule::LoadSettings(ToolboxIni* ini)
 
 void PluginModule::SaveSettings(ToolboxIni* ini)
 {
+    SAVE_FLOAT(plugin_budget_ms);
+    SAVE_BOOL(warn_plugin_over_budget);
     ini->Delete(plugins_enabled_section, nullptr);
     for (const auto plugin : plugins_loaded) {
         plugin->instance->SaveSettings(pluginsfoldername.c_str());
@@ -295,7 +418,12 @@ void PluginModule::SaveSettings(ToolboxIni* ini)
 void PluginModule::Update(const float delta)
 {
     for (const auto plugin : plugins_loaded) {
-        plugin->instance->Update(delta);
+        if (plugin->reset_update_timing.exchange(false)) {
+            plugin->update_timing.Reset();
+        }
+        TimePluginCallback(plugin, plugin->update_timing, "Update", [plugin, delta] {
+            plugin->instance->Update(delta);
+        });
         if (plugin->terminating) {
             if (UnloadPlugin(plugin)) {
                 break; // plugins_loaded vector changed, skip a frame
@@ -315,10 +443,12 @@ void PluginModule::SignalTerminate()
 void PluginModule::Terminate()
 {
     ASSERT(plugins_loaded.empty());
+    std::lock_guard lock(plugins_available_mutex);
     for (const auto p : plugins_available) {
         if (p->dll) {
             FreeLibrary(p->dll);
         }
         delete p;
     }
+    plugins_available.clear();
 }
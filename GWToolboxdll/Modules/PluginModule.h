@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 #include <ToolboxUIElement.h>
 #include <../plugins/Base/ToolboxPlugin.h>
 
@@ -8,6 +10,18 @@ class PluginModule final : public ToolboxUIElement {
     ~PluginModule() override = default;
 
 public:
+    // Time spent in one of the plugin's callbacks, measured on the thread that calls it
+    struct CallbackTiming {
+        double last_ms = 0.0;
+        // Exponential moving average
+        double avg_ms = 0.0;
+        double max_ms = 0.0;
+        uint32_t over_budget = 0;
+
+        void Add(double ms, float budget_ms);
+        void Reset() { *this = {}; }
+    };
+
     struct Plugin {
         Plugin(std::filesystem::path _path)
             : path(std::move(_path)) { }
@@ -18,6 +32,19 @@ public:
         bool initialized = false;
         bool terminating = false;
         bool visible = false;
+
+        // Each written only on the thread that makes the calls; update_timing is reset through reset_update_timing from elsewhere
+        CallbackTiming update_timing;
+        CallbackTiming draw_timing;
+        std::atomic_bool reset_update_timing = false;
+        // Either thread can go over budget
+        std::atomic<clock_t> last_budget_warning = 0;
+
+        // Tasks queued through ToolboxPlugin::EnqueueWorkerTask/EnqueueMainTask; the dll can't be freed until these have run
+        std::atomic_bool accepting_tasks = false;
+        std::atomic_uint32_t pending_tasks = 0;
+        std::atomic_uint64_t tasks_completed = 0;
+        std::atomic_uint64_t task_time_us = 0;
     };
 
     static PluginModule& Instance()
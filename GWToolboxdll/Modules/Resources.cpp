@@ -20,7 +20,11 @@
 
 #include <GWCA/Constants/Constants.h>
 #include <Modules/Resources.h>
+#include <Utils/CacheAccounting.h>
 #include <Utils/GuiUtils.h>
+#include <Utils/HtmlTokenizer.h>
+#include <Utils/TextureAtlas.h>
+#include <Utils/WikiCache.h>
 
 #include <include/nfd.h>
 #include <nfd_common.c>
@@ -163,6 +167,658 @@ namespace {
         r->SetMethod(HttpMethod::Get);
         r->SetVerifyHost(false);
     }
+    CacheAccounting::Stats profession_icon_stats("Profession icons");
+    CacheAccounting::Stats damagetype_icon_stats("Damage type icons");
+    CacheAccounting::Stats skill_image_stats("Skill images");
+    CacheAccounting::Stats item_image_stats("Item images");
+    CacheAccounting::Stats wiki_image_stats("Wiki images");
+    CacheAccounting::Stats map_name_stats("Map names");
+    CacheAccounting::Stats enc_string_stats("Decoded strings");
+    const std::array texture_cache_stats = {&profession_icon_stats, &damagetype_icon_stats, &skill_image_stats, &item_image_stats, &wiki_image_stats};
+
+    // Textures handed out by the caches above are released once they haven't been drawn for texture_eviction_minutes.
+    // Callers keep the slot rather than the texture, so an evicted slot is pointed at a blank 1x1 placeholder of its own; seeing
+    // that placeholder drawn (in ImGui's draw data or through TextureAtlas), or the slot being asked for again, reloads the texture
+    // from the file it came from.
+    struct CachedTexture {
+        CacheAccounting::Stats* stats = nullptr;
+        // File the texture was loaded from; empty until it's loaded, or if it can't be reloaded
+        std::filesystem::path path;
+        IDirect3DTexture9* placeholder = nullptr;
+        bool evicted = false;
+        bool reload_queued = false;
+    };
+
+    int texture_eviction_minutes = 10;
+    constexpr auto texture_eviction_interval = std::chrono::seconds(10);
+    constexpr size_t max_texture_reloads_per_frame = 4;
+
+    std::unordered_map<IDirect3DTexture9**, CachedTexture> cached_textures;
+    // Texture or placeholder currently in each tracked slot, to match up with what ImGui drew; slots can share a texture
+    std::unordered_multimap<IDirect3DTexture9*, IDirect3DTexture9**> cached_texture_slots;
+    CacheAccounting::Lru texture_lru;
+    std::queue<IDirect3DTexture9**> texture_reload_queue;
+    CacheAccounting::Clock::time_point next_texture_eviction;
+
+    IDirect3DTexture9** SlotFromKey(const void* key)
+    {
+        return const_cast<IDirect3DTexture9**>(static_cast<IDirect3DTexture9* const*>(key));
+    }
+
+    void UnmapTextureSlot(IDirect3DTexture9* texture, IDirect3DTexture9** slot)
+    {
+        const auto [begin, end] = cached_texture_slots.equal_range(texture);
+        for (auto it = begin; it != end; ++it) {
+            if (it->second == slot) {
+                cached_texture_slots.erase(it);
+                return;
+            }
+        }
+    }
+
+    size_t GetTextureBytes(IDirect3DTexture9* texture)
+    {
+        D3DSURFACE_DESC desc;
+        if (texture->GetLevelDesc(0, &desc) != D3D_OK) {
+            return 0;
+        }
+        uint32_t bits_per_pixel = 32;
+        bool block_compressed = false;
+        switch (desc.Format) {
+            case D3DFMT_DXT1:
+                bits_per_pixel = 4;
+                block_compressed = true;
+                break;
+            case D3DFMT_DXT2:
+            case D3DFMT_DXT3:
+            case D3DFMT_DXT4:
+            case D3DFMT_DXT5:
+                bits_per_pixel = 8;
+                block_compressed = true;
+                break;
+            case D3DFMT_R5G6B5:
+            case D3DFMT_X1R5G5B5:
+            case D3DFMT_A1R5G5B5:
+            case D3DFMT_A4R4G4B4:
+            case D3DFMT_A8L8:
+                bits_per_pixel = 16;
+                break;
+            case D3DFMT_A8:
+            case D3DFMT_L8:
+            case D3DFMT_P8:
+                bits_per_pixel = 8;
+                break;
+            default:
+                break;
+        }
+        return CacheAccounting::TextureBytes(desc.Width, desc.Height, texture->GetLevelCount(), bits_per_pixel, block_compressed);
+    }
+
+    // A cache handed out a new slot
+    void AddCachedTexture(IDirect3DTexture9** slot, CacheAccounting::Stats& stats)
+    {
+        stats.entries++;
+        stats.Lookup(false);
+        cached_textures[slot].stats = &stats;
+    }
+
+    // The texture in slot has been loaded from path; it can be evicted from now on
+    void CachedTextureLoaded(IDirect3DTexture9** slot, const std::filesystem::path& path)
+    {
+        const auto found = cached_textures.find(slot);
+        if (found == cached_textures.end() || !*slot) {
+            return;
+        }
+        found->second.path = path;
+        cached_texture_slots.emplace(*slot, slot);
+        texture_lru.Add(slot, *found->second.stats, GetTextureBytes(*slot), CacheAccounting::Clock::now());
+    }
+
+    void QueueTextureReload(IDirect3DTexture9** slot, CachedTexture& cached)
+    {
+        if (cached.reload_queued || cached.path.empty()) {
+            return;
+        }
+        cached.reload_queued = true;
+        texture_reload_queue.push(slot);
+    }
+
+    // A cache handed out an existing slot again
+    void TouchCachedTexture(IDirect3DTexture9** slot)
+    {
+        const auto found = cached_textures.find(slot);
+        if (found == cached_textures.end()) {
+            return;
+        }
+        auto& cached = found->second;
+        cached.stats->Lookup(true);
+        if (cached.evicted) {
+            QueueTextureReload(slot, cached);
+        }
+        else {
+            texture_lru.Touch(slot, CacheAccounting::Clock::now());
+        }
+    }
+
+    // A drawn texture is in use; a drawn placeholder needs its texture back
+    void TextureDrawn(IDirect3DTexture9* texture, const CacheAccounting::Clock::time_point now)
+    {
+        const auto [begin, end] = cached_texture_slots.equal_range(texture);
+        for (auto it = begin; it != end; ++it) {
+            auto& cached = cached_textures.at(it->second);
+            if (cached.evicted) {
+                QueueTextureReload(it->second, cached);
+            }
+            else {
+                texture_lru.Touch(it->second, now);
+            }
+        }
+    }
+
+    // Icons drawn from a TextureAtlas page only show up in the draw data as the page, so the atlas tells us instead
+    void OnAtlasTextureUsed(IDirect3DTexture9* texture)
+    {
+        if (!cached_texture_slots.empty()) {
+            TextureDrawn(texture, CacheAccounting::Clock::now());
+        }
+    }
+
+    // Textures drawn last frame without going through the atlas
+    void TrackDrawnTextures(const ImDrawData* draw_data)
+    {
+        if (!draw_data || cached_texture_slots.empty()) {
+            return;
+        }
+        const auto now = CacheAccounting::Clock::now();
+        ImTextureID previous = nullptr;
+        for (int n = 0; n < draw_data->CmdListsCount; n++) {
+            for (const auto& cmd : draw_data->CmdLists[n]->CmdBuffer) {
+                // Consecutive commands usually share a texture, most often the font atlas
+                if (cmd.UserCallback || cmd.TextureId == previous) {
+                    continue;
+                }
+                previous = cmd.TextureId;
+                TextureDrawn(static_cast<IDirect3DTexture9*>(cmd.TextureId), now);
+            }
+        }
+    }
+
+    IDirect3DTexture9* CreatePlaceholderTexture(IDirect3DDevice9* device)
+    {
+        IDirect3DTexture9* texture = nullptr;
+        if (device->CreateTexture(1, 1, 1, 0, D3DFMT_A8R8G8B8, D3DPOOL_MANAGED, &texture, nullptr) != D3D_OK) {
+            return nullptr;
+        }
+        D3DLOCKED_RECT rect;
+        if (texture->LockRect(0, &rect, nullptr, 0) == D3D_OK) {
+            *static_cast<uint32_t*>(rect.pBits) = 0;
+            texture->UnlockRect(0);
+        }
+        return texture;
+    }
+
+    void EvictTextures(IDirect3DDevice9* device)
+    {
+        const auto now = CacheAccounting::Clock::now();
+        if (texture_eviction_minutes <= 0 || now < next_texture_eviction) {
+            return;
+        }
+        next_texture_eviction = now + texture_eviction_interval;
+        std::vector<const void*> evicted;
+        texture_lru.Evict(now - std::chrono::minutes(texture_eviction_minutes), evicted, [](const void* key) {
+            IDirect3DTexture9* texture = *SlotFromKey(key);
+            // The atlas keeps its own reference to anything packed; beyond that, only count the memory as released if ours is the last reference
+            TextureAtlas::Forget(texture);
+            texture->AddRef();
+            return texture->Release() == 1;
+        });
+        for (const auto key : evicted) {
+            const auto slot = SlotFromKey(key);
+            auto& cached = cached_textures.at(slot);
+            const auto texture = *slot;
+            UnmapTextureSlot(texture, slot);
+            cached.evicted = true;
+            cached.placeholder = CreatePlaceholderTexture(device);
+            if (cached.placeholder) {
+                cached_texture_slots.emplace(cached.placeholder, slot);
+            }
+            *slot = cached.placeholder;
+            texture->Release();
+        }
+    }
+
+    void ClearCachedTextures()
+    {
+        texture_lru.Clear();
+        cached_textures.clear();
+        cached_texture_slots.clear();
+        texture_reload_queue = {};
+    }
+
+    // Images from the Guild Wars Wiki go through a small pipeline instead of a chain of worker tasks per image:
+    //   resolve: download the wiki page the image is on, and find the image url in it; the url is kept in the wiki cache
+    //   fetch:   download the image to disk if it isn't there already, and read it into memory
+    //   upload:  create the texture from memory on the render thread, a few per frame
+    // Requests for the same page, or that resolve to the same file, share one job. Resolve and fetch each have a cap on jobs in
+    // flight; waiting jobs start most recently requested first, so icons that are being drawn jump ahead of anything prefetched.
+    struct WikiImageJob {
+        // Page to find the image on; empty if the file is already on disk
+        std::string page_url;
+        // Key of the job in wiki_image_pages and of its url in the wiki cache: page_url, plus anything else the image url depends on,
+        // like the width of a thumbnail
+        std::string key;
+        std::string image_url;
+        std::filesystem::path path_to_file;
+        // Absolute url of the image in the page's html, or empty if it isn't there. Called on a worker thread.
+        std::function<std::string(std::string_view html)> find_image_url;
+        // Where to save the image, given its url
+        std::function<std::filesystem::path(const std::string& image_url)> get_path;
+        std::vector<IDirect3DTexture9**> textures;
+        std::vector<Resources::AsyncLoadCallback> callbacks;
+        std::string data;
+        uint64_t last_requested = 0;
+    };
+
+    using WikiImageJobPtr = std::shared_ptr<WikiImageJob>;
+
+    constexpr size_t max_resolving_wiki_images = 2;
+    constexpr size_t max_fetching_wiki_images = 3;
+    constexpr size_t max_wiki_image_uploads_per_frame = 4;
+    // Renamed when thumbnail widths became part of the key; the old cache could hold a thumbnail url for a full size request
+    constexpr std::string_view wiki_image_cache_name = "wiki_image_urls";
+    constexpr auto wiki_image_url_max_age = std::chrono::days(30);
+
+    std::mutex wiki_image_mutex;
+    // Jobs still resolving, by page url
+    std::unordered_map<std::string, WikiImageJobPtr> wiki_image_pages;
+    // Jobs fetching or uploading, by file
+    std::unordered_map<std::wstring, WikiImageJobPtr> wiki_image_files;
+    // Every texture still waiting on a job, to move it up the queue when requested again
+    std::unordered_map<IDirect3DTexture9**, WikiImageJobPtr> wiki_image_textures;
+    std::vector<WikiImageJobPtr> wiki_image_resolve_queue;
+    std::vector<WikiImageJobPtr> wiki_image_fetch_queue;
+    std::queue<WikiImageJobPtr> wiki_image_upload_queue;
+    size_t wiki_images_resolving = 0;
+    size_t wiki_images_fetching = 0;
+    uint64_t wiki_image_request_count = 0;
+
+    WikiImageJobPtr TakeMostRecentlyRequested(std::vector<WikiImageJobPtr>& queue)
+    {
+        const auto found = std::ranges::max_element(queue, {}, [](const WikiImageJobPtr& job) {
+            return job->last_requested;
+        });
+        auto job = std::move(*found);
+        *found = std::move(queue.back());
+        queue.pop_back();
+        return job;
+    }
+
+    void FailWikiImage(const WikiImageJobPtr& job, const std::wstring& error)
+    {
+        // wiki_image_mutex is held
+        for (const auto texture : job->textures) {
+            wiki_image_textures.erase(texture);
+        }
+        Resources::EnqueueMainTask([job, error] {
+            for (const auto& callback : job->callbacks) {
+                callback(false, error);
+            }
+        });
+    }
+
+    void PumpWikiImages();
+
+    void ResolveWikiImage(const WikiImageJobPtr& job)
+    {
+        std::wstring error;
+        if (nlohmann::json cached; WikiCache::Get(wiki_image_cache_name, job->key, cached, wiki_image_url_max_age) && cached.is_string()) {
+            job->image_url = cached.get<std::string>();
+        }
+        else if (std::string response; !Resources::Download(job->page_url, response)) {
+            error = GuiUtils::StringToWString(response);
+        }
+        else {
+            job->image_url = job->find_image_url(response);
+            if (job->image_url.empty()) {
+                StrSwprintf(error, L"Failed to find image on %S", job->page_url.c_str());
+            }
+            else {
+                WikiCache::Set(wiki_image_cache_name, job->key, Html::GetWikiRevision(response), job->image_url);
+            }
+        }
+        if (error.empty()) {
+            job->path_to_file = job->get_path(job->image_url);
+        }
+
+        std::lock_guard lock(wiki_image_mutex);
+        wiki_images_resolving--;
+        wiki_image_pages.erase(job->key);
+        if (!wiki_images_resolving && wiki_image_resolve_queue.empty()) {
+            // Write the urls resolved in this batch once, rather than waiting for the next periodic save
+            WikiCache::RequestSave();
+        }
+        if (!error.empty()) {
+            FailWikiImage(job, error);
+        }
+        else if (const auto found = wiki_image_files.find(job->path_to_file.wstring()); found != wiki_image_files.end()) {
+            // Another request resolved to the same file; wait on that one
+            const auto& other = found->second;
+            for (size_t i = 0; i < job->textures.size(); i++) {
+                other->textures.push_back(job->textures[i]);
+                other->callbacks.push_back(job->callbacks[i]);
+                wiki_image_textures[job->textures[i]] = other;
+            }
+            other->last_requested = std::max(other->last_requested, job->last_requested);
+        }
+        else {
+            wiki_image_files.emplace(job->path_to_file.wstring(), job);
+            wiki_image_fetch_queue.push_back(job);
+        }
+        PumpWikiImages();
+    }
+
+    void FetchWikiImage(const WikiImageJobPtr& job)
+    {
+        std::wstring error;
+        if (std::filesystem::exists(job->path_to_file)) {
+            std::ifstream file(job->path_to_file, std::ios::binary);
+            job->data.assign(std::istreambuf_iterator(file), std::istreambuf_iterator<char>());
+            if (job->data.empty()) {
+                StrSwprintf(error, L"Failed to read %s", job->path_to_file.wstring().c_str());
+            }
+        }
+        else if (!Resources::Download(job->image_url, job->data)) {
+            error = GuiUtils::StringToWString(job->data);
+        }
+        else if (job->data.empty()) {
+            StrSwprintf(error, L"Failed to download %S, no content length", job->image_url.c_str());
+        }
+        else {
+            std::ofstream file(job->path_to_file, std::ios::binary);
+            if (!file.write(job->data.data(), static_cast<std::streamsize>(job->data.size()))) {
+                StrSwprintf(error, L"Failed to write %s", job->path_to_file.wstring().c_str());
+            }
+        }
+
+        std::lock_guard lock(wiki_image_mutex);
+        wiki_images_fetching--;
+        if (!error.empty()) {
+            wiki_image_files.erase(job->path_to_file.wstring());
+            FailWikiImage(job, error);
+        }
+        else {
+            wiki_image_upload_queue.push(job);
+        }
+        PumpWikiImages();
+    }
+
+    void PumpWikiImages()
+    {
+        // wiki_image_mutex is held
+        while (wiki_images_resolving < max_resolving_wiki_images && !wiki_image_resolve_queue.empty()) {
+            wiki_images_resolving++;
+            Resources::EnqueueWorkerTask([job = TakeMostRecentlyRequested(wiki_image_resolve_queue)] {
+                ResolveWikiImage(job);
+            });
+        }
+        while (wiki_images_fetching < max_fetching_wiki_images && !wiki_image_fetch_queue.empty()) {
+            wiki_images_fetching++;
+            Resources::EnqueueWorkerTask([job = TakeMostRecentlyRequested(wiki_image_fetch_queue)] {
+                FetchWikiImage(job);
+            });
+        }
+    }
+
+    // texture is loaded from path_to_file if it exists, otherwise from the image that find_image_url finds on page_url.
+    // Requests with the same key share a job and a cached image url; key defaults to page_url, and must differ whenever
+    // find_image_url would find a different url on the same page.
+    void RequestWikiImage(IDirect3DTexture9** texture, const Resources::AsyncLoadCallback& callback, const std::filesystem::path& path_to_file, const std::string& page_url,
+                          std::function<std::string(std::string_view html)> find_image_url, std::function<std::filesystem::path(const std::string& image_url)> get_path,
+                          std::string key = {})
+    {
+        if (key.empty()) {
+            key = page_url;
+        }
+        std::lock_guard lock(wiki_image_mutex);
+        WikiImageJobPtr job;
+        const bool on_disk = !path_to_file.empty() && std::filesystem::exists(path_to_file);
+        if (on_disk) {
+            if (const auto found = wiki_image_files.find(path_to_file.wstring()); found != wiki_image_files.end()) {
+                job = found->second;
+            }
+        }
+        else if (const auto found = wiki_image_pages.find(key); found != wiki_image_pages.end()) {
+            job = found->second;
+        }
+        if (!job) {
+            job = std::make_shared<WikiImageJob>();
+            if (on_disk) {
+                job->path_to_file = path_to_file;
+                wiki_image_files.emplace(path_to_file.wstring(), job);
+                wiki_image_fetch_queue.push_back(job);
+            }
+            else {
+                job->page_url = page_url;
+                job->key = std::move(key);
+                job->find_image_url = std::move(find_image_url);
+                job->get_path = std::move(get_path);
+                wiki_image_pages.emplace(job->key, job);
+                wiki_image_resolve_queue.push_back(job);
+            }
+        }
+        job->textures.push_back(texture);
+        job->callbacks.push_back(callback);
+        job->last_requested = ++wiki_image_request_count;
+        wiki_image_textures[texture] = job;
+        PumpWikiImages();
+    }
+
+    // Move a texture that's still loading to the front of the queue
+    void BumpWikiImage(IDirect3DTexture9** texture)
+    {
+        if (*texture) {
+            return;
+        }
+        std::lock_guard lock(wiki_image_mutex);
+        if (const auto found = wiki_image_textures.find(texture); found != wiki_image_textures.end()) {
+            found->second->last_requested = ++wiki_image_request_count;
+        }
+    }
+
+    void UploadWikiImages(IDirect3DDevice9* device)
+    {
+        for (size_t i = 0; i < max_wiki_image_uploads_per_frame; i++) {
+            WikiImageJobPtr job;
+            {
+                std::lock_guard lock(wiki_image_mutex);
+                if (wiki_image_upload_queue.empty()) {
+                    return;
+                }
+                job = std::move(wiki_image_upload_queue.front());
+                wiki_image_upload_queue.pop();
+                // Nothing else can join the job from here
+                wiki_image_files.erase(job->path_to_file.wstring());
+                for (const auto texture : job->textures) {
+                    wiki_image_textures.erase(texture);
+                }
+            }
+            // NB: Some Graphics cards seem to spit out D3DERR_NOTAVAILABLE when loading textures; retry, as TryCreateTexture does
+            IDirect3DTexture9* created = nullptr;
+            HRESULT res = D3DERR_NOTAVAILABLE;
+            for (size_t tries = 0; res == D3DERR_NOTAVAILABLE && tries < 5; tries++) {
+                res = DirectX::CreateWICTextureFromMemoryEx(device, reinterpret_cast<const uint8_t*>(job->data.data()), job->data.size(), 0, 0, D3DPOOL_MANAGED,
+                                                            DirectX::WIC_LOADER_DEFAULT, &created);
+            }
+            std::wstring error;
+            if (res != D3D_OK || !created) {
+                std::filesystem::remove(job->path_to_file);
+                StrSwprintf(error, L"Error loading resource from file %s - Error is %S", job->path_to_file.filename().wstring().c_str(), d3dErrorMessage(res));
+            }
+            for (size_t j = 0; j < job->textures.size(); j++) {
+                if (error.empty()) {
+                    if (j) {
+                        created->AddRef();
+                    }
+                    *job->textures[j] = created;
+                    CachedTextureLoaded(job->textures[j], job->path_to_file);
+                }
+                job->callbacks[j](error.empty(), error);
+            }
+        }
+    }
+
+    void ClearWikiImages()
+    {
+        std::lock_guard lock(wiki_image_mutex);
+        wiki_image_pages.clear();
+        wiki_image_files.clear();
+        wiki_image_textures.clear();
+        wiki_image_resolve_queue.clear();
+        wiki_image_fetch_queue.clear();
+        wiki_image_upload_queue = {};
+        wiki_images_resolving = wiki_images_fetching = 0;
+    }
+
+    // Absolute url for a src or href on a wiki page
+    std::string WikiAbsoluteUrl(const std::string_view url)
+    {
+        auto decoded = Html::DecodeEntities(url);
+        if (decoded.starts_with("//")) {
+            return "https:" + decoded;
+        }
+        if (decoded.starts_with("http")) {
+            return decoded;
+        }
+        return "https://wiki.guildwars.com" + decoded;
+    }
+
+    // src of an img cut off after its last .png (or .jpg) extension; empty if it has neither
+    std::string_view GetImageSrc(const std::string_view attributes, const bool allow_jpg)
+    {
+        const auto src = Html::GetAttribute(attributes, "src");
+        auto ext = src.rfind(".png");
+        if (const auto jpg = src.rfind(".jpg"); allow_jpg && jpg != std::string_view::npos && (ext == std::string_view::npos || jpg > ext)) {
+            ext = jpg;
+        }
+        return ext == std::string_view::npos ? std::string_view{} : src.substr(0, ext + 4);
+    }
+
+    // First png or jpg img after the first start tag matching is_marker
+    template <typename Predicate>
+    std::string_view FindImageAfter(const std::string_view html, Predicate&& is_marker)
+    {
+        Html::Tokenizer tokenizer(html);
+        Html::Token token;
+        bool found_marker = false;
+        while (tokenizer.Next(token)) {
+            if (token.type != Html::Token::Type::StartTag) {
+                continue;
+            }
+            if (!found_marker) {
+                found_marker = is_marker(token);
+                continue;
+            }
+            if (Html::EqualsIgnoreCase(token.name, "img")) {
+                if (const auto src = GetImageSrc(token.attributes, true); !src.empty()) {
+                    return src;
+                }
+            }
+        }
+        return {};
+    }
+
+    std::string FindSkillImageUrl(const std::string_view html)
+    {
+        // Skill infobox; or a condition's description, a blessing or a bounty
+        const std::function<bool(const Html::Token&)> markers[] = {
+            [](const Html::Token& token) { return Html::HasClass(token.attributes, "skill-image"); },
+            [](const Html::Token& token) { return Html::EqualsIgnoreCase(token.name, "blockquote"); },
+            [](const Html::Token& token) { return Html::HasClass(token.attributes, "blessing-infobox"); },
+            [](const Html::Token& token) { return Html::HasClass(token.attributes, "bounty-infobox"); }
+        };
+        for (const auto& marker : markers) {
+            if (const auto src = FindImageAfter(html, marker); !src.empty()) {
+                return WikiAbsoluteUrl(src);
+            }
+        }
+        return {};
+    }
+
+    std::string FindItemImageUrl(const std::string_view html, const std::string& item_name)
+    {
+        // First png with alt text containing the item name
+        const auto find_by_alt = [html](const std::string_view name) -> std::string_view {
+            Html::Tokenizer tokenizer(html);
+            Html::Token token;
+            while (tokenizer.Next(token)) {
+                if (token.type != Html::Token::Type::StartTag || !Html::EqualsIgnoreCase(token.name, "img")) {
+                    continue;
+                }
+                if (Html::DecodeEntities(Html::GetAttribute(token.attributes, "alt")).find(name) == std::string::npos) {
+                    continue;
+                }
+                if (const auto src = GetImageSrc(token.attributes, false); !src.empty()) {
+                    return src;
+                }
+            }
+            return {};
+        };
+        auto src = find_by_alt(item_name);
+        if (src.empty()) {
+            // The search may have been redirected to a page with a different name; try its title
+            auto title = Html::ToText(Html::FindElement(html, "title"));
+            const auto suffix = title.find(" - Guild Wars Wiki");
+            if (suffix == std::string::npos) {
+                return {};
+            }
+            title.resize(suffix);
+            src = find_by_alt(title);
+        }
+        return src.empty() ? std::string{} : WikiAbsoluteUrl(src);
+    }
+
+    std::string FindWikiFileUrl(const std::string_view html, const size_t width)
+    {
+        // Link to the full size file, under the preview
+        Html::Tokenizer tokenizer(html);
+        Html::Token token;
+        bool found_marker = false;
+        std::string_view href;
+        while (href.empty() && tokenizer.Next(token)) {
+            if (token.type != Html::Token::Type::StartTag) {
+                continue;
+            }
+            if (!found_marker) {
+                found_marker = Html::HasClass(token.attributes, "fullMedia");
+            }
+            if (found_marker) {
+                href = Html::GetAttribute(token.attributes, "href");
+            }
+        }
+        if (href.empty()) {
+            return {};
+        }
+        auto image_url = WikiAbsoluteUrl(href);
+        if (!width) {
+            return image_url;
+        }
+        // Divert to resized version using mediawiki's method, e.g.
+        // https://wiki.guildwars.com/images/thumb/5/5c/Eternal_Protector_of_Tyria.jpg/150px-Eternal_Protector_of_Tyria.jpg
+        const auto images = image_url.find("/images/");
+        const auto last_slash = image_url.rfind('/');
+        if (images == std::string::npos || last_slash <= images + 8) {
+            return {};
+        }
+        const auto folder = std::string_view(image_url).substr(images + 8, last_slash - images - 8);
+        const auto file = std::string_view(image_url).substr(last_slash + 1);
+        return std::format("https://wiki.guildwars.com/images/thumb/{}/{}/{}px-{}", folder, file, width, file);
+    }
+
+    // .png or .jpg, from the end of an image url
+    std::wstring GetImageExtension(const std::string& image_url)
+    {
+        return image_url.ends_with(".jpg") ? L".jpg" : L".png";
+    }
 } // namespace
 
 Resources::Resources()
@@ -358,6 +1014,7 @@ void Resources::Initialize()
         }));
     }
     RegisterUIMessageCallback(&OnUIMessage_Hook, GW::UI::UIMessage::kEnumPreference, OnUIMessage, 0x8000);
+    TextureAtlas::SetUseCallback(OnAtlasTextureUsed);
 }
 
 void Resources::Cleanup()
@@ -372,6 +1029,10 @@ void Resources::Cleanup()
         delete worker;
     }
     workers.clear();
+    // Workers are gone, so nothing else is writing the wiki caches now
+    WikiCache::Save();
+    ClearWikiImages();
+    ClearCachedTextures();
     for (const auto& tex : skill_images | std::views::values) {
         delete tex;
     }
@@ -384,6 +1045,7 @@ void Resources::Cleanup()
         delete img;
     }
     guild_wars_wiki_images.clear();
+    skill_image_stats.entries = item_image_stats.entries = wiki_image_stats.entries = 0;
     for (const auto& enc_strings : encoded_string_ids | std::views::values) {
         for (const auto& enc_string : enc_strings | std::views::values) {
             delete enc_string;
@@ -391,6 +1053,7 @@ void Resources::Cleanup()
     }
     encoded_string_ids.clear();
     map_names.clear(); // NB: Map names are pointers to encoded_string_ids
+    enc_string_stats.entries = map_name_stats.entries = 0;
 }
 
 void Resources::Terminate()
@@ -398,10 +1061,85 @@ void Resources::Terminate()
     ToolboxModule::Terminate();
 
     GW::UI::RemoveUIMessageCallback(&OnUIMessage_Hook);
+    TextureAtlas::SetUseCallback(nullptr);
 
     Cleanup();
 }
 
+void Resources::LoadSettings(ToolboxIni* ini)
+{
+    ToolboxModule::LoadSettings(ini);
+    texture_eviction_minutes = static_cast<int>(ini->GetLongValue(Name(), VAR_NAME(texture_eviction_minutes), texture_eviction_minutes));
+}
+
+void Resources::SaveSettings(ToolboxIni* ini)
+{
+    ToolboxModule::SaveSettings(ini);
+    SAVE_UINT(texture_eviction_minutes);
+}
+
+void Resources::DrawSettingsInternal()
+{
+    ImGui::SliderInt("Release images not drawn for (minutes)", &texture_eviction_minutes, 0, 60);
+    ImGui::ShowHelp("Icons and images downloaded from the Guild Wars Wiki are released from memory once they haven't been shown for this long,\n"
+        "and loaded again from disk the next time they're needed. 0 keeps them for the whole session.");
+
+    // Decoded strings aren't tracked individually; add them up while the panel is open
+    enc_string_stats.resident = enc_string_stats.bytes = 0;
+    for (const auto& enc_strings : encoded_string_ids | std::views::values) {
+        for (const auto enc_string : enc_strings | std::views::values) {
+            enc_string_stats.resident++;
+            enc_string_stats.bytes += enc_string->BytesUsed();
+        }
+    }
+
+    ImGui::Text("Cache usage:");
+    constexpr auto flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp;
+    if (!ImGui::BeginTable("resources_cache_stats", 7, flags)) {
+        return;
+    }
+    ImGui::TableSetupColumn("Cache", ImGuiTableColumnFlags_WidthStretch, 2.f);
+    ImGui::TableSetupColumn("Entries");
+    ImGui::TableSetupColumn("Loaded");
+    ImGui::TableSetupColumn("Memory");
+    ImGui::TableSetupColumn("Hit rate");
+    ImGui::TableSetupColumn("Released");
+    ImGui::TableSetupColumn("Reloaded");
+    ImGui::TableHeadersRow();
+    const auto draw_row = [](const CacheAccounting::Stats& stats) {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(stats.name);
+        ImGui::TableNextColumn();
+        ImGui::Text("%zu", stats.entries);
+        ImGui::TableNextColumn();
+        ImGui::Text("%zu", stats.resident);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.1f KB", static_cast<double>(stats.bytes) / 1024.0);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.1f%%", stats.HitRate() * 100.f);
+        ImGui::TableNextColumn();
+        ImGui::Text("%llu", stats.evictions);
+        ImGui::TableNextColumn();
+        ImGui::Text("%llu", stats.reloads);
+    };
+    for (const auto stats : texture_cache_stats) {
+        draw_row(*stats);
+    }
+    draw_row(map_name_stats);
+    draw_row(enc_string_stats);
+    ImGui::EndTable();
+    if (ImGui::Button("Reset counters")) {
+        for (const auto stats : texture_cache_stats) {
+            stats->ResetCounters();
+        }
+        map_name_stats.ResetCounters();
+        enc_string_stats.ResetCounters();
+    }
+    ImGui::ShowHelp("Memory is an estimate: texture sizes include mip levels, strings include their text and bookkeeping.\n"
+        "Map names point at decoded strings, so take no memory of their own.");
+}
+
 void Resources::EndLoading() const
 {
     EnqueueWorkerTask([this] {
@@ -513,7 +1251,7 @@ void Resources::Download(const std::filesystem::path& path_to_file, const std::s
             });
         }
         else if (!success) {
-            Log::LogW(L"Failed to download %s from %S\n%S", path_to_file.wstring().c_str(), url.c_str(), error_message.c_str());
+            Log::LogW(Log::Category::Resources, Log::Level::Warning, L"Failed to download %s from %S\n%S", path_to_file.wstring().c_str(), url.c_str(), error_message.c_str());
         }
     });
 }
@@ -526,7 +1264,9 @@ bool Resources::Download(const std::string& url, std::string& response)
 
 bool Resources::Download(const std::string& url, std::string& response, int& statusCode)
 {
-    RestClient r;
+    // One client per worker thread; Reset() keeps curl's connection cache, so repeated requests to a host reuse the connection
+    thread_local RestClient r;
+    r.Reset();
     InitRestClient(&r);
     r.SetUrl(url.c_str());
     r.Execute();
@@ -744,7 +1484,7 @@ void Resources::LoadTexture(IDirect3DTexture9** texture, const std::filesystem::
             callback(success, error);
         }
         else if (!success) {
-            Log::LogW(L"Failed to load texture from file %s\n%s", path_to_file.wstring().c_str(), error.c_str());
+            Log::LogW(Log::Category::Resources, Log::Level::Warning, L"Failed to load texture from file %s\n%s", path_to_file.wstring().c_str(), error.c_str());
         }
     });
 }
@@ -758,7 +1498,7 @@ void Resources::LoadTexture(IDirect3DTexture9** texture, WORD id, AsyncLoadCallb
             callback(success, error);
         }
         else if (!success) {
-            Log::LogW(L"Failed to load texture from id %d\n%s", id, error.c_str());
+            Log::LogW(Log::Category::Resources, Log::Level::Warning, L"Failed to load texture from id %d\n%s", id, error.c_str());
         }
     });
 }
@@ -774,7 +1514,7 @@ void Resources::LoadTexture(IDirect3DTexture9** texture, const std::filesystem::
                 callback(success, error);
             }
             else {
-                Log::LogW(L"Failed to EnsureFileExists %s\n%S", path_to_file.wstring().c_str(), error.c_str());
+                Log::LogW(Log::Category::Resources, Log::Level::Warning, L"Failed to EnsureFileExists %s\n%S", path_to_file.wstring().c_str(), error.c_str());
             }
         }
     });
@@ -852,8 +1592,48 @@ int Resources::SaveIniToFile(const std::filesystem::path& absolute_path, const T
     return 0;
 }
 
+void Resources::ReloadTextures(IDirect3DDevice9* device)
+{
+    for (size_t i = 0; i < max_texture_reloads_per_frame && !texture_reload_queue.empty(); i++) {
+        const auto slot = texture_reload_queue.front();
+        texture_reload_queue.pop();
+        auto& cached = cached_textures.at(slot);
+        cached.reload_queued = false;
+        if (!cached.evicted) {
+            continue;
+        }
+        IDirect3DTexture9* texture = nullptr;
+        std::wstring error;
+        if (TryCreateTexture(device, cached.path, &texture, error) != D3D_OK) {
+            // Leave the slot empty rather than trying again every time the placeholder is drawn
+            Log::LogW(Log::Category::Resources, Log::Level::Warning, L"Failed to reload texture %s\n%s", cached.path.wstring().c_str(), error.c_str());
+            cached.path.clear();
+            texture = nullptr;
+        }
+        if (cached.placeholder) {
+            UnmapTextureSlot(cached.placeholder, slot);
+            TextureAtlas::Forget(cached.placeholder);
+            cached.placeholder->Release();
+            cached.placeholder = nullptr;
+        }
+        *slot = texture;
+        if (!texture) {
+            continue;
+        }
+        cached.evicted = false;
+        cached.stats->reloads++;
+        cached_texture_slots.emplace(texture, slot);
+        texture_lru.Add(slot, *cached.stats, GetTextureBytes(texture), CacheAccounting::Clock::now());
+    }
+}
+
 void Resources::DxUpdate(IDirect3DDevice9* device)
 {
+    // ImGui's draw data is still last frame's until the next ImGui::Render()
+    TrackDrawnTextures(ImGui::GetDrawData());
+    EvictTextures(device);
+    ReloadTextures(device);
+    UploadWikiImages(device);
     while (true) {
         dx_mutex.lock();
         if (dx_jobs.empty()) {
@@ -869,6 +1649,7 @@ void Resources::DxUpdate(IDirect3DDevice9* device)
 
 void Resources::Update(float)
 {
+    WikiCache::Update();
     main_mutex.lock();
     if (main_jobs.empty()) {
         main_mutex.unlock();
@@ -883,12 +1664,14 @@ void Resources::Update(float)
 IDirect3DTexture9** Resources::GetProfessionIcon(GW::Constants::Profession p)
 {
     const auto prof_id = std::to_underlying(p);
-    if (profession_icons.contains(prof_id)) {
-        return profession_icons.at(prof_id);
+    if (const auto found = profession_icons.find(prof_id); found != profession_icons.end()) {
+        TouchCachedTexture(found->second);
+        return found->second;
     }
     const auto texture = new IDirect3DTexture9*;
     *texture = nullptr;
     profession_icons[prof_id] = texture;
+    AddCachedTexture(texture, profession_icon_stats);
     if (profession_icon_urls[prof_id][0]) {
         const auto path = GetPath(PROF_ICONS_PATH);
         EnsureFolderExists(path);
@@ -896,8 +1679,11 @@ IDirect3DTexture9** Resources::GetProfessionIcon(GW::Constants::Profession p)
         swprintf(local_image, _countof(local_image), L"%s\\%d.png", path.c_str(), p);
         char remote_image[128];
         snprintf(remote_image, _countof(remote_image), "https://wiki.guildwars.com/images/%s.png", profession_icon_urls[prof_id]);
-        LoadTexture(texture, local_image, remote_image, [prof_id](const bool success, const std::wstring& error) {
-            if (!success) {
+        LoadTexture(texture, local_image, remote_image, [texture, prof_id, local_image = std::filesystem::path(local_image)](const bool success, const std::wstring& error) {
+            if (success) {
+                CachedTextureLoaded(texture, local_image);
+            }
+            else {
                 Log::ErrorW(L"Failed to load icon for profession %d\n%s", prof_id, error.c_str());
             }
         });
@@ -907,19 +1693,24 @@ IDirect3DTexture9** Resources::GetProfessionIcon(GW::Constants::Profession p)
 
 IDirect3DTexture9** Resources::GetDamagetypeImage(std::string dmg_type)
 {
-    if (damagetype_icons.contains(dmg_type)) {
-        return damagetype_icons.at(dmg_type);
+    if (const auto found = damagetype_icons.find(dmg_type); found != damagetype_icons.end()) {
+        TouchCachedTexture(found->second);
+        return found->second;
     }
     const auto texture = new IDirect3DTexture9*;
     *texture = nullptr;
     damagetype_icons[dmg_type] = texture;
+    AddCachedTexture(texture, damagetype_icon_stats);
     if (damagetype_icon_urls.contains(dmg_type)) {
         const auto path = GetPath(DMGTYPE_ICONS_PATH);
         EnsureFolderExists(path);
         const auto local_path = path / GuiUtils::SanitiseFilename(dmg_type + ".png");
         const auto remote_path = std::format("https://wiki.guildwars.com/images/thumb/{}", damagetype_icon_urls.at(dmg_type));
-        LoadTexture(texture, local_path, remote_path, [dmg_type](const bool success, const std::wstring& error) {
-            if (!success) {
+        LoadTexture(texture, local_path, remote_path, [texture, dmg_type, local_path](const bool success, const std::wstring& error) {
+            if (success) {
+                CachedTextureLoaded(texture, local_path);
+            }
+            else {
                 const auto dmg_type_wstr = GuiUtils::StringToWString(dmg_type);
                 Log::ErrorW(L"Failed to load icon for %d\n%s", dmg_type_wstr.c_str(), error.c_str());
             }
@@ -939,66 +1730,38 @@ IDirect3DTexture9** Resources::GetGuildWarsWikiImage(const char* filename, size_
         filename_on_disk = filename;
     }
     const auto filename_sanitised = GuiUtils::SanitiseFilename(filename_on_disk);
-    if (guild_wars_wiki_images.contains(filename_sanitised)) {
-        return guild_wars_wiki_images.at(filename_sanitised);
+    if (const auto found = guild_wars_wiki_images.find(filename_sanitised); found != guild_wars_wiki_images.end()) {
+        BumpWikiImage(found->second);
+        TouchCachedTexture(found->second);
+        return found->second;
     }
     const auto callback = [filename_sanitised](const bool success, const std::wstring& error) {
         if (!success) {
             Log::ErrorW(L"Failed to load Guild Wars Wiki file%S\n%s", filename_sanitised.c_str(), error.c_str());
         }
         else {
-            Log::LogW(L"Loaded Guild Wars Wiki file %S", filename_sanitised.c_str());
+            Log::LogW(Log::Category::Resources, Log::Level::Debug, L"Loaded Guild Wars Wiki file %S", filename_sanitised.c_str());
         }
     };
     const auto texture = new IDirect3DTexture9*;
     *texture = nullptr;
-    guild_wars_wiki_images[filename] = texture;
+    guild_wars_wiki_images[filename_sanitised] = texture;
+    AddCachedTexture(texture, wiki_image_stats);
     static std::filesystem::path path = GetPath(GUILD_WARS_WIKI_FILES_PATH);
     if (!EnsureFolderExists(path)) {
         trigger_failure_callback(callback, L"Failed to create folder %s", path.wstring().c_str());
         return texture;
     }
-    const auto path_to_file = std::format("{}\\{}",path.string(), filename_sanitised);
-    // Check for local file
-    if (std::filesystem::exists(path_to_file)) {
-        LoadTexture(texture, path_to_file, callback);
-        return texture;
-    }
-    // No local file found; download from wiki via skill link URL
+    const auto path_to_file = path / filename_sanitised;
     std::string wiki_url = "https://wiki.guildwars.com/wiki/File:";
     wiki_url.append(GuiUtils::UrlEncode(filename, '_'));
-    Instance().Download(wiki_url, [texture, filename_sanitised, callback, width](const bool ok, const std::string& response, void*) {
-        if (!ok) {
-            callback(ok, GuiUtils::StringToWString(response));
-            return; // Already logged whatever errors
-        }
-
-        // Find a valid png or jpg image inside the HTML response, <img alt="<skill_id>" src="<location_of_image>"
-        std::regex image_finder(R"(class="fullMedia"[\s\S]*?href=['"]([^"']+))");
-        std::smatch m;
-        std::regex_search(response, m, image_finder);
-        if (!m.size()) {
-            trigger_failure_callback(callback, L"Regex failed loading file %S", filename_sanitised.c_str());
-            return;
-        }
-        std::string image_url = m[1].str();
-        const auto path_to_file2 = std::format("{}\\{}", path.string(), filename_sanitised);
-        if (width) {
-            // Divert to resized version using mediawiki's method
-            image_finder = "/images/(.*)/([^/]+)$";
-            std::regex_search(image_url, m, image_finder);
-            if (!m.size()) {
-                trigger_failure_callback(callback, L"Regex failed evaluating GWW thumbnail from %S", image_url.c_str());
-                return;
-            }
-            image_url = std::format("/images/thumb/{}/{}/{}px-{}", m[1].str(), m[2].str(), width, m[2].str());
-        }
-        // https://wiki.guildwars.com/images/thumb/5/5c/Eternal_Protector_of_Tyria.jpg/150px-Eternal_Protector_of_Tyria.jpg
-        if (!image_url.starts_with("http")) {
-            image_url = std::format("https://wiki.guildwars.com{}", image_url);
-        }
-        LoadTexture(texture, path_to_file2, image_url, callback);
-    });
+    // The same page gives a different url for each thumbnail width
+    auto key = width ? std::format("{} {}px", wiki_url, width) : wiki_url;
+    RequestWikiImage(texture, callback, path_to_file, wiki_url, [width](const std::string_view html) {
+        return FindWikiFileUrl(html, width);
+    }, [path_to_file](const std::string&) {
+        return path_to_file;
+    }, std::move(key));
     return texture;
 }
 
@@ -1011,20 +1774,23 @@ IDirect3DTexture9** Resources::GetSkillImage(GW::Constants::SkillID skill_id)
 
 IDirect3DTexture9** Resources::GetSkillImageFromGWW(GW::Constants::SkillID skill_id)
 {
-    if (skill_images.contains(skill_id)) {
-        return skill_images.at(skill_id);
+    if (const auto found = skill_images.find(skill_id); found != skill_images.end()) {
+        BumpWikiImage(found->second);
+        TouchCachedTexture(found->second);
+        return found->second;
     }
     const auto callback = [skill_id](const bool success, const std::wstring& error) {
         if (!success) {
             Log::ErrorW(L"Failed to load skill image %d\n%s", skill_id, error.c_str());
         }
         else {
-            Log::LogW(L"Loaded skill image %d", skill_id);
+            Log::LogW(Log::Category::Resources, Log::Level::Debug, L"Loaded skill image %d", skill_id);
         }
     };
     const auto texture = new IDirect3DTexture9*;
     *texture = nullptr;
     skill_images[skill_id] = texture;
+    AddCachedTexture(texture, skill_image_stats);
     if (skill_id == static_cast<GW::Constants::SkillID>(0)) {
         return texture;
     }
@@ -1033,81 +1799,27 @@ IDirect3DTexture9** Resources::GetSkillImageFromGWW(GW::Constants::SkillID skill
         trigger_failure_callback(callback, L"Failed to create folder %s", path.wstring().c_str());
         return texture;
     }
-    wchar_t path_to_file[MAX_PATH];
-    // Check for local jpg file
-    swprintf(path_to_file, _countof(path_to_file), L"%s\\%d.jpg", path.wstring().c_str(), skill_id);
-    if (std::filesystem::exists(path_to_file)) {
-        LoadTexture(texture, path_to_file, callback);
-        return texture;
+    // Either a jpg or a png may have been saved before
+    auto path_to_file = path / std::format(L"{}.jpg", std::to_underlying(skill_id));
+    if (!std::filesystem::exists(path_to_file)) {
+        path_to_file.replace_extension(L".png");
     }
-    // Check for local png file
-    swprintf(path_to_file, _countof(path_to_file), L"%s\\%d.png", path.wstring().c_str(), skill_id);
-    if (std::filesystem::exists(path_to_file)) {
-        LoadTexture(texture, path_to_file, callback);
-        return texture;
-    }
-    // No local file found; download from wiki via skill link URL
-    char url[128];
-    snprintf(url, _countof(url), "https://wiki.guildwars.com/wiki/Game_link:Skill_%d", skill_id);
-    Instance().Download(url, [texture, skill_id, callback](const bool ok, const std::string& response, void*) {
-        if (!ok) {
-            callback(ok, GuiUtils::StringToWString(response));
-            return; // Already logged whatever errors
-        }
-
-        char regex_str[255];
-        // Find a valid png or jpg image inside the HTML response, <img alt="<skill_id>" src="<location_of_image>"
-        ASSERT(snprintf(regex_str, sizeof(regex_str), "class=\"skill-image\"[\\s\\S]*?<img[^>]+src=['\"]([^\"']+)([.](png|jpg))") != -1);
-        std::regex image_finder(regex_str);
-        std::smatch m;
-        std::regex_search(response, m, image_finder);
-        if (!m.size()) {
-            // Search condition e..g Crippled
-            ASSERT(snprintf(regex_str, sizeof(regex_str), "<blockquote[\\s\\S]*?<img[^>]+src=['\"]([^\"']+)([.](png|jpg))") != -1);
-            image_finder = regex_str;
-            std::regex_search(response, m, image_finder);
-        }
-        if (!m.size()) {
-            // Search blessing
-            ASSERT(snprintf(regex_str, sizeof(regex_str), "class=\"blessing-infobox\"[\\s\\S]*?<img[^>]+src=['\"]([^\"']+)([.](png|jpg))") != -1);
-            image_finder = regex_str;
-            std::regex_search(response, m, image_finder);
-        }
-        if (!m.size()) {
-            // Search bounty
-            ASSERT(snprintf(regex_str, sizeof(regex_str), "class=\"bounty-infobox\"[\\s\\S]*?<img[^>]+src=['\"]([^\"']+)([.](png|jpg))") != -1);
-            image_finder = regex_str;
-            std::regex_search(response, m, image_finder);
-        }
-        if (!m.size()) {
-            trigger_failure_callback(callback, L"Regex failed loading skill id %d", skill_id);
-            return;
-        }
-        const std::string& image_path = m[1].str();
-        const std::string& image_extension = m[2].str();
-        wchar_t path_to_file[MAX_PATH];
-        ASSERT(swprintf(path_to_file, _countof(path_to_file), L"%s\\%d%S", path.c_str(), skill_id, image_extension.c_str()) != -1);
-        char url[128];
-
-        if (strncmp(image_path.c_str(), "http", 4) == 0) {
-            // Image URL is absolute
-            snprintf(url, _countof(url), "%s%s", image_path.c_str(), image_extension.c_str());
-        }
-        else {
-            // Image URL is relative to domain
-            snprintf(url, _countof(url), "https://wiki.guildwars.com%s%s", image_path.c_str(), image_extension.c_str());
-        }
-        LoadTexture(texture, path_to_file, url, callback);
-    });
+    // Otherwise download from wiki via skill link URL
+    RequestWikiImage(texture, callback, path_to_file, std::format("https://wiki.guildwars.com/wiki/Game_link:Skill_{}", std::to_underlying(skill_id)), FindSkillImageUrl,
+                     [skill_id](const std::string& image_url) {
+                         return path / std::format(L"{}{}", std::to_underlying(skill_id), GetImageExtension(image_url));
+                     });
     return texture;
 }
 
 GuiUtils::EncString* Resources::GetMapName(const GW::Constants::MapID map_id)
 {
     const auto found = map_names.find(map_id);
+    map_name_stats.Lookup(found != map_names.end());
     if (found != map_names.end()) {
         return found->second;
     }
+    map_name_stats.entries++;
     if (map_id == GW::Constants::MapID::None) {
         map_names[map_id] = DecodeStringId(0x3);
         return map_names[map_id];
@@ -1185,9 +1897,13 @@ GuiUtils::EncString* Resources::DecodeStringId(const uint32_t enc_str_id, GW::Co
     const auto by_language = encoded_string_ids.find(language);
     if (by_language != encoded_string_ids.end()) {
         const auto found = by_language->second.find(enc_str_id);
-        if (found != by_language->second.end())
+        if (found != by_language->second.end()) {
+            enc_string_stats.Lookup(true);
             return found->second;
+        }
     }
+    enc_string_stats.Lookup(false);
+    enc_string_stats.entries++;
     const auto enc_string = new GuiUtils::EncString(enc_str_id, false);
     encoded_string_ids[language][enc_str_id] = enc_string;
     return enc_string;
@@ -1221,74 +1937,31 @@ IDirect3DTexture9** Resources::GetItemImage(const std::wstring& item_name)
     if (item_name.empty()) {
         return nullptr;
     }
-    if (item_images.contains(item_name)) {
-        return item_images.at(item_name);
+    if (const auto found = item_images.find(item_name); found != item_images.end()) {
+        BumpWikiImage(found->second);
+        TouchCachedTexture(found->second);
+        return found->second;
     }
     const auto callback = [item_name](const bool success, const std::wstring& error) {
         if (!success) {
             Log::ErrorW(L"Failed to load item image %s\n%s", item_name.c_str(), error.c_str());
         }
         else {
-            Log::LogW(L"Loaded item image %s", item_name.c_str());
+            Log::LogW(Log::Category::Resources, Log::Level::Debug, L"Loaded item image %s", item_name.c_str());
         }
     };
     const auto texture = new IDirect3DTexture9*;
     *texture = nullptr;
     item_images[item_name] = texture;
+    AddCachedTexture(texture, item_image_stats);
     static std::filesystem::path path = GetPath(ITEM_IMAGES_PATH);
     ASSERT(EnsureFolderExists(path));
 
-    wchar_t path_to_file[MAX_PATH];
-    // Check for local png image
-    swprintf(path_to_file, _countof(path_to_file), L"%s\\%s.png", path.c_str(), item_name.c_str());
-    if (std::filesystem::exists(path_to_file)) {
-        LoadTexture(texture, path_to_file, callback);
-        return texture;
-    }
-
-    // No local file found; download from wiki via searching by the item name; the wiki will usually return a 302 redirect if its an exact item match
-    const std::string search_str = GuiUtils::WikiUrl(item_name);
-    Instance().Download(search_str, [texture, item_name, callback](const bool ok, const std::string& response, void*) {
-        if (!ok) {
-            callback(ok, GuiUtils::StringToWString(response));
-            return;
-        }
-        const std::string item_name_str = GuiUtils::WStringToString(item_name);
-        // matches any characters that need to be escaped in RegEx
-        static const std::regex specialChars{R"([-[\]{}()*+?.,\^$|#\s])"};
-        const std::string sanitized = std::regex_replace(item_name_str, specialChars, R"(\$&)");
-        std::smatch m;
-        // Find first png image that has an alt tag matching the html encoded title of the page
-        char regex_str[255];
-        snprintf(regex_str, sizeof(regex_str), R"(<img[^>]+alt=['"][^>]*%s[^>]*['"][^>]+src=['"]([^"']+)([.](png)))", sanitized.c_str());
-        if (!std::regex_search(response, m, std::regex(regex_str))) {
-            // Failed to find via item name; try via page title
-            const std::regex title_finder("<title>(.*) - Guild Wars Wiki.*</title>");
-            if (!std::regex_search(response, m, title_finder)) {
-                trigger_failure_callback(callback, L"Failed to find title HTML for %s from wiki", item_name.c_str());
-                return;
-            }
-            const std::string html_item_name = GuiUtils::HtmlEncode(m[1].str());
-            snprintf(regex_str, sizeof(regex_str), R"(<img[^>]+alt=['"][^>]*%s[^>]*['"][^>]+src=['"]([^"']+)([.](png)))", html_item_name.c_str());
-            if (!std::regex_search(response, m, std::regex(regex_str))) {
-                trigger_failure_callback(callback, L"Failed to find image HTML for %s from wiki", item_name.c_str());
-                return;
-            }
-        }
-        const std::string& image_path = m[1].str();
-        const std::string& image_extension = m[2].str();
-        wchar_t path_to_file[MAX_PATH];
-        swprintf(path_to_file, _countof(path_to_file), L"%s\\%s%S", path.c_str(), item_name.c_str(), image_extension.c_str());
-        char url[128];
-        if (strncmp(image_path.c_str(), "http", 4) == 0) {
-            // Image URL is absolute
-            snprintf(url, _countof(url), "%s%s", image_path.c_str(), image_extension.c_str());
-        }
-        else {
-            // Image URL is relative to domain
-            snprintf(url, _countof(url), "https://wiki.guildwars.com%s%s", image_path.c_str(), image_extension.c_str());
-        }
-        LoadTexture(texture, path_to_file, url, callback);
+    // Download from wiki via searching by the item name if there's no local file; the wiki will usually return a 302 redirect if its an exact item match
+    RequestWikiImage(texture, callback, path / std::format(L"{}.png", item_name), GuiUtils::WikiUrl(item_name), [item_name_str = GuiUtils::WStringToString(item_name)](const std::string_view html) {
+        return FindItemImageUrl(html, item_name_str);
+    }, [item_name](const std::string& image_url) {
+        return path / std::format(L"{}{}", item_name, GetImageExtension(image_url));
     });
     return texture;
 }
@@ -31,10 +31,13 @@ public:
     }
 
     [[nodiscard]] const char* Name() const override { return "Resources"; }
-    bool HasSettings() override { return false; }
 
     void Initialize() override;
     void Terminate() override;
+    void LoadSettings(ToolboxIni* ini) override;
+    void SaveSettings(ToolboxIni* ini) override;
+    // Memory used and hit rates of the texture and string caches
+    void DrawSettingsInternal() override;
 
     void Update(float delta) override;
     static void DxUpdate(IDirect3DDevice9* device);
@@ -85,6 +88,10 @@ public:
     // Load from file to D3DTexture, fallback to remote location, runs callback on completion
     static void LoadTexture(IDirect3DTexture9** texture, const std::filesystem::path& path_to_file, const std::string& url, AsyncLoadCallback callback = nullptr);
 
+    // Icons and wiki images below (but not textures from the gw dat) that haven't been drawn for a while are swapped for a blank
+    // placeholder to free memory; drawing the placeholder, or asking for the texture again, reloads it.
+    // Hold on to the pointer, not the texture it points to.
+
     // Guaranteed to return a pointer, but reference will be null until the texture has been loaded
     static IDirect3DTexture9** GetProfessionIcon(GW::Constants::Profession p);
     // Guaranteed to return a pointer, but reference will be null until the texture has been loaded
@@ -93,17 +100,17 @@ public:
     static IDirect3DTexture9** GetSkillImage(GW::Constants::SkillID skill_id);
     // Fetches skill page from GWW, parses out the image for the skill then downloads that to disk
     // Not elegant, but without a proper API to provide images, and to avoid including libxml, this is the next best thing.
-    // Guaranteed to return a pointer, but reference will be null until the texture has been loaded
+    // Guaranteed to return a pointer, but reference will be null until the texture has been loaded; asking again meanwhile moves it up the queue
     static IDirect3DTexture9** GetSkillImageFromGWW(GW::Constants::SkillID skill_id);
 
     static IDirect3DTexture9** GetItemImage(GW::Item* item);
     // Fetches item page from GWW, parses out the image for the item then downloads that to disk
     // Not elegant, but without a proper API to provide images, and to avoid including libxml, this is the next best thing.
-    // Guaranteed to return a pointer, but reference will be null until the texture has been loaded
+    // Guaranteed to return a pointer, but reference will be null until the texture has been loaded; asking again meanwhile moves it up the queue
     static IDirect3DTexture9** GetItemImage(const std::wstring& item_name);
     // Fetches File page from GWW, parses out the image for the file given
     // Not elegant, but without a proper API to provide images, and to avoid including libxml, this is the next best thing.
-    // Guaranteed to return a pointer, but reference will be null until the texture has been loaded
+    // Guaranteed to return a pointer, but reference will be null until the texture has been loaded; asking again meanwhile moves it up the queue
     static IDirect3DTexture9** GetGuildWarsWikiImage(const char* filename, size_t width = 0);
 
     // Guaranteed to return a pointer, but may not yet be decoded.
@@ -139,6 +146,8 @@ public:
 
 private:
     static void Cleanup();
+    // Bring back evicted textures that have been asked for, a few per frame
+    static void ReloadTextures(IDirect3DDevice9* device);
     // Assign IDirect3DTexture9* from file
     static HRESULT TryCreateTexture(IDirect3DDevice9* device, const std::filesystem::path& path_to_file, IDirect3DTexture9** texture, std::wstring& error);
     // Assign IDirect3DTexture9* from resource
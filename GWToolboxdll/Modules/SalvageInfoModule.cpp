@@ -4,7 +4,6 @@
 #include <Logger.h>
 #include <base64.h>
 #include <ctime>
-#include <regex>
 
 #include <GWCA/GameEntities/Item.h>
 #include <GWCA/GameEntities/Agent.h>
@@ -32,6 +31,8 @@
 #include <Windows/DailyQuestsWindow.h>
 
 #include <Utils/GuiUtils.h>
+#include <Utils/HtmlTokenizer.h>
+#include <Utils/WikiCache.h>
 #include <Timer.h>
 #include <Constants/EncStrings.h>
 
@@ -39,6 +40,7 @@ using nlohmann::json;
 namespace {
     // If requesting info from gww for an item fails, how long should we wait before retrying?
     constexpr clock_t salvage_info_retry_interval = CLOCKS_PER_SEC * 30;
+    constexpr std::string_view wiki_cache_name = "salvage_info";
 
     struct CraftingMaterial {
         uint32_t model_id; // Used to map to kamadan trade chat
@@ -81,6 +83,8 @@ namespace {
         std::vector<std::string> searched_urls; // Used to detect cycles
         DailyQuests::NicholasCycleData* nicholas_info = nullptr;
         clock_t last_retry = salvage_info_retry_interval * -1;
+        // Revision of the item's wiki page the materials were parsed from
+        uint32_t wiki_revision = 0;
         bool loading = false;
         bool success = false;
 
@@ -92,28 +96,6 @@ namespace {
 
     std::unordered_map<std::wstring, SalvageInfo*> salvage_info_by_single_item_name;
 
-    const char* ws = " \t\n\r\f\v";
-
-    // trim from end of string (right)
-    inline std::string& rtrim(std::string& s, const char* t = ws)
-    {
-        s.erase(s.find_last_not_of(t) + 1);
-        return s;
-    }
-
-    // trim from beginning of string (left)
-    inline std::string& ltrim(std::string& s, const char* t = ws)
-    {
-        s.erase(0, s.find_first_not_of(t));
-        return s;
-    }
-
-    // trim from both ends of string (right then left)
-    inline std::string& trim(std::string& s, const char* t = ws)
-    {
-        return ltrim(rtrim(s, t), t);
-    }
-
     //Converts signed char to unsigned char arrays
     inline std::vector<unsigned char> convert_to_unsigned(const std::vector<char>& input)
     {
@@ -153,27 +135,6 @@ namespace {
         return s;
     }
 
-    // Make sure you pass valid html e.g. start with a < tag
-    std::string& strip_tags(std::string& html) {
-        while (1)
-        {
-            auto startpos = html.find("<");
-            if (startpos == std::string::npos)
-                break;
-            auto endpos = html.find(">", startpos) + 1;
-            if (endpos == std::string::npos)
-                break;
-            html.erase(startpos, endpos - startpos);
-        }
-
-        return html;
-    }
-    std::string& from_html(std::string& html) {
-        strip_tags(html);
-        trim(html);
-        return html;
-    }
-
     void SignalItemDescriptionUpdated(const wchar_t* enc_name) {
         // Now we've got the wiki info parsed, trigger an item update ui message; this will refresh the item tooltip
         GW::GameThread::Enqueue([enc_name] {
@@ -187,6 +148,50 @@ namespace {
             });
     }
 
+    // Add the material with this (lower case) wiki name to vec, if we know of it and it isn't there yet
+    void AddMaterial(const std::wstring& material_name, std::vector<CraftingMaterial*>& vec)
+    {
+        const auto found = std::ranges::find_if(materials, [&material_name](auto* c) {
+            return c->en_name == material_name || c->en_name_plural == material_name;
+            });
+        if (found != materials.end() && !std::ranges::contains(vec, *found)) {
+            vec.push_back(*found);
+        }
+    }
+
+    void SaveToWikiCache(const SalvageInfo* info)
+    {
+        const auto to_names = [](const std::vector<CraftingMaterial*>& vec) {
+            auto names = json::array();
+            for (const auto material : vec) {
+                names.push_back(GuiUtils::WStringToString(material->en_name));
+            }
+            return names;
+        };
+        const json result = {{"common", to_names(info->common_crafting_materials)}, {"rare", to_names(info->rare_crafting_materials)}};
+        WikiCache::Set(wiki_cache_name, info->en_name.string(), info->wiki_revision, result);
+    }
+
+    bool LoadFromWikiCache(SalvageInfo* info, const json& result)
+    {
+        if (std::ranges::any_of(materials, [](const CraftingMaterial* c) { return c->decoding_en_name || c->decoding_en_name_plural; })) {
+            return false; // Can't map names to materials yet
+        }
+        const auto from_names = [](const json& names, std::vector<CraftingMaterial*>& vec) {
+            if (!names.is_array()) {
+                return;
+            }
+            for (const auto& name : names) {
+                if (name.is_string()) {
+                    AddMaterial(GuiUtils::StringToWString(name.get<std::string>()), vec);
+                }
+            }
+        };
+        from_names(result.value("common", json::array()), info->common_crafting_materials);
+        from_names(result.value("rare", json::array()), info->rare_crafting_materials);
+        return true;
+    }
+
     void OnWikiContentDownloaded(bool success, const std::string& response, void* wparam) {
         auto* info = (SalvageInfo*)wparam;
         if (!success) {
@@ -196,49 +201,56 @@ namespace {
             return;
         }
 
-        const auto parse_materials = [](const std::string& cell_content, std::vector<CraftingMaterial*>& vec) {
-                const std::regex link_regex("<a[^>]+title=\"([^\"]+)");
-                auto links_begin = std::sregex_iterator(cell_content.begin(), cell_content.end(), link_regex);
-                auto links_end = std::sregex_iterator();
-                for (std::sregex_iterator j = links_begin; j != links_end; ++j)
-                {
-                    const auto material_name = GuiUtils::ToLower(GuiUtils::StringToWString(j->str(1)));
-
-                    const auto found = std::ranges::find_if(materials, [material_name](auto* c) {
-                        return c->en_name == material_name || c->en_name_plural == material_name;
-                        });
-                    if (found != materials.end()) {
-                        // Add the material to the list only if the material doesn't already exist
-                        const auto in_list = std::find_if(vec.begin(), vec.end(), [material_name](auto* c) {
-                            return c->en_name == material_name || c->en_name_plural == material_name;
-                        });
-                        if (in_list == vec.end()) {
-                            vec.push_back(*found);
-                        }
-                    }
-                }
-            };
+        if (info->searched_urls.size() == 1) {
+            // Item's own page; if the cached result came from this revision, there's nothing to parse
+            info->wiki_revision = Html::GetWikiRevision(response);
+            json cached;
+            if (WikiCache::GetForRevision(wiki_cache_name, info->en_name.string(), info->wiki_revision, cached) && LoadFromWikiCache(info, cached)) {
+                info->success = true;
+                info->loading = false;
+                SignalItemDescriptionUpdated(info->en_name.encoded().c_str());
+                return;
+            }
+        }
 
-        const std::regex infobox_regex("<table[^>]+>([\\s\\S]*)</table>");
-        std::smatch m;
-        if (std::regex_search(response, m, infobox_regex)) {
-            std::string infobox_content = m[1].str();
+        const auto parse_materials = [](const std::string_view cell_content, std::vector<CraftingMaterial*>& vec) {
+            Html::ForEachLink(cell_content, [&vec](const std::string_view title, std::string_view) {
+                AddMaterial(GuiUtils::ToLower(GuiUtils::StringToWString(std::string(title))), vec);
+            });
+        };
 
-            const auto sub_links_regex = std::regex(R"delim(<a href="\/wiki[\s\S]*?title="([\s\S]*?)">)delim");
-            const auto disambig_regex = std::regex("This disambiguation page");
-            if (std::regex_search(infobox_content, m, disambig_regex)) {
+        // Everything from the first table with attributes to the last end of table in the page
+        const std::string_view page = response;
+        size_t infobox_start = std::string_view::npos;
+        Html::Tokenizer tokenizer(page);
+        Html::Token token;
+        while (tokenizer.Next(token)) {
+            if (token.type == Html::Token::Type::StartTag && token.name == "table" && !token.attributes.empty()) {
+                infobox_start = token.end;
+                break;
+            }
+        }
+        const auto infobox_end = page.rfind("</table>");
+        if (infobox_start != std::string_view::npos && infobox_end != std::string_view::npos && infobox_end >= infobox_start) {
+            const auto infobox_content = page.substr(infobox_start, infobox_end - infobox_start);
+
+            // Titles of links to other wiki articles in the page
+            const auto for_each_sub_link = [page](auto&& fn) {
+                Html::ForEachLink(page, [&fn](const std::string_view title, const std::string_view href) {
+                    if (href.starts_with("/wiki")) {
+                        fn(std::string(title));
+                    }
+                });
+            };
+            if (infobox_content.contains("This disambiguation page")) {
                 // Detected a disambiguation page. We need to search for materials in the hrefs listed on this page
                 std::unordered_set<std::string> sub_urls;
-                std::string::const_iterator sub_search_start(response.cbegin());
-                while (std::regex_search(sub_search_start, response.cend(), m, sub_links_regex)) {
-                    const auto entry = m[1].str();
+                for_each_sub_link([&](const std::string& entry) {
                     // Search for entries that contain the name of the item, skipping the SpecialWhatLinksHere entry
                     if (entry.contains(info->en_name.string()) && !entry.contains("Special:WhatLinksHere")) {
                         sub_urls.emplace(entry);
                     }
-
-                    sub_search_start = m.suffix().first; // Update the start position
-                }
+                });
 
                 // Fetch materials of the sub urls and add them to the salvage info struct
                 if (sub_urls.size() > 0) {
@@ -261,21 +273,17 @@ namespace {
                 }
             }
 
-            const auto different_article_page_regex = std::regex(R"(This article is about [\s\S]*?For the weapon[\s\S]*?)");
-            if (std::regex_search(response, m, different_article_page_regex)) {
+            const auto article_about = page.find("This article is about");
+            if (article_about != std::string_view::npos && page.find("For the weapon", article_about) != std::string_view::npos) {
                 // Detected weapon type page. We need to go to the weapon with same name page and fetch materials from there
                 const auto expected_token = std::format("{} (weapon)", info->en_name.string());
                 std::unordered_set<std::string> sub_urls;
-                auto sub_search_start(response.cbegin());
-                while (std::regex_search(sub_search_start, response.cend(), m, sub_links_regex)) {
-                    const auto entry = m[1].str();
+                for_each_sub_link([&](const std::string& entry) {
                     // Search for entries that match [WeaponName] (weapon) token
                     if (entry == expected_token) {
                         sub_urls.emplace(entry);
                     }
-
-                    sub_search_start = m.suffix().first; // Update the start position
-                }
+                });
 
                 // Fetch materials of the sub urls and add them to the salvage info struct
                 if (sub_urls.size() > 0) {
@@ -298,25 +306,17 @@ namespace {
                 }
             }
 
-            // Iterate over all skills in this list.
-            static const std::regex infobox_row_regex(
-                "(?:<tr>|<tr[^>]+>)[\\s\\S]*?(?:<th>|<th[^>]+>)([\\s\\S]*?)</th>[\\s\\S]*?(?:<td>|<td[^>]+>)([\\s\\S]*?)</td>[\\s\\S]*?</tr>"
-            );
-            auto words_begin = std::sregex_iterator(infobox_content.begin(), infobox_content.end(), infobox_row_regex);
-            auto words_end = std::sregex_iterator();
-            for (std::sregex_iterator i = words_begin; i != words_end; ++i)
-            {
-                auto key = i->str(1);
-                from_html(key);
-                const auto val = i->str(2);
+            Html::ForEachInfoboxRow(infobox_content, [&](const std::string_view th, const std::string_view td) {
+                const auto key = Html::ToText(th);
                 if (key == "Common salvage") {
-                    parse_materials(val, info->common_crafting_materials);
+                    parse_materials(td, info->common_crafting_materials);
                 }
                 if (key == "Rare salvage") {
-                    parse_materials(val, info->rare_crafting_materials);
+                    parse_materials(td, info->rare_crafting_materials);
                 }
-            }
+            });
         }
+        SaveToWikiCache(info);
         info->success = true;
         info->loading = false;
         SignalItemDescriptionUpdated(info->en_name.encoded().c_str());
@@ -329,6 +329,13 @@ namespace {
             // @Cleanup: this should never hang, but should we handle it?
             Sleep(16);
         }
+        json cached;
+        if (WikiCache::Get(wiki_cache_name, info->en_name.string(), cached, std::chrono::days(30)) && LoadFromWikiCache(info, cached)) {
+            info->success = true;
+            info->loading = false;
+            SignalItemDescriptionUpdated(info->en_name.encoded().c_str());
+            return;
+        }
         const auto url = GuiUtils::WikiUrl(info->en_name.string());
         info->searched_urls.push_back(url);
         Resources::Download(url, OnWikiContentDownloaded, info, std::chrono::days(1));
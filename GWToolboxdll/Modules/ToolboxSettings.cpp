@@ -195,6 +195,12 @@ namespace {
     };
 
     bool modules_sorted = false;
+
+    // ini key for whether log entries in this category are written
+    std::string LogCategoryKey(const Log::Category category)
+    {
+        return std::format("log_category_{}", BinaryLog::category_names[std::to_underlying(category)]);
+    }
 }
 
 void ToolboxSettings::LoadModules(ToolboxIni* ini)
@@ -244,6 +250,21 @@ void ToolboxSettings::DrawSettingsInternal()
 
     ImGui::Checkbox("Save Location Data", &save_location_data);
     ImGui::ShowHelp("Toolbox will save your location every second in a file in Settings Folder.");
+
+    auto log_level = static_cast<int>(std::to_underlying(Log::GetMinimumLevel()));
+    if (ImGui::Combo("Log level", &log_level, BinaryLog::level_names, static_cast<int>(Log::Level::Count))) {
+        Log::SetMinimumLevel(static_cast<Log::Level>(log_level));
+    }
+    ImGui::ShowHelp("Entries below this level aren't written to log.bin in the Toolbox folder.");
+    ImGui::Text("Log categories:");
+    for (uint8_t i = 0; i < std::to_underlying(Log::Category::Count); i++) {
+        const auto category = static_cast<Log::Category>(i);
+        bool enabled = Log::IsCategoryEnabled(category);
+        ImGui::SameLine();
+        if (ImGui::Checkbox(BinaryLog::category_names[i], &enabled)) {
+            Log::SetCategoryEnabled(category, enabled);
+        }
+    }
     const auto cols = static_cast<size_t>(floor(ImGui::GetWindowWidth() / (170.0f * ImGui::GetIO().FontGlobalScale)));
 
     ImGui::Separator();
@@ -345,6 +366,13 @@ void ToolboxSettings::LoadSettings(ToolboxIni* ini)
     move_all = false;
     LOAD_BOOL(clamp_windows_to_screen);
 
+    const auto log_level = ini->GetLongValue(Name(), "log_level", std::to_underlying(Log::GetMinimumLevel()));
+    Log::SetMinimumLevel(static_cast<Log::Level>(std::clamp(log_level, 0l, static_cast<long>(Log::Level::Count) - 1)));
+    for (uint8_t i = 0; i < std::to_underlying(Log::Category::Count); i++) {
+        const auto category = static_cast<Log::Category>(i);
+        Log::SetCategoryEnabled(category, ini->GetBoolValue(Name(), LogCategoryKey(category).c_str(), Log::IsCategoryEnabled(category)));
+    }
+
     for (auto& m : optional_modules) {
         m.enabled = ini->GetBoolValue(modules_ini_section, m.name, m.enabled);
     }
@@ -365,6 +393,12 @@ void ToolboxSettings::SaveSettings(ToolboxIni* ini)
 
     SAVE_BOOL(clamp_windows_to_screen);
 
+    ini->SetLongValue(Name(), "log_level", std::to_underlying(Log::GetMinimumLevel()));
+    for (uint8_t i = 0; i < std::to_underlying(Log::Category::Count); i++) {
+        const auto category = static_cast<Log::Category>(i);
+        ini->SetBoolValue(Name(), LogCategoryKey(category).c_str(), Log::IsCategoryEnabled(category));
+    }
+
     for (const auto& m : optional_modules) {
         ini->SetBoolValue(modules_ini_section, m.name, m.enabled);
     }
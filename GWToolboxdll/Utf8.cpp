@@ -2,35 +2,277 @@
 
 #include <Utf8.h>
 
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define UTF8_SSE2 1
+#endif
+
+static_assert(sizeof(wchar_t) == 2, "utf8 transcoding assumes utf16 wchar_t");
+
+namespace {
+    constexpr uint32_t replacement_char = 0xFFFD;
+
+    bool IsHighSurrogate(const uint32_t c) { return c >= 0xD800 && c <= 0xDBFF; }
+    bool IsLowSurrogate(const uint32_t c) { return c >= 0xDC00 && c <= 0xDFFF; }
+    bool IsContinuation(const uint8_t c) { return (c & 0xC0) == 0x80; }
+
+    // Writes the code point to out[o]; false if it doesn't fit
+    bool EncodeUtf8(const uint32_t cp, char* out, const size_t out_len, size_t& o)
+    {
+        if (cp < 0x80) {
+            if (o + 1 > out_len) {
+                return false;
+            }
+            out[o++] = static_cast<char>(cp);
+        }
+        else if (cp < 0x800) {
+            if (o + 2 > out_len) {
+                return false;
+            }
+            out[o++] = static_cast<char>(0xC0 | (cp >> 6));
+            out[o++] = static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        else if (cp < 0x10000) {
+            if (o + 3 > out_len) {
+                return false;
+            }
+            out[o++] = static_cast<char>(0xE0 | (cp >> 12));
+            out[o++] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out[o++] = static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        else {
+            if (o + 4 > out_len) {
+                return false;
+            }
+            out[o++] = static_cast<char>(0xF0 | (cp >> 18));
+            out[o++] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            out[o++] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out[o++] = static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        return true;
+    }
+
+    // Decodes the sequence at in[i], advancing i past it. Returns npos for a malformed sequence, after skipping one byte.
+    uint32_t DecodeUtf8(const uint8_t* in, const size_t len, size_t& i)
+    {
+        constexpr auto invalid = static_cast<uint32_t>(utf8::npos);
+        const uint8_t c = in[i++];
+        if (c < 0x80) {
+            return c;
+        }
+        size_t extra;
+        uint32_t cp;
+        uint32_t min;
+        if ((c & 0xE0) == 0xC0) {
+            extra = 1;
+            cp = c & 0x1F;
+            min = 0x80;
+        }
+        else if ((c & 0xF0) == 0xE0) {
+            extra = 2;
+            cp = c & 0x0F;
+            min = 0x800;
+        }
+        else if ((c & 0xF8) == 0xF0) {
+            extra = 3;
+            cp = c & 0x07;
+            min = 0x10000;
+        }
+        else {
+            return invalid;
+        }
+        if (i + extra > len) {
+            return invalid;
+        }
+        for (size_t j = 0; j < extra; j++) {
+            if (!IsContinuation(in[i + j])) {
+                return invalid;
+            }
+            cp = (cp << 6) | (in[i + j] & 0x3F);
+        }
+        // Overlong encodings, surrogates and anything past the last plane aren't valid utf8
+        if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+            return invalid;
+        }
+        i += extra;
+        return cp;
+    }
+
+    template <typename Char>
+    void ToLowerAsciiScalar(Char* str, const size_t len)
+    {
+        for (size_t i = 0; i < len; i++) {
+            if (str[i] >= 'A' && str[i] <= 'Z') {
+                str[i] = static_cast<Char>(str[i] + ('a' - 'A'));
+            }
+        }
+    }
+}
+
+namespace utf8 {
+    size_t FromWide(const std::wstring_view in, char* out, const size_t out_len, const Mode mode)
+    {
+        const wchar_t* src = in.data();
+        const size_t len = in.size();
+        size_t i = 0;
+        size_t o = 0;
+        while (i < len) {
+#ifdef UTF8_SSE2
+            // 16 ascii characters at a time; the high byte of each is zero and so is bit 7 of the low byte
+            const __m128i non_ascii_mask = _mm_set1_epi16(static_cast<short>(0xFF80));
+            const __m128i zero = _mm_setzero_si128();
+            while (i + 16 <= len && o + 16 <= out_len) {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+                const __m128i non_ascii = _mm_and_si128(_mm_or_si128(a, b), non_ascii_mask);
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(non_ascii, zero)) != 0xFFFF) {
+                    break;
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + o), _mm_packus_epi16(a, b));
+                i += 16;
+                o += 16;
+            }
+#endif
+            // Then up to a block's worth one at a time before trying the fast path again
+            const size_t block_end = std::min(len, i + 16);
+            while (i < block_end) {
+                uint32_t cp = static_cast<uint16_t>(src[i++]);
+                if (IsHighSurrogate(cp) && i < len && IsLowSurrogate(static_cast<uint16_t>(src[i]))) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (static_cast<uint16_t>(src[i++]) - 0xDC00);
+                }
+                else if (IsHighSurrogate(cp) || IsLowSurrogate(cp)) {
+                    if (mode == Mode::Strict) {
+                        return npos;
+                    }
+                    cp = replacement_char;
+                }
+                if (!EncodeUtf8(cp, out, out_len, o)) {
+                    return npos;
+                }
+            }
+        }
+        return o;
+    }
+
+    size_t ToWide(const std::string_view in, wchar_t* out, const size_t out_len, const Mode mode)
+    {
+        const auto src = reinterpret_cast<const uint8_t*>(in.data());
+        const size_t len = in.size();
+        size_t i = 0;
+        size_t o = 0;
+        while (i < len) {
+#ifdef UTF8_SSE2
+            // 16 ascii bytes at a time, widened by interleaving with zeroes
+            const __m128i zero = _mm_setzero_si128();
+            while (i + 16 <= len && o + 16 <= out_len) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                if (_mm_movemask_epi8(v)) {
+                    break;
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + o), _mm_unpacklo_epi8(v, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + o + 8), _mm_unpackhi_epi8(v, zero));
+                i += 16;
+                o += 16;
+            }
+#endif
+            const size_t block_end = std::min(len, i + 16);
+            while (i < block_end) {
+                uint32_t cp = DecodeUtf8(src, len, i);
+                if (cp == static_cast<uint32_t>(npos)) {
+                    if (mode == Mode::Strict) {
+                        return npos;
+                    }
+                    cp = replacement_char;
+                }
+                if (cp < 0x10000) {
+                    if (o + 1 > out_len) {
+                        return npos;
+                    }
+                    out[o++] = static_cast<wchar_t>(cp);
+                }
+                else {
+                    if (o + 2 > out_len) {
+                        return npos;
+                    }
+                    cp -= 0x10000;
+                    out[o++] = static_cast<wchar_t>(0xD800 + (cp >> 10));
+                    out[o++] = static_cast<wchar_t>(0xDC00 + (cp & 0x3FF));
+                }
+            }
+        }
+        return o;
+    }
+
+    bool FromWide(const std::wstring_view in, std::string& out, const Mode mode)
+    {
+        size_t written = 0;
+        out.resize_and_overwrite(in.size() * 3, [&](char* buf, const size_t buf_len) {
+            written = FromWide(in, buf, buf_len, mode);
+            return written == npos ? 0 : written;
+        });
+        return written != npos;
+    }
+
+    bool ToWide(const std::string_view in, std::wstring& out, const Mode mode)
+    {
+        size_t written = 0;
+        out.resize_and_overwrite(in.size(), [&](wchar_t* buf, const size_t buf_len) {
+            written = ToWide(in, buf, buf_len, mode);
+            return written == npos ? 0 : written;
+        });
+        return written != npos;
+    }
+
+    void ToLowerAscii(char* str, const size_t len)
+    {
+        size_t i = 0;
+#ifdef UTF8_SSE2
+        // Signed compares; bytes >= 0x80 are negative so never in range
+        const __m128i before_a = _mm_set1_epi8('A' - 1);
+        const __m128i after_z = _mm_set1_epi8('Z' + 1);
+        const __m128i to_lower = _mm_set1_epi8('a' - 'A');
+        for (; i + 16 <= len; i += 16) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+            const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, before_a), _mm_cmplt_epi8(v, after_z));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(str + i), _mm_add_epi8(v, _mm_and_si128(upper, to_lower)));
+        }
+#endif
+        ToLowerAsciiScalar(str + i, len - i);
+    }
+
+    void ToLowerAscii(wchar_t* str, const size_t len)
+    {
+        size_t i = 0;
+#ifdef UTF8_SSE2
+        const __m128i before_a = _mm_set1_epi16('A' - 1);
+        const __m128i after_z = _mm_set1_epi16('Z' + 1);
+        const __m128i to_lower = _mm_set1_epi16('a' - 'A');
+        for (; i + 8 <= len; i += 8) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+            const __m128i upper = _mm_and_si128(_mm_cmpgt_epi16(v, before_a), _mm_cmplt_epi16(v, after_z));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(str + i), _mm_add_epi16(v, _mm_and_si128(upper, to_lower)));
+        }
+#endif
+        ToLowerAsciiScalar(str + i, len - i);
+    }
+}
+
 utf8::string Unicode16ToUtf8(const wchar_t* str)
 {
-    utf8::string res;
-    const auto isize = WideCharToMultiByte(CP_UTF8, 0, str, -1, nullptr, 0, nullptr, nullptr);
-    if (isize < 0) {
-        return res;
-    }
-    const auto size = static_cast<size_t>(isize);
-    res.bytes = static_cast<char*>(malloc(size + 1));
-    res.count = size;
-    res.allocated = true;
-    WideCharToMultiByte(CP_UTF8, 0, str, -1, res.bytes, isize + 1, nullptr, nullptr);
-    return res;
+    return Unicode16ToUtf8(str, str + wcslen(str));
 }
 
 utf8::string Unicode16ToUtf8(const wchar_t* start, const wchar_t* end)
 {
     utf8::string res;
-    const auto isize = WideCharToMultiByte(CP_UTF8, 0, start, end - start, nullptr, 0,
-                                           nullptr, nullptr);
-    if (isize < 0) {
+    const std::wstring_view in(start, static_cast<size_t>(end - start));
+    const size_t size = in.size() * 3;
+    res.bytes = static_cast<char*>(malloc(size + 1));
+    if (!res.bytes) {
         return res;
     }
-    const auto size = static_cast<size_t>(isize);
-    res.bytes = static_cast<char*>(malloc(size + 1));
-    res.count = size;
     res.allocated = true;
-    WideCharToMultiByte(CP_UTF8, 0, start, end - start, res.bytes, isize + 1,
-                        nullptr, nullptr);
+    res.count = utf8::FromWide(in, res.bytes, size);
     res.bytes[res.count] = 0;
     return res;
 }
@@ -38,12 +280,10 @@ utf8::string Unicode16ToUtf8(const wchar_t* start, const wchar_t* end)
 utf8::string Unicode16ToUtf8(char* buffer, const size_t n_buffer, const wchar_t* start, const wchar_t* end)
 {
     utf8::string res;
-    const auto isize = WideCharToMultiByte(CP_UTF8, 0, start, end - start, buffer,
-                                           static_cast<int>(n_buffer), nullptr, nullptr);
-    if (isize < 0) {
+    const size_t size = utf8::FromWide({start, static_cast<size_t>(end - start)}, buffer, n_buffer);
+    if (size == utf8::npos) {
         return res;
     }
-    const auto size = static_cast<size_t>(isize);
     res.bytes = buffer;
     res.count = size;
     if (size + 1 < n_buffer) {
@@ -54,9 +294,14 @@ utf8::string Unicode16ToUtf8(char* buffer, const size_t n_buffer, const wchar_t*
 
 size_t Utf8ToUnicode(const char* str, wchar_t* buffer, const size_t count)
 {
-    const auto iret = MultiByteToWideChar(CP_UTF8, 0, str, -1, buffer, static_cast<int>(count));
-    if (iret < 0) {
+    // Includes the null terminator, as MultiByteToWideChar did
+    if (!count) {
+        return 0;
+    }
+    const size_t written = utf8::ToWide(str, buffer, count - 1);
+    if (written == utf8::npos) {
         return 0;
     }
-    return static_cast<size_t>(iret);
+    buffer[written] = 0;
+    return written + 1;
 }
@@ -24,19 +24,83 @@ namespace utf8 {
         {
             bytes = s.bytes;
             count = s.count;
+            allocated = s.allocated;
             s.bytes = nullptr;
             s.count = 0;
+            s.allocated = false;
         }
 
         string& operator=(string&& s) noexcept
         {
-            bytes = s.bytes;
-            count = s.count;
-            s.bytes = nullptr;
-            s.count = 0;
+            if (this != &s) {
+                if (allocated) {
+                    free(bytes);
+                }
+                bytes = s.bytes;
+                count = s.count;
+                allocated = s.allocated;
+                s.bytes = nullptr;
+                s.count = 0;
+                s.allocated = false;
+            }
             return *this;
         }
     };
+
+    constexpr size_t npos = static_cast<size_t>(-1);
+
+    enum class Mode : uint8_t {
+        // Unpaired surrogates and malformed utf8 are replaced with U+FFFD
+        Lenient,
+        // Conversion fails on unpaired surrogates and malformed utf8
+        Strict
+    };
+
+    // Transcoders working on caller supplied buffers; nothing is allocated, and nothing is null terminated.
+    // Runs of ascii are converted 16 characters at a time using SSE2.
+    // Return the number of chars written, or npos if the output didn't fit or the input is invalid in Strict mode.
+    // Worst case output is 3 bytes per wchar_t, and 1 wchar_t per byte.
+    size_t FromWide(std::wstring_view in, char* out, size_t out_len, Mode mode = Mode::Lenient);
+    size_t ToWide(std::string_view in, wchar_t* out, size_t out_len, Mode mode = Mode::Lenient);
+
+    // As above, overwriting out but reusing its capacity. Returns false (and clears out) if the input is invalid in Strict mode.
+    bool FromWide(std::wstring_view in, std::string& out, Mode mode = Mode::Lenient);
+    bool ToWide(std::string_view in, std::wstring& out, Mode mode = Mode::Lenient);
+
+    // Lower cases A-Z in place, leaving everything else alone; same as tolower() in the "C" locale
+    void ToLowerAscii(char* str, size_t len);
+    void ToLowerAscii(wchar_t* str, size_t len);
+
+    // Utf8 copy of a wide string, held on the stack unless it's longer than N - 1 bytes. For passing to ImGui and printf.
+    template <size_t N = 128>
+    class Buffer {
+    public:
+        explicit Buffer(const std::wstring_view str)
+        {
+            len = FromWide(str, small, N - 1);
+            if (len != npos) {
+                small[len] = 0;
+                ptr = small;
+                return;
+            }
+            FromWide(str, large);
+            len = large.size();
+            ptr = large.c_str();
+        }
+
+        Buffer(const Buffer&) = delete;
+        Buffer& operator=(const Buffer&) = delete;
+
+        [[nodiscard]] const char* c_str() const { return ptr; }
+        [[nodiscard]] size_t size() const { return len; }
+        [[nodiscard]] std::string_view view() const { return {ptr, len}; }
+
+    private:
+        char small[N];
+        std::string large;
+        const char* ptr = nullptr;
+        size_t len = 0;
+    };
 }
 
 // encode a unicode16 to utf8 using a allocated buffer (malloc).
@@ -0,0 +1,161 @@
+#include "stdafx.h"
+
+#include <GWCA/Managers/AgentMgr.h>
+
+#include <Utils/AgentSnapshot.h>
+
+namespace {
+    AgentSnapshot frame_snapshot;
+    bool frame_snapshot_dirty = true;
+}
+
+const AgentSnapshot& AgentSnapshot::Get()
+{
+    if (frame_snapshot_dirty) {
+        frame_snapshot.Build(GW::Agents::GetAgentArray());
+        frame_snapshot_dirty = false;
+    }
+    return frame_snapshot;
+}
+
+void AgentSnapshot::NewFrame()
+{
+    frame_snapshot_dirty = true;
+}
+
+void AgentSnapshot::Clear()
+{
+    agents.clear();
+    agent_ids.clear();
+    positions.clear();
+    allegiances.clear();
+    hp.clear();
+    player_numbers.clear();
+    flags.clear();
+    cell_start.clear();
+    cell_agents.clear();
+    grid_cols = grid_rows = 0;
+}
+
+void AgentSnapshot::Add(GW::Agent* agent, const uint32_t agent_id, const GW::Vec2f& position, const GW::Constants::Allegiance allegiance, const float _hp, const uint16_t player_number, const uint8_t _flags)
+{
+    agents.push_back(agent);
+    agent_ids.push_back(agent_id);
+    positions.push_back(position);
+    allegiances.push_back(allegiance);
+    hp.push_back(_hp);
+    player_numbers.push_back(player_number);
+    flags.push_back(_flags);
+}
+
+void AgentSnapshot::Build(const GW::AgentArray* agent_array)
+{
+    Clear();
+    if (!agent_array) {
+        return;
+    }
+    for (GW::Agent* agent : *agent_array) {
+        if (!agent) {
+            continue;
+        }
+        uint8_t agent_flags = 0;
+        auto allegiance = GW::Constants::Allegiance::Neutral;
+        float agent_hp = 0.f;
+        uint16_t player_number = 0;
+        if (const auto living = agent->GetAsAgentLiving()) {
+            agent_flags |= Living;
+            if (living->GetIsDead()) {
+                agent_flags |= Dead;
+            }
+            if (living->IsPlayer()) {
+                agent_flags |= Player;
+            }
+            allegiance = living->allegiance;
+            agent_hp = living->hp;
+            player_number = living->player_number;
+        }
+        else if (agent->GetIsItemType()) {
+            agent_flags |= Item;
+        }
+        else if (agent->GetIsGadgetType()) {
+            agent_flags |= Gadget;
+        }
+        if (GW::Agents::GetIsAgentTargettable(agent)) {
+            agent_flags |= Targettable;
+        }
+        Add(agent, agent->agent_id, agent->pos, allegiance, agent_hp, player_number, agent_flags);
+    }
+    BuildIndex();
+}
+
+int AgentSnapshot::CellX(const float x) const
+{
+    return std::clamp(static_cast<int>((x - grid_origin.x) / cell_size), 0, grid_cols - 1);
+}
+
+int AgentSnapshot::CellY(const float y) const
+{
+    return std::clamp(static_cast<int>((y - grid_origin.y) / cell_size), 0, grid_rows - 1);
+}
+
+void AgentSnapshot::BuildIndex()
+{
+    cell_start.clear();
+    cell_agents.clear();
+    grid_cols = grid_rows = 0;
+    if (positions.empty()) {
+        return;
+    }
+
+    GW::Vec2f min = positions[0];
+    GW::Vec2f max = positions[0];
+    for (const auto& pos : positions) {
+        min.x = std::min(min.x, pos.x);
+        min.y = std::min(min.y, pos.y);
+        max.x = std::max(max.x, pos.x);
+        max.y = std::max(max.y, pos.y);
+    }
+    grid_origin = min;
+    // Grow the cells rather than the grid on very large maps
+    const float extent = std::max(max.x - min.x, max.y - min.y);
+    cell_size = std::max(default_cell_size, extent / static_cast<float>(max_grid_dimension));
+    grid_cols = static_cast<int>((max.x - min.x) / cell_size) + 1;
+    grid_rows = static_cast<int>((max.y - min.y) / cell_size) + 1;
+
+    // Counting sort of agent indices by cell, reusing last frame's buffers
+    const auto cell_count = static_cast<size_t>(grid_cols * grid_rows);
+    cell_start.assign(cell_count + 1, 0);
+    agent_cells.resize(positions.size());
+    for (size_t i = 0; i < positions.size(); i++) {
+        const auto cell = static_cast<uint32_t>(CellY(positions[i].y) * grid_cols + CellX(positions[i].x));
+        agent_cells[i] = cell;
+        cell_start[cell]++;
+    }
+    // Prefix sums leave cell_start[c] at the end of cell c; filling backwards moves it to the start
+    for (size_t c = 1; c < cell_count; c++) {
+        cell_start[c] += cell_start[c - 1];
+    }
+    cell_start[cell_count] = static_cast<uint32_t>(positions.size());
+    cell_agents.resize(positions.size());
+    for (size_t i = positions.size(); i-- > 0;) {
+        cell_agents[--cell_start[agent_cells[i]]] = static_cast<uint32_t>(i);
+    }
+}
+
+size_t AgentSnapshot::FindNearestHostile(const GW::Vec2f& pos, const float range) const
+{
+    return FindNearest(pos, range, [this](const size_t index) {
+        return IsAliveLiving(index) && allegiances[index] == GW::Constants::Allegiance::Enemy;
+    });
+}
+
+size_t AgentSnapshot::GetAgentsInSpiritRange(const GW::Vec2f& pos, std::vector<size_t>& out) const
+{
+    const size_t before = out.size();
+    ForEachInRange(pos, GW::Constants::Range::Spirit, [this, &out](const size_t index) {
+        if (IsAliveLiving(index)) {
+            out.push_back(index);
+        }
+    });
+    return out.size() - before;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <GWCA/Constants/Constants.h>
+#include <GWCA/GameContainers/GamePos.h>
+#include <GWCA/GameEntities/Agent.h>
+
+// Copy of the agent array taken once per frame, laid out as parallel arrays, with a uniform grid over agent positions.
+// Widgets that would otherwise each walk GW::AgentArray and cast every agent can instead iterate these arrays, or ask for
+// the agents within a range without visiting the rest of the map.
+// Entries are addressed by index, valid for the frame the snapshot was taken; agents[] may dangle after that.
+// Must only be used from the render thread.
+class AgentSnapshot {
+public:
+    enum Flags : uint8_t {
+        Living = 1 << 0,
+        Dead = 1 << 1,
+        Item = 1 << 2,
+        Gadget = 1 << 3,
+        Targettable = 1 << 4,
+        Player = 1 << 5
+    };
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    // Snapshot of the current frame, taken on the first call after NewFrame()
+    static const AgentSnapshot& Get();
+    // Called once per frame before anything draws; the next Get() rebuilds the snapshot
+    static void NewFrame();
+
+    void Clear();
+    // Add an entry by hand, e.g. for synthetic data. Call BuildIndex() once done.
+    void Add(GW::Agent* agent, uint32_t agent_id, const GW::Vec2f& position, GW::Constants::Allegiance allegiance, float hp, uint16_t player_number, uint8_t flags);
+    void Build(const GW::AgentArray* agent_array);
+    void BuildIndex();
+
+    [[nodiscard]] size_t Size() const { return agent_ids.size(); }
+    [[nodiscard]] bool HasFlags(const size_t index, const uint8_t mask) const { return (flags[index] & mask) == mask; }
+    [[nodiscard]] bool IsAliveLiving(const size_t index) const { return (flags[index] & (Living | Dead)) == Living; }
+    [[nodiscard]] const GW::AgentLiving* GetLiving(const size_t index) const
+    {
+        return flags[index] & Living ? static_cast<const GW::AgentLiving*>(agents[index]) : nullptr;
+    }
+
+    // Calls fn(index) for every agent within range of pos
+    template <typename Fn>
+    void ForEachInRange(const GW::Vec2f& pos, float range, Fn&& fn) const;
+    // Index of the agent closest to pos, within range, for which predicate(index) is true; npos if none
+    template <typename Predicate>
+    [[nodiscard]] size_t FindNearest(const GW::Vec2f& pos, float range, Predicate&& predicate) const;
+    // Closest living enemy within range
+    [[nodiscard]] size_t FindNearestHostile(const GW::Vec2f& pos, float range = GW::Constants::Range::Compass) const;
+    // Indices of the living agents within spirit range of pos, appended to out; returns the number added
+    size_t GetAgentsInSpiritRange(const GW::Vec2f& pos, std::vector<size_t>& out) const;
+
+    // Parallel arrays, one entry per agent
+    std::vector<GW::Agent*> agents;
+    std::vector<uint32_t> agent_ids;
+    std::vector<GW::Vec2f> positions;
+    std::vector<GW::Constants::Allegiance> allegiances;
+    std::vector<float> hp;
+    std::vector<uint16_t> player_numbers;
+    std::vector<uint8_t> flags;
+
+private:
+    // Cells cover cell_size x cell_size game units, starting at grid_origin
+    static constexpr float default_cell_size = 1250.f;
+    static constexpr int max_grid_dimension = 128;
+
+    [[nodiscard]] int CellX(float x) const;
+    [[nodiscard]] int CellY(float y) const;
+
+    GW::Vec2f grid_origin;
+    float cell_size = default_cell_size;
+    int grid_cols = 0;
+    int grid_rows = 0;
+    // Agents in cell c are cell_agents[cell_start[c]] to cell_agents[cell_start[c + 1]]
+    std::vector<uint32_t> cell_start;
+    std::vector<uint32_t> cell_agents;
+    // Cell of each agent, scratch for BuildIndex()
+    std::vector<uint32_t> agent_cells;
+};
+
+template <typename Fn>
+void AgentSnapshot::ForEachInRange(const GW::Vec2f& pos, const float range, Fn&& fn) const
+{
+    if (!grid_cols || !grid_rows) {
+        return;
+    }
+    const float range_sq = range * range;
+    const int x0 = CellX(pos.x - range);
+    const int x1 = CellX(pos.x + range);
+    const int y0 = CellY(pos.y - range);
+    const int y1 = CellY(pos.y + range);
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            const auto cell = static_cast<size_t>(y * grid_cols + x);
+            for (uint32_t i = cell_start[cell]; i < cell_start[cell + 1]; i++) {
+                const uint32_t index = cell_agents[i];
+                if (GW::GetSquareDistance(pos, positions[index]) <= range_sq) {
+                    fn(static_cast<size_t>(index));
+                }
+            }
+        }
+    }
+}
+
+template <typename Predicate>
+size_t AgentSnapshot::FindNearest(const GW::Vec2f& pos, const float range, Predicate&& predicate) const
+{
+    size_t nearest = npos;
+    float nearest_distance = range * range;
+    ForEachInRange(pos, range, [&](const size_t index) {
+        const float distance = GW::GetSquareDistance(pos, positions[index]);
+        if (distance <= nearest_distance && predicate(index)) {
+            nearest_distance = distance;
+            nearest = index;
+        }
+    });
+    return nearest;
+}
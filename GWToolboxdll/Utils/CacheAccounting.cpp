@@ -0,0 +1,104 @@
+#include "stdafx.h"
+
+#include <Utils/CacheAccounting.h>
+
+namespace CacheAccounting {
+    float Stats::HitRate() const
+    {
+        const uint64_t lookups = hits + misses;
+        return lookups ? static_cast<float>(static_cast<double>(hits) / static_cast<double>(lookups)) : 0.f;
+    }
+
+    void Stats::ResetCounters()
+    {
+        hits = misses = evictions = reloads = 0;
+    }
+
+    size_t TextureBytes(uint32_t width, uint32_t height, const uint32_t levels, const uint32_t bits_per_pixel, const bool block_compressed)
+    {
+        size_t bits = 0;
+        for (uint32_t i = 0; i < std::max(levels, 1u); i++) {
+            size_t w = width;
+            size_t h = height;
+            if (block_compressed) {
+                w = std::max<size_t>(4, (w + 3) & ~static_cast<size_t>(3));
+                h = std::max<size_t>(4, (h + 3) & ~static_cast<size_t>(3));
+            }
+            bits += w * h * bits_per_pixel;
+            if (width == 1 && height == 1) {
+                break;
+            }
+            width = std::max(width >> 1, 1u);
+            height = std::max(height >> 1, 1u);
+        }
+        return (bits + 7) / 8;
+    }
+
+    void Lru::Add(const void* key, Stats& stats, const size_t bytes, const Clock::time_point now)
+    {
+        if (const auto found = index.find(key); found != index.end()) {
+            Release(*found->second);
+            entries.erase(found->second);
+            index.erase(found);
+        }
+        stats.resident++;
+        stats.bytes += bytes;
+        index[key] = entries.insert(entries.end(), {key, &stats, bytes, now});
+    }
+
+    bool Lru::Remove(const void* key)
+    {
+        const auto found = index.find(key);
+        if (found == index.end()) {
+            return false;
+        }
+        Release(*found->second);
+        entries.erase(found->second);
+        index.erase(found);
+        return true;
+    }
+
+    bool Lru::Touch(const void* key, const Clock::time_point now)
+    {
+        const auto found = index.find(key);
+        if (found == index.end()) {
+            return false;
+        }
+        found->second->last_used = now;
+        entries.splice(entries.end(), entries, found->second);
+        return true;
+    }
+
+    size_t Lru::Evict(const Clock::time_point cutoff, std::vector<const void*>& out, const std::function<bool(const void* key)>& can_evict)
+    {
+        size_t evicted = 0;
+        for (auto it = entries.begin(); it != entries.end() && it->last_used < cutoff;) {
+            if (can_evict && !can_evict(it->key)) {
+                ++it;
+                continue;
+            }
+            Release(*it);
+            it->stats->evictions++;
+            out.push_back(it->key);
+            index.erase(it->key);
+            it = entries.erase(it);
+            evicted++;
+        }
+        return evicted;
+    }
+
+    void Lru::Clear()
+    {
+        for (const auto& entry : entries) {
+            Release(entry);
+        }
+        entries.clear();
+        index.clear();
+    }
+
+    void Lru::Release(const Entry& entry)
+    {
+        entry.stats->resident--;
+        entry.stats->bytes -= entry.bytes;
+    }
+}
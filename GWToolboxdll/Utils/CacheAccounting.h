@@ -0,0 +1,80 @@
+#pragma once
+
+// Bookkeeping for the caches Resources keeps: how many entries each holds, roughly how much memory they take, how often
+// lookups hit, and which entries haven't been used for long enough to let go of.
+// Only depends on the standard library; Resources does the actual releasing and reloading. Not thread safe.
+namespace CacheAccounting {
+    using Clock = std::chrono::steady_clock;
+
+    struct Stats {
+        explicit Stats(const char* _name)
+            : name(_name) { }
+
+        const char* name;
+        // Keys in the cache, whether or not they're holding memory right now
+        size_t entries = 0;
+        // Entries holding memory, and how much
+        size_t resident = 0;
+        size_t bytes = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        uint64_t reloads = 0;
+
+        void Lookup(const bool hit)
+        {
+            if (hit) {
+                hits++;
+            }
+            else {
+                misses++;
+            }
+        }
+
+        // Fraction of lookups that found an existing entry; 0 before the first lookup
+        [[nodiscard]] float HitRate() const;
+        // Zero the counters, leaving entries and memory alone
+        void ResetCounters();
+    };
+
+    // Memory held by a texture including its mip chain. Block compressed formats are stored in whole 4x4 blocks.
+    [[nodiscard]] size_t TextureBytes(uint32_t width, uint32_t height, uint32_t levels, uint32_t bits_per_pixel, bool block_compressed = false);
+
+    // Resident entries in least recently used order, each charged to the Stats of the cache it belongs to.
+    // Keys are opaque, e.g. the address of the slot the owner hands out for the entry.
+    class Lru {
+    public:
+        Lru() = default;
+        Lru(const Lru&) = delete;
+        Lru& operator=(const Lru&) = delete;
+
+        // Track key as used now. If it's already tracked, its size (and cache) are replaced.
+        void Add(const void* key, Stats& stats, size_t bytes, Clock::time_point now);
+        // Stop tracking key without counting an eviction; false if it wasn't tracked
+        bool Remove(const void* key);
+        // Mark key as used; false if it isn't tracked
+        bool Touch(const void* key, Clock::time_point now);
+        // Stop tracking everything last used before cutoff, counting each as an eviction. Keys are appended to out, oldest first.
+        // Entries can_evict turns down (e.g. memory still referenced elsewhere) stay tracked, and are asked about again next time.
+        size_t Evict(Clock::time_point cutoff, std::vector<const void*>& out, const std::function<bool(const void* key)>& can_evict = nullptr);
+        // Stop tracking everything, without counting evictions
+        void Clear();
+
+        [[nodiscard]] bool Contains(const void* key) const { return index.contains(key); }
+        [[nodiscard]] size_t size() const { return index.size(); }
+
+    private:
+        struct Entry {
+            const void* key;
+            Stats* stats;
+            size_t bytes;
+            Clock::time_point last_used;
+        };
+
+        void Release(const Entry& entry);
+
+        // Least recently used first
+        std::list<Entry> entries;
+        std::unordered_map<const void*, std::list<Entry>::iterator> index;
+    };
+}
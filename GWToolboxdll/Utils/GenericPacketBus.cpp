@@ -0,0 +1,522 @@
+#include "stdafx.h"
+
+#include <atomic>
+
+#include <GWCA/Managers/StoCMgr.h>
+#include <GWCA/Packets/StoC.h>
+
+#include <Logger.h>
+#include <Utils/GenericPacketBus.h>
+
+using namespace GenericPacketBus;
+
+namespace {
+    constexpr size_t header_count = static_cast<size_t>(Header::Count);
+    constexpr size_t max_value_id = 256;
+
+    struct Subscriber {
+        GW::HookEntry* entry = nullptr;
+        Callback callback;
+        std::bitset<max_value_id> value_ids;
+        bool all_value_ids = true;
+    };
+
+    // Subscribers and game hook for one header, either before or after the game has handled the packet
+    struct Channel {
+        GW::HookEntry hook_entry;
+        bool hooked = false;
+        std::vector<Subscriber> subscribers;
+    };
+
+    // Only written by Dispatch on the game thread; atomic so that the info window can read and reset them without the bus lock
+    struct HeaderStats {
+        std::atomic<uint64_t> packets = 0;
+        std::atomic<uint64_t> callbacks = 0;
+        std::atomic<double> total_ms = 0.0;
+        std::atomic<double> max_ms = 0.0;
+    };
+
+    // [header][post]
+    Channel channels[header_count][2];
+    HeaderStats stats[header_count];
+
+    struct PendingSubscriber {
+        Header header;
+        bool post;
+        Subscriber subscriber;
+    };
+
+    // Subscribers can (un)subscribe from within a callback, or from another thread while a packet is being dispatched; changes are
+    // deferred until the outermost dispatch has finished, so that the subscriber arrays never move while they're being iterated.
+    // That lets Dispatch call back without holding the mutex: it takes it once to enter, and again on the way out only if
+    // something was deferred meanwhile. Unsubscribing clears Subscriber::entry atomically, which Dispatch checks lock free.
+    std::recursive_mutex mutex;
+    // Only incremented with mutex held
+    std::atomic_int dispatch_depth = 0;
+    std::atomic_bool changes_pending = false;
+    bool pending_removals = false;
+    std::vector<PendingSubscriber> pending_additions;
+
+    // Capture file: FileHeader, then for each packet a RecordHeader followed by the packet struct as received
+    struct FileHeader {
+        char magic[4] = {'G', 'P', 'B', 'R'};
+        uint32_t version = 1;
+    };
+    struct RecordHeader {
+        // Since recording started
+        uint32_t time_ms = 0;
+        Header header = Header::Count;
+        uint8_t size = 0;
+        uint16_t reserved = 0;
+    };
+    static_assert(sizeof(RecordHeader) == 8);
+
+    GW::HookEntry Recorder_Entry;
+    std::ofstream recording;
+    std::chrono::steady_clock::time_point recording_started;
+
+    struct ReplayRecord {
+        RecordHeader record;
+        size_t offset; // into replay_data
+    };
+    std::vector<uint8_t> replay_data;
+    std::vector<ReplayRecord> replay_records;
+    size_t replay_cursor = 0;
+    bool replay_realtime = false;
+    bool replay_started = false;
+    // Keeps a max speed replay from stalling the game thread for the whole capture
+    constexpr size_t max_replayed_per_frame = 256;
+    std::chrono::steady_clock::time_point replay_start_time;
+    ReplayStats replay_stats;
+
+    constexpr uint32_t GetHeaderId(const Header header)
+    {
+        switch (header) {
+            case Header::GenericValue:
+                return GW::Packet::StoC::GenericValue::STATIC_HEADER;
+            case Header::GenericValueTarget:
+                return GW::Packet::StoC::GenericValueTarget::STATIC_HEADER;
+            case Header::GenericModifier:
+                return GW::Packet::StoC::GenericModifier::STATIC_HEADER;
+            case Header::GenericFloat:
+                return GW::Packet::StoC::GenericFloat::STATIC_HEADER;
+            default:
+                return 0;
+        }
+    }
+
+    constexpr size_t GetPacketSize(const Header header)
+    {
+        switch (header) {
+            case Header::GenericValue:
+                return sizeof(GW::Packet::StoC::GenericValue);
+            case Header::GenericValueTarget:
+                return sizeof(GW::Packet::StoC::GenericValueTarget);
+            case Header::GenericModifier:
+                return sizeof(GW::Packet::StoC::GenericModifier);
+            case Header::GenericFloat:
+                return sizeof(GW::Packet::StoC::GenericFloat);
+            default:
+                return 0;
+        }
+    }
+
+    Event Decode(const Header header, GW::Packet::StoC::PacketBase* base)
+    {
+        Event event;
+        event.header = header;
+        event.packet = base;
+        switch (header) {
+            case Header::GenericValue: {
+                const auto packet = static_cast<GW::Packet::StoC::GenericValue*>(base);
+                event.value_id = packet->value_id;
+                event.caster_id = packet->agent_id;
+                event.value = packet->value;
+            } break;
+            case Header::GenericValueTarget: {
+                const auto packet = static_cast<GW::Packet::StoC::GenericValueTarget*>(base);
+                event.value_id = packet->Value_id;
+                event.caster_id = packet->caster;
+                event.target_id = packet->target;
+                event.value = packet->value;
+            } break;
+            case Header::GenericModifier: {
+                const auto packet = static_cast<GW::Packet::StoC::GenericModifier*>(base);
+                event.value_id = packet->type;
+                event.caster_id = packet->cause_id;
+                event.target_id = packet->target_id;
+                event.float_value = packet->value;
+            } break;
+            case Header::GenericFloat: {
+                const auto packet = static_cast<GW::Packet::StoC::GenericFloat*>(base);
+                event.value_id = packet->type;
+                event.caster_id = packet->agent_id;
+                event.float_value = packet->value;
+            } break;
+            default:
+                break;
+        }
+        return event;
+    }
+
+    void Dispatch(Header header, bool post, GW::HookStatus* status, GW::Packet::StoC::PacketBase* base, bool replayed = false);
+
+    GW::HookEntry* GetEntry(Subscriber& subscriber)
+    {
+        return std::atomic_ref(subscriber.entry).load();
+    }
+
+    // The game hook of a channel left without subscribers is only removed outside of dispatch, never from within its own callback
+    void RemovePendingSubscribers(const bool unhook_empty_channels)
+    {
+        for (auto& header_channels : channels) {
+            for (auto& channel : header_channels) {
+                std::erase_if(channel.subscribers, [](Subscriber& subscriber) {
+                    return !GetEntry(subscriber);
+                });
+                if (unhook_empty_channels && channel.hooked && channel.subscribers.empty()) {
+                    GW::StoC::RemoveCallbacks(&channel.hook_entry);
+                    channel.hooked = false;
+                }
+            }
+        }
+        pending_removals = false;
+    }
+
+    void AddSubscriber(const Header header, const bool post, const Subscriber& subscriber)
+    {
+        auto& channel = channels[static_cast<size_t>(header)][post];
+        channel.subscribers.push_back(subscriber);
+        if (channel.hooked) {
+            return;
+        }
+        const auto on_packet = [header, post](GW::HookStatus* status, GW::Packet::StoC::PacketBase* packet) {
+            Dispatch(header, post, status, packet);
+        };
+        if (post) {
+            GW::StoC::RegisterPostPacketCallback(&channel.hook_entry, GetHeaderId(header), on_packet);
+        }
+        else {
+            GW::StoC::RegisterPacketCallback(&channel.hook_entry, GetHeaderId(header), on_packet);
+        }
+        channel.hooked = true;
+    }
+
+    // Call with mutex held. Either side may get here first: a dispatch finishing, or the thread that deferred a change
+    // noticing that the dispatch it was waiting on has already finished.
+    void ApplyPendingChanges()
+    {
+        if (dispatch_depth) {
+            return;
+        }
+        changes_pending = false;
+        for (const auto& [header, post, subscriber] : pending_additions) {
+            AddSubscriber(header, post, subscriber);
+        }
+        pending_additions.clear();
+        if (pending_removals) {
+            RemovePendingSubscribers(false);
+        }
+    }
+
+    void Dispatch(const Header header, const bool post, GW::HookStatus* status, GW::Packet::StoC::PacketBase* base, const bool replayed)
+    {
+        const auto started = std::chrono::steady_clock::now();
+        auto event = Decode(header, base);
+        event.replayed = replayed;
+        const bool value_id_in_range = event.value_id < max_value_id;
+        auto& subscribers = channels[static_cast<size_t>(header)][post].subscribers;
+        {
+            std::lock_guard lock(mutex);
+            dispatch_depth++;
+        }
+        uint64_t callbacks = 0;
+        for (auto& subscriber : subscribers) {
+            if (!GetEntry(subscriber)) {
+                continue;
+            }
+            if (!subscriber.all_value_ids && !(value_id_in_range && subscriber.value_ids[event.value_id])) {
+                continue;
+            }
+            callbacks++;
+            subscriber.callback(status, event);
+        }
+
+        if (--dispatch_depth == 0 && changes_pending) {
+            std::lock_guard lock(mutex);
+            ApplyPendingChanges();
+        }
+        if (replayed) {
+            return; // Timed by Update instead
+        }
+        auto& header_stats = stats[static_cast<size_t>(header)];
+        const auto elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+        header_stats.callbacks.fetch_add(callbacks, std::memory_order_relaxed);
+        header_stats.packets.fetch_add(1, std::memory_order_relaxed);
+        header_stats.total_ms.fetch_add(elapsed_ms, std::memory_order_relaxed);
+        if (elapsed_ms > header_stats.max_ms.load(std::memory_order_relaxed)) {
+            header_stats.max_ms.store(elapsed_ms, std::memory_order_relaxed);
+        }
+    }
+
+    void AddSubscription(GW::HookEntry* entry, const std::initializer_list<Header> headers, const Callback& callback, const std::initializer_list<uint32_t> value_ids, const bool post)
+    {
+        std::lock_guard lock(mutex);
+        Subscriber subscriber;
+        subscriber.entry = entry;
+        subscriber.callback = callback;
+        subscriber.all_value_ids = value_ids.size() == 0;
+        for (const auto value_id : value_ids) {
+            if (value_id >= max_value_id) {
+                // Can't be filtered on; let the subscriber see everything rather than miss packets
+                subscriber.all_value_ids = true;
+                break;
+            }
+            subscriber.value_ids.set(value_id);
+        }
+        for (const auto header : headers) {
+            if (dispatch_depth) {
+                pending_additions.push_back({header, post, subscriber});
+                changes_pending = true;
+            }
+            else {
+                AddSubscriber(header, post, subscriber);
+            }
+        }
+        if (changes_pending) {
+            ApplyPendingChanges();
+        }
+    }
+}
+
+uint32_t Event::GetSkillCaster() const
+{
+    if (header == Header::GenericValueTarget
+        && (value_id == GW::Packet::StoC::GenericValueID::skill_activated || value_id == GW::Packet::StoC::GenericValueID::attack_skill_activated)) {
+        return target_id;
+    }
+    return caster_id;
+}
+
+void GenericPacketBus::Subscribe(GW::HookEntry* entry, const std::initializer_list<Header> headers, const Callback& callback, const std::initializer_list<uint32_t> value_ids, const bool post)
+{
+    AddSubscription(entry, headers, callback, value_ids, post);
+}
+
+void GenericPacketBus::Unsubscribe(GW::HookEntry* entry)
+{
+    std::lock_guard lock(mutex);
+    std::erase_if(pending_additions, [entry](const PendingSubscriber& pending) {
+        return pending.subscriber.entry == entry;
+    });
+    for (auto& header_channels : channels) {
+        for (auto& channel : header_channels) {
+            for (auto& subscriber : channel.subscribers) {
+                if (GetEntry(subscriber) == entry) {
+                    std::atomic_ref(subscriber.entry).store(nullptr);
+                    pending_removals = true;
+                }
+            }
+        }
+    }
+    if (!pending_removals) {
+        return;
+    }
+    if (!dispatch_depth) {
+        RemovePendingSubscribers(true);
+        return;
+    }
+    changes_pending = true;
+    ApplyPendingChanges();
+}
+
+Stats GenericPacketBus::GetStats(const Header header)
+{
+    std::lock_guard lock(mutex);
+    const auto idx = static_cast<size_t>(header);
+    const auto& header_stats = stats[idx];
+    return {
+        channels[idx][0].subscribers.size() + channels[idx][1].subscribers.size(),
+        header_stats.packets.load(),
+        header_stats.callbacks.load(),
+        header_stats.total_ms.load(),
+        header_stats.max_ms.load()
+    };
+}
+
+void GenericPacketBus::ResetStats()
+{
+    for (auto& header_stats : stats) {
+        header_stats.packets = 0;
+        header_stats.callbacks = 0;
+        header_stats.total_ms = 0.0;
+        header_stats.max_ms = 0.0;
+    }
+}
+
+bool GenericPacketBus::StartRecording(const std::filesystem::path& path)
+{
+    std::lock_guard lock(mutex);
+    if (recording.is_open() || IsReplaying()) {
+        return false;
+    }
+    recording.open(path, std::ios::binary | std::ios::trunc);
+    if (!recording.is_open()) {
+        Log::Error("Failed to open %s for recording packets", path.string().c_str());
+        return false;
+    }
+    constexpr FileHeader file_header;
+    recording.write(reinterpret_cast<const char*>(&file_header), sizeof(file_header));
+    recording_started = std::chrono::steady_clock::now();
+    Subscribe(&Recorder_Entry, {Header::GenericValue, Header::GenericValueTarget, Header::GenericModifier, Header::GenericFloat}, [](GW::HookStatus*, const Event& event) {
+        // StopRecording may close the file from the UI thread while this is being dispatched
+        std::lock_guard recording_lock(mutex);
+        if (!recording.is_open()) {
+            return;
+        }
+        RecordHeader record;
+        record.time_ms = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - recording_started).count());
+        record.header = event.header;
+        record.size = static_cast<uint8_t>(GetPacketSize(event.header));
+        recording.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        recording.write(reinterpret_cast<const char*>(event.packet), record.size);
+    });
+    return true;
+}
+
+void GenericPacketBus::StopRecording()
+{
+    std::lock_guard lock(mutex);
+    Unsubscribe(&Recorder_Entry);
+    if (recording.is_open()) {
+        recording.close();
+    }
+}
+
+bool GenericPacketBus::IsRecording()
+{
+    std::lock_guard lock(mutex);
+    return recording.is_open();
+}
+
+bool GenericPacketBus::StartReplay(const std::filesystem::path& path, const bool realtime)
+{
+    std::lock_guard lock(mutex);
+    if (recording.is_open() || IsReplaying()) {
+        return false;
+    }
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        Log::Error("Failed to open %s for replaying packets", path.string().c_str());
+        return false;
+    }
+    replay_data.assign(std::istreambuf_iterator(file), std::istreambuf_iterator<char>());
+    replay_records.clear();
+
+    constexpr FileHeader expected_header;
+    if (replay_data.size() < sizeof(FileHeader) || memcmp(replay_data.data(), &expected_header, sizeof(FileHeader)) != 0) {
+        Log::Error("%s is not a packet capture", path.string().c_str());
+        replay_data.clear();
+        return false;
+    }
+    size_t offset = sizeof(FileHeader);
+    while (offset + sizeof(RecordHeader) <= replay_data.size()) {
+        ReplayRecord replay_record;
+        memcpy(&replay_record.record, replay_data.data() + offset, sizeof(RecordHeader));
+        replay_record.offset = offset + sizeof(RecordHeader);
+        const auto& record = replay_record.record;
+        if (record.header >= Header::Count || record.size != GetPacketSize(record.header) || replay_record.offset + record.size > replay_data.size()) {
+            break; // Truncated or from an incompatible build; replay what we have up to here
+        }
+        replay_records.push_back(replay_record);
+        offset = replay_record.offset + record.size;
+    }
+
+    replay_cursor = 0;
+    replay_realtime = realtime;
+    replay_started = false;
+    replay_stats = {};
+    replay_stats.packets = replay_records.size();
+    return true;
+}
+
+void GenericPacketBus::StopReplay()
+{
+    std::lock_guard lock(mutex);
+    replay_records.clear();
+    replay_data.clear();
+    replay_cursor = 0;
+}
+
+bool GenericPacketBus::IsReplaying()
+{
+    std::lock_guard lock(mutex);
+    return replay_cursor < replay_records.size();
+}
+
+ReplayStats GenericPacketBus::GetReplayStats()
+{
+    std::lock_guard lock(mutex);
+    return replay_stats;
+}
+
+void GenericPacketBus::Update()
+{
+    // Copied out of the file buffer so that the packet is suitably aligned, and so that the lock needn't be held while dispatching
+    alignas(8) uint8_t packet_buffer[256];
+    const auto started = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < max_replayed_per_frame; i++) {
+        Header header;
+        {
+            std::lock_guard lock(mutex);
+            if (replay_cursor >= replay_records.size()) {
+                break;
+            }
+            if (!replay_started) {
+                replay_start_time = started;
+                replay_started = true;
+            }
+            const auto& [record, offset] = replay_records[replay_cursor];
+            if (replay_realtime && record.time_ms > std::chrono::duration_cast<std::chrono::milliseconds>(started - replay_start_time).count()) {
+                break;
+            }
+            header = record.header;
+            memcpy(packet_buffer, replay_data.data() + offset, record.size);
+            replay_cursor++;
+            replay_stats.packets_replayed++;
+        }
+        // Same path as a live packet, minus the game handling it in between
+        GW::HookStatus status;
+        const auto packet = reinterpret_cast<GW::Packet::StoC::PacketBase*>(packet_buffer);
+        Dispatch(header, false, &status, packet, true);
+        Dispatch(header, true, &status, packet, true);
+    }
+
+    std::lock_guard lock(mutex);
+    if (!replay_started) {
+        return;
+    }
+    replay_stats.dispatch_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    if (replay_cursor >= replay_records.size()) {
+        replay_records.clear();
+        replay_data.clear();
+        replay_cursor = 0;
+        replay_started = false;
+    }
+}
+
+const char* GenericPacketBus::GetHeaderName(const Header header)
+{
+    switch (header) {
+        case Header::GenericValue:
+            return "GenericValue";
+        case Header::GenericValueTarget:
+            return "GenericValueTarget";
+        case Header::GenericModifier:
+            return "GenericModifier";
+        case Header::GenericFloat:
+            return "GenericFloat";
+        default:
+            return "Unknown";
+    }
+}
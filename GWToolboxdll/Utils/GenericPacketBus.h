@@ -0,0 +1,89 @@
+#pragma once
+
+#include <GWCA/Utilities/Hook.h>
+
+namespace GW::Packet::StoC {
+    struct PacketBase;
+}
+
+// Single StoC hook per generic value packet header, shared by every module that listens to them.
+// Packets are decoded once into an Event and handed to the subscribers of that header in the order they subscribed;
+// subscribers can limit themselves to the value ids they care about, so that the rest are skipped without a call.
+namespace GenericPacketBus {
+    enum class Header : uint8_t {
+        GenericValue,
+        GenericValueTarget,
+        GenericModifier,
+        GenericFloat,
+        Count
+    };
+
+    struct Event {
+        Header header = Header::Count;
+        uint32_t value_id = 0;
+        // agent_id for GenericValue and GenericFloat, cause_id for GenericModifier
+        uint32_t caster_id = 0;
+        // 0 for GenericValue and GenericFloat
+        uint32_t target_id = 0;
+        // GenericValue and GenericValueTarget
+        uint32_t value = 0;
+        // GenericModifier and GenericFloat
+        float float_value = 0.f;
+        GW::Packet::StoC::PacketBase* packet = nullptr;
+        // From a capture being replayed rather than the game; agent ids etc. belong to the session it was recorded in.
+        // Subscribers whose state mustn't see another session's packets can skip these.
+        bool replayed = false;
+
+        [[nodiscard]] bool HasTarget() const
+        {
+            return header == Header::GenericValueTarget || header == Header::GenericModifier;
+        }
+
+        // The server swaps caster and target for skill_activated and attack_skill_activated; this is the agent that used the skill
+        [[nodiscard]] uint32_t GetSkillCaster() const;
+    };
+
+    using Callback = std::function<void(GW::HookStatus*, const Event&)>;
+
+    // Calls back for packets with any of the given headers. value_ids limits the callback to those value ids (below 256, otherwise it is ignored), or all if empty.
+    // post: called after the game has handled the packet, same as GW::StoC::RegisterPostPacketCallback
+    void Subscribe(GW::HookEntry* entry, std::initializer_list<Header> headers, const Callback& callback, std::initializer_list<uint32_t> value_ids = {}, bool post = false);
+    // Remove every subscription made with this entry
+    void Unsubscribe(GW::HookEntry* entry);
+
+    struct Stats {
+        size_t subscribers = 0;
+        uint64_t packets = 0;
+        // Number of subscriber callbacks made, i.e. not filtered out by value id
+        uint64_t callbacks = 0;
+        // Time spent in subscriber callbacks, including decoding and filtering
+        double total_ms = 0.0;
+        double max_ms = 0.0;
+    };
+    Stats GetStats(Header header);
+    void ResetStats();
+    const char* GetHeaderName(Header header);
+
+    // Capture of the packets passing through the bus, so that subscribers can be exercised (and timed) again without reproducing the fight in game.
+    // Replayed packets go to the same subscribers as live ones, before then after dispatch, but never to the game itself; modules
+    // will show the replayed fight, so replay where that doesn't matter, e.g. in an outpost.
+    bool StartRecording(const std::filesystem::path& path);
+    void StopRecording();
+    [[nodiscard]] bool IsRecording();
+
+    // realtime: dispatch packets with their recorded timing, otherwise as fast as possible (a few hundred per Update())
+    bool StartReplay(const std::filesystem::path& path, bool realtime);
+    void StopReplay();
+    [[nodiscard]] bool IsReplaying();
+
+    struct ReplayStats {
+        size_t packets = 0;
+        size_t packets_replayed = 0;
+        // Time spent dispatching the replayed packets, excluding the time waited between them
+        double dispatch_ms = 0.0;
+    };
+    ReplayStats GetReplayStats();
+
+    // Called once per game thread frame; dispatches any replayed packets that are due
+    void Update();
+}
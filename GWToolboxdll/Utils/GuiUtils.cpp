@@ -415,17 +415,13 @@ namespace GuiUtils {
 
     std::string ToLower(std::string s)
     {
-        std::ranges::transform(s, s.begin(), [](const char c) -> char {
-            return static_cast<char>(tolower(c));
-        });
+        utf8::ToLowerAscii(s.data(), s.size());
         return s;
     }
 
     std::wstring ToLower(std::wstring s)
     {
-        std::ranges::transform(s, s.begin(), [](const wchar_t c) -> wchar_t {
-            return static_cast<wchar_t>(tolower(c));
-        });
+        utf8::ToLowerAscii(s.data(), s.size());
         return s;
     }
 
@@ -517,23 +513,23 @@ namespace GuiUtils {
 
     // Convert a wide Unicode string to an UTF8 string
     std::string WStringToString(const std::wstring_view str)
+    {
+        std::string dest;
+        WStringToString(str, dest);
+        return dest;
+    }
+
+    std::string& WStringToString(const std::wstring_view str, std::string& dest)
     {
         // @Cleanup: ASSERT used incorrectly here; value passed could be from anywhere!
-        if (str.empty()) {
-            return "";
-        }
-        // NB: GW uses code page 0 (CP_ACP)
-        const int try_code_pages[] = { CP_UTF8, CP_ACP };
-        for (auto cp : try_code_pages) {
-            const auto size_needed = WideCharToMultiByte(cp, WC_ERR_INVALID_CHARS, str.data(), static_cast<int>(str.size()), nullptr, 0, nullptr, nullptr);
-            if (!size_needed)
-                continue;
-            std::string dest(size_needed, 0);
-            ASSERT(WideCharToMultiByte(cp, 0, str.data(), static_cast<int>(str.size()), dest.data(), size_needed, nullptr, nullptr));
+        if (utf8::FromWide(str, dest, utf8::Mode::Strict)) {
             return dest;
         }
-        ASSERT("Failed to convert" && false);
-        return {};
+        // NB: GW uses code page 0 (CP_ACP)
+        const auto size_needed = WideCharToMultiByte(CP_ACP, 0, str.data(), static_cast<int>(str.size()), nullptr, 0, nullptr, nullptr);
+        dest.resize(size_needed);
+        ASSERT(size_needed && WideCharToMultiByte(CP_ACP, 0, str.data(), static_cast<int>(str.size()), dest.data(), size_needed, nullptr, nullptr));
+        return dest;
     }
 
     // Makes sure the file name doesn't have chars that won't be allowed on disk
@@ -595,23 +591,23 @@ namespace GuiUtils {
 
     // Convert an UTF8 string to a wide Unicode String
     std::wstring StringToWString(const std::string_view str)
+    {
+        std::wstring dest;
+        StringToWString(str, dest);
+        return dest;
+    }
+
+    std::wstring& StringToWString(const std::string_view str, std::wstring& dest)
     {
         // @Cleanup: ASSERT used incorrectly here; value passed could be from anywhere!
-        if (str.empty()) {
-            return {};
-        }
-        // NB: GW uses code page 0 (CP_ACP)
-        const int try_code_pages[] = { CP_UTF8, CP_ACP };
-        for (auto cp : try_code_pages) {
-            const auto size_needed = MultiByteToWideChar(cp, MB_ERR_INVALID_CHARS, str.data(), static_cast<int>(str.size()), nullptr, 0);
-            if (!size_needed)
-                continue;
-            std::wstring dest(size_needed, 0);
-            ASSERT(MultiByteToWideChar(cp, 0, str.data(), static_cast<int>(str.size()), dest.data(), size_needed));
+        if (utf8::ToWide(str, dest, utf8::Mode::Strict)) {
             return dest;
         }
-        ASSERT("Failed to convert" && false);
-        return {};
+        // Not utf8; NB: GW uses code page 0 (CP_ACP)
+        const auto size_needed = MultiByteToWideChar(CP_ACP, 0, str.data(), static_cast<int>(str.size()), nullptr, 0);
+        dest.resize(size_needed);
+        ASSERT(size_needed && MultiByteToWideChar(CP_ACP, 0, str.data(), static_cast<int>(str.size()), dest.data(), size_needed));
+        return dest;
     }
 
     std::wstring SanitizePlayerName(const std::wstring_view str)
@@ -1013,7 +1009,7 @@ namespace GuiUtils {
     {
         wstring();
         if (sanitised && !decoded_ws.empty() && decoded_s.empty()) {
-            decoded_s = WStringToString(decoded_ws);
+            WStringToString(decoded_ws, decoded_s);
         }
         return decoded_s;
     }
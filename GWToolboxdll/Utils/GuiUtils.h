@@ -62,6 +62,9 @@ namespace GuiUtils {
 
     std::string WStringToString(std::wstring_view str);
     std::wstring StringToWString(std::string_view str);
+    // As above, converting into dest and reusing its capacity
+    std::string& WStringToString(std::wstring_view str, std::string& dest);
+    std::wstring& StringToWString(std::string_view str, std::wstring& dest);
     std::string SanitiseFilename(std::string_view str);
     std::wstring SanitiseFilename(std::wstring_view str);
     std::wstring SanitizePlayerName(std::wstring_view str);
@@ -167,6 +170,12 @@ namespace GuiUtils {
             return encoded_ws;
         };
 
+        // Rough memory held, including the strings' buffers
+        [[nodiscard]] size_t BytesUsed() const
+        {
+            return sizeof(*this) + (encoded_ws.capacity() + decoded_ws.capacity()) * sizeof(wchar_t) + decoded_s.capacity();
+        }
+
         EncString(const wchar_t* _enc_string = nullptr, const bool sanitise = true)
         {
             reset(_enc_string, sanitise);
@@ -0,0 +1,399 @@
+#include "stdafx.h"
+
+#include <charconv>
+
+#include <Utils/HtmlTokenizer.h>
+
+namespace {
+    constexpr std::string_view whitespace = " \t\n\r\f\v";
+
+    bool IsNameChar(const char c)
+    {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_' || c == ':';
+    }
+
+    bool IsVoidElement(const std::string_view name)
+    {
+        constexpr std::string_view void_elements[] = {"area", "base", "br", "col", "embed", "hr", "img", "input", "link", "meta", "source", "track", "wbr"};
+        return std::ranges::any_of(void_elements, [name](const std::string_view el) {
+            return Html::EqualsIgnoreCase(name, el);
+        });
+    }
+
+    std::string_view Trim(std::string_view str)
+    {
+        const auto first = str.find_first_not_of(whitespace);
+        if (first == std::string_view::npos) {
+            return {};
+        }
+        str.remove_prefix(first);
+        return str.substr(0, str.find_last_not_of(whitespace) + 1);
+    }
+
+    void AppendCodePoint(std::string& out, const uint32_t cp)
+    {
+        if (cp < 0x80) {
+            out.push_back(static_cast<char>(cp));
+        }
+        else if (cp < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+        else if (cp < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+        else if (cp < 0x110000) {
+            out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+    }
+}
+
+bool Html::EqualsIgnoreCase(const std::string_view a, const std::string_view b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Html::Tokenizer::Next(Token& token)
+{
+    if (pos >= html.size()) {
+        return false;
+    }
+    token = {};
+    token.begin = pos;
+
+    if (!raw_text_tag.empty()) {
+        // Content of <script> or <style> runs up to its end tag, whatever it contains
+        size_t end = pos;
+        while ((end = html.find("</", end)) != std::string_view::npos) {
+            if (EqualsIgnoreCase(html.substr(end + 2, raw_text_tag.size()), raw_text_tag)) {
+                break;
+            }
+            end += 2;
+        }
+        raw_text_tag = {};
+        pos = end == std::string_view::npos ? html.size() : end;
+        if (pos > token.begin) {
+            token.type = Token::Type::Text;
+            token.text = html.substr(token.begin, pos - token.begin);
+            token.end = pos;
+            return true;
+        }
+    }
+
+    if (html[pos] != '<' || pos + 1 >= html.size()) {
+        const auto next_tag = html.find('<', pos + 1);
+        pos = next_tag == std::string_view::npos ? html.size() : next_tag;
+        token.type = Token::Type::Text;
+        token.text = html.substr(token.begin, pos - token.begin);
+        token.end = pos;
+        return true;
+    }
+
+    const char c = html[pos + 1];
+    if (c == '!' || c == '?') {
+        token.type = Token::Type::Comment;
+        if (html.substr(pos, 4) == "<!--") {
+            const auto end = html.find("-->", pos + 4);
+            pos = end == std::string_view::npos ? html.size() : end + 3;
+        }
+        else {
+            const auto end = html.find('>', pos + 2);
+            pos = end == std::string_view::npos ? html.size() : end + 1;
+        }
+        token.text = html.substr(token.begin, pos - token.begin);
+        token.end = pos;
+        return true;
+    }
+
+    const bool is_end_tag = c == '/';
+    const size_t name_start = pos + (is_end_tag ? 2 : 1);
+    size_t name_end = name_start;
+    while (name_end < html.size() && IsNameChar(html[name_end])) {
+        name_end++;
+    }
+    if (name_end == name_start) {
+        // Stray <, treat it as text
+        const auto next_tag = html.find('<', pos + 1);
+        pos = next_tag == std::string_view::npos ? html.size() : next_tag;
+        token.type = Token::Type::Text;
+        token.text = html.substr(token.begin, pos - token.begin);
+        token.end = pos;
+        return true;
+    }
+    token.name = html.substr(name_start, name_end - name_start);
+
+    // Find the closing >, skipping over quoted attribute values
+    size_t i = name_end;
+    char quote = 0;
+    for (; i < html.size(); i++) {
+        const char ch = html[i];
+        if (quote) {
+            if (ch == quote) {
+                quote = 0;
+            }
+        }
+        else if (ch == '"' || ch == '\'') {
+            quote = ch;
+        }
+        else if (ch == '>') {
+            break;
+        }
+    }
+    const size_t close = std::min(i, html.size());
+    pos = std::min(close + 1, html.size());
+    token.end = pos;
+
+    if (is_end_tag) {
+        token.type = Token::Type::EndTag;
+        return true;
+    }
+    token.type = Token::Type::StartTag;
+    auto attributes = html.substr(name_end, close - name_end);
+    if (!attributes.empty() && attributes.back() == '/') {
+        token.self_closing = true;
+        attributes.remove_suffix(1);
+    }
+    token.attributes = attributes;
+    if (!token.self_closing && (EqualsIgnoreCase(token.name, "script") || EqualsIgnoreCase(token.name, "style"))) {
+        raw_text_tag = token.name;
+    }
+    return true;
+}
+
+std::string_view Html::Tokenizer::SkipElement(const Token& open)
+{
+    if (open.type != Token::Type::StartTag || open.self_closing || IsVoidElement(open.name)) {
+        return html.substr(open.end, 0);
+    }
+    int depth = 1;
+    Token token;
+    while (Next(token)) {
+        if (!EqualsIgnoreCase(token.name, open.name)) {
+            continue;
+        }
+        if (token.type == Token::Type::StartTag && !token.self_closing) {
+            depth++;
+        }
+        else if (token.type == Token::Type::EndTag && --depth == 0) {
+            return html.substr(open.end, token.begin - open.end);
+        }
+    }
+    // Never closed; everything up to the end of the source
+    return html.substr(open.end);
+}
+
+std::string_view Html::GetAttribute(const std::string_view attributes, const std::string_view name)
+{
+    size_t i = 0;
+    while (i < attributes.size()) {
+        i = attributes.find_first_not_of(whitespace, i);
+        if (i == std::string_view::npos) {
+            break;
+        }
+        const size_t name_start = i;
+        while (i < attributes.size() && attributes[i] != '=' && whitespace.find(attributes[i]) == std::string_view::npos) {
+            i++;
+        }
+        const auto attribute_name = attributes.substr(name_start, i - name_start);
+        i = attributes.find_first_not_of(whitespace, i);
+        if (i == std::string_view::npos || attributes[i] != '=') {
+            // Attribute without a value
+            if (EqualsIgnoreCase(attribute_name, name)) {
+                return attributes.substr(name_start + attribute_name.size(), 0);
+            }
+            continue;
+        }
+        i = attributes.find_first_not_of(whitespace, i + 1);
+        if (i == std::string_view::npos) {
+            break;
+        }
+        std::string_view value;
+        if (attributes[i] == '"' || attributes[i] == '\'') {
+            const auto end = attributes.find(attributes[i], i + 1);
+            value = attributes.substr(i + 1, end == std::string_view::npos ? std::string_view::npos : end - i - 1);
+            i = end == std::string_view::npos ? attributes.size() : end + 1;
+        }
+        else {
+            const auto end = attributes.find_first_of(whitespace, i);
+            value = attributes.substr(i, end == std::string_view::npos ? std::string_view::npos : end - i);
+            i = end == std::string_view::npos ? attributes.size() : end;
+        }
+        if (EqualsIgnoreCase(attribute_name, name)) {
+            return value;
+        }
+    }
+    return {};
+}
+
+bool Html::HasClass(const std::string_view attributes, const std::string_view class_name)
+{
+    const auto classes = GetAttribute(attributes, "class");
+    size_t i = 0;
+    while (i < classes.size()) {
+        i = classes.find_first_not_of(whitespace, i);
+        if (i == std::string_view::npos) {
+            break;
+        }
+        auto end = classes.find_first_of(whitespace, i);
+        if (end == std::string_view::npos) {
+            end = classes.size();
+        }
+        if (classes.substr(i, end - i) == class_name) {
+            return true;
+        }
+        i = end;
+    }
+    return false;
+}
+
+std::string Html::DecodeEntities(const std::string_view text)
+{
+    // Between '&' and ';': "#x10FFFF" is the longest
+    constexpr size_t max_entity_length = 8;
+    std::string out;
+    out.reserve(text.size());
+    size_t i = 0;
+    while (i < text.size()) {
+        const auto amp = text.find('&', i);
+        if (amp == std::string_view::npos) {
+            out.append(text.substr(i));
+            break;
+        }
+        out.append(text.substr(i, amp - i));
+        // Only look as far as the longest entity we could decode, so that a run of stray '&'s stays linear
+        const auto semicolon = text.substr(0, std::min(text.size(), amp + max_entity_length + 2)).find(';', amp + 1);
+        if (semicolon == std::string_view::npos) {
+            out.push_back('&');
+            i = amp + 1;
+            continue;
+        }
+        const auto entity = text.substr(amp + 1, semicolon - amp - 1);
+        bool decoded = true;
+        if (entity.size() > 1 && entity[0] == '#') {
+            const bool hex = entity[1] == 'x' || entity[1] == 'X';
+            const auto digits = entity.substr(hex ? 2 : 1);
+            uint32_t cp = 0;
+            const auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), cp, hex ? 16 : 10);
+            decoded = ec == std::errc() && ptr == digits.data() + digits.size();
+            if (decoded) {
+                AppendCodePoint(out, cp);
+            }
+        }
+        else if (entity == "amp") {
+            out.push_back('&');
+        }
+        else if (entity == "lt") {
+            out.push_back('<');
+        }
+        else if (entity == "gt") {
+            out.push_back('>');
+        }
+        else if (entity == "quot") {
+            out.push_back('"');
+        }
+        else if (entity == "apos") {
+            out.push_back('\'');
+        }
+        else if (entity == "nbsp") {
+            out.push_back(' ');
+        }
+        else {
+            decoded = false;
+        }
+        if (!decoded) {
+            out.append(text.substr(amp, semicolon - amp + 1));
+        }
+        i = semicolon + 1;
+    }
+    return out;
+}
+
+std::string Html::ToText(const std::string_view html)
+{
+    std::string text;
+    Tokenizer tokenizer(html);
+    Token token;
+    while (tokenizer.Next(token)) {
+        if (token.type == Token::Type::Text) {
+            text.append(token.text);
+        }
+    }
+    return std::string(Trim(DecodeEntities(text)));
+}
+
+std::string_view Html::FindElement(const std::string_view html, const std::string_view tag, const size_t offset)
+{
+    return FindElement(html, tag, [](std::string_view) { return true; }, offset);
+}
+
+std::string_view Html::FindSection(const std::string_view html, const std::string_view headline_id, const std::string_view until_tag)
+{
+    Tokenizer tokenizer(html);
+    Token token;
+    bool found = false;
+    while (!found && tokenizer.Next(token)) {
+        found = token.type == Token::Type::StartTag && EqualsIgnoreCase(token.name, "span")
+                && GetAttribute(token.attributes, "id") == headline_id && HasClass(token.attributes, "mw-headline");
+    }
+    if (!found) {
+        return {};
+    }
+    const size_t section_start = token.end;
+    while (tokenizer.Next(token)) {
+        if (token.type == Token::Type::EndTag && EqualsIgnoreCase(token.name, until_tag)) {
+            return html.substr(section_start, token.begin - section_start);
+        }
+    }
+    return {};
+}
+
+std::string_view Html::FindJsonValue(const std::string_view text, const std::string_view key)
+{
+    size_t i = 0;
+    while ((i = text.find(key, i)) != std::string_view::npos) {
+        const size_t key_start = i;
+        i += key.size();
+        if (key_start == 0 || text[key_start - 1] != '"' || i >= text.size() || text[i] != '"') {
+            continue;
+        }
+        auto value_start = text.find_first_not_of(whitespace, i + 1);
+        if (value_start == std::string_view::npos || text[value_start] != ':') {
+            continue;
+        }
+        value_start = text.find_first_not_of(whitespace, value_start + 1);
+        if (value_start == std::string_view::npos) {
+            return {};
+        }
+        if (text[value_start] == '"') {
+            size_t end = value_start + 1;
+            while (end < text.size() && text[end] != '"') {
+                end += text[end] == '\\' ? 2 : 1;
+            }
+            return text.substr(value_start + 1, std::min(end, text.size()) - value_start - 1);
+        }
+        const auto end = text.find_first_of(",}] \t\n\r", value_start);
+        return text.substr(value_start, end == std::string_view::npos ? std::string_view::npos : end - value_start);
+    }
+    return {};
+}
+
+uint32_t Html::GetWikiRevision(const std::string_view html)
+{
+    const auto value = FindJsonValue(html, "wgRevisionId");
+    uint32_t revision = 0;
+    std::from_chars(value.data(), value.data() + value.size(), revision);
+    return revision;
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+// Small streaming tokenizer for the pages we scrape from the Guild Wars Wiki, plus the handful of extractors built on it.
+// Tokens are views into the source html; nothing is copied or allocated while tokenizing, and every extractor runs in
+// linear time, unlike the std::regex patterns it replaces which could backtrack for a very long time on large pages.
+namespace Html {
+    struct Token {
+        enum class Type : uint8_t {
+            Text,
+            StartTag,
+            EndTag,
+            // Also doctype and processing instructions
+            Comment
+        };
+        Type type = Type::Text;
+        // Tag name for StartTag and EndTag, lower case as long as the source is
+        std::string_view name;
+        // Everything between the tag name and the closing > for StartTag
+        std::string_view attributes;
+        // Raw text for Text and Comment
+        std::string_view text;
+        bool self_closing = false;
+        // Offsets of the token in the source
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    class Tokenizer {
+    public:
+        explicit Tokenizer(const std::string_view _html, const size_t offset = 0)
+            : html(_html), pos(offset) { }
+
+        // False once the end of the source is reached
+        bool Next(Token& token);
+        // Skip to the token after the end tag matching open, which must be a StartTag; returns the inner html
+        std::string_view SkipElement(const Token& open);
+
+        [[nodiscard]] size_t Offset() const { return pos; }
+        [[nodiscard]] std::string_view Source() const { return html; }
+
+    private:
+        std::string_view html;
+        size_t pos = 0;
+        // Set after <script> or <style>; their content is text up to the matching end tag
+        std::string_view raw_text_tag;
+    };
+
+    [[nodiscard]] bool EqualsIgnoreCase(std::string_view a, std::string_view b);
+
+    // Raw (still entity encoded) value of the attribute, or empty if it isn't there
+    [[nodiscard]] std::string_view GetAttribute(std::string_view attributes, std::string_view name);
+    // True if class_name is one of the space separated classes of the element
+    [[nodiscard]] bool HasClass(std::string_view attributes, std::string_view class_name);
+
+    // Decode the character references the wiki uses, e.g. &amp; &#39; &#x27;
+    [[nodiscard]] std::string DecodeEntities(std::string_view text);
+    // Text content of an html fragment; tags removed, entities decoded, whitespace trimmed
+    [[nodiscard]] std::string ToText(std::string_view html);
+
+    // Inner html of the first tag element at or after offset for which predicate(attributes) is true; empty if none
+    template <typename Predicate>
+    std::string_view FindElement(std::string_view html, std::string_view tag, Predicate&& predicate, size_t offset = 0);
+    [[nodiscard]] std::string_view FindElement(std::string_view html, std::string_view tag, size_t offset = 0);
+
+    // Html between the mw-headline span with this id, and the next end tag named until_tag e.g. the list after a "Skills" heading
+    [[nodiscard]] std::string_view FindSection(std::string_view html, std::string_view headline_id, std::string_view until_tag);
+
+    // Calls fn(title, href) for every anchor with a title
+    template <typename Fn>
+    void ForEachLink(std::string_view html, Fn&& fn);
+    // Calls fn(cells) for every table row, where cells holds the inner html of its th and td elements in order
+    template <typename Fn>
+    void ForEachTableRow(std::string_view html, Fn&& fn);
+    // Calls fn(th, td) for every row with a header cell followed by a data cell, e.g. infobox rows
+    template <typename Fn>
+    void ForEachInfoboxRow(std::string_view html, Fn&& fn);
+
+    // Value of "key": in embedded json, without quotes; escape sequences are left as they are. Empty if not found.
+    [[nodiscard]] std::string_view FindJsonValue(std::string_view text, std::string_view key);
+    // Revision id embedded in a MediaWiki page (wgRevisionId), or 0
+    [[nodiscard]] uint32_t GetWikiRevision(std::string_view html);
+}
+
+template <typename Predicate>
+std::string_view Html::FindElement(const std::string_view html, const std::string_view tag, Predicate&& predicate, const size_t offset)
+{
+    Tokenizer tokenizer(html, offset);
+    Token token;
+    while (tokenizer.Next(token)) {
+        if (token.type == Token::Type::StartTag && EqualsIgnoreCase(token.name, tag) && predicate(token.attributes)) {
+            return tokenizer.SkipElement(token);
+        }
+    }
+    return {};
+}
+
+template <typename Fn>
+void Html::ForEachLink(const std::string_view html, Fn&& fn)
+{
+    Tokenizer tokenizer(html);
+    Token token;
+    while (tokenizer.Next(token)) {
+        if (token.type != Token::Type::StartTag || !EqualsIgnoreCase(token.name, "a")) {
+            continue;
+        }
+        const auto title = GetAttribute(token.attributes, "title");
+        if (!title.empty()) {
+            fn(title, GetAttribute(token.attributes, "href"));
+        }
+    }
+}
+
+template <typename Fn>
+void Html::ForEachTableRow(const std::string_view html, Fn&& fn)
+{
+    std::vector<std::string_view> cells;
+    Tokenizer tokenizer(html);
+    Token token;
+    while (tokenizer.Next(token)) {
+        if (token.type != Token::Type::StartTag || !EqualsIgnoreCase(token.name, "tr")) {
+            continue;
+        }
+        const auto row = tokenizer.SkipElement(token);
+        cells.clear();
+        Tokenizer row_tokenizer(row);
+        Token cell;
+        while (row_tokenizer.Next(cell)) {
+            if (cell.type == Token::Type::StartTag && (EqualsIgnoreCase(cell.name, "td") || EqualsIgnoreCase(cell.name, "th"))) {
+                cells.push_back(row_tokenizer.SkipElement(cell));
+            }
+        }
+        fn(cells);
+    }
+}
+
+template <typename Fn>
+void Html::ForEachInfoboxRow(const std::string_view html, Fn&& fn)
+{
+    Tokenizer tokenizer(html);
+    Token token;
+    while (tokenizer.Next(token)) {
+        if (token.type != Token::Type::StartTag || !EqualsIgnoreCase(token.name, "tr")) {
+            continue;
+        }
+        const auto row = tokenizer.SkipElement(token);
+        bool found_th = false;
+        std::string_view th;
+        Tokenizer row_tokenizer(row);
+        Token cell;
+        while (row_tokenizer.Next(cell)) {
+            if (cell.type != Token::Type::StartTag) {
+                continue;
+            }
+            if (!found_th && EqualsIgnoreCase(cell.name, "th")) {
+                th = row_tokenizer.SkipElement(cell);
+                found_th = true;
+            }
+            else if (found_th && EqualsIgnoreCase(cell.name, "td")) {
+                fn(th, row_tokenizer.SkipElement(cell));
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+
+// Rows of a scrolling list that are only rebuilt when the owner says something changed, and only drawn while on screen.
+// The owner calls Invalidate() from wherever its data changes (packet callbacks, settings, timers); the next Update()
+// rebuilds the rows, including anything expensive to work out like labels or sort order, and Draw() then walks just the
+// visible range using ImGuiListClipper. Rows must all be the same height.
+// Invalidate() is safe from any thread; Update(), Draw() and Clear() belong to the thread drawing the list. Rows holding
+// pointers into the owner's data must not outlive it: hold the owner's lock across Update() and Draw(), or only free that
+// data on the drawing thread.
+template <typename Row>
+class ListView {
+public:
+    // Rows are out of date; they're rebuilt on the next Update()
+    void Invalidate() { dirty = true; }
+    [[nodiscard]] bool IsDirty() const { return dirty; }
+
+    // If invalidated, calls build(rows) with an empty vector to fill in display order. Capacity is kept between builds.
+    // The flag is cleared before building, so an Invalidate() that lands during build() rebuilds again next time.
+    template <typename Build>
+    void Update(Build&& build)
+    {
+        if (!dirty.exchange(false)) {
+            return;
+        }
+        rows.clear();
+        build(rows);
+    }
+
+    // Calls draw_row(row) for each row in view. Row height is measured from the first row unless given.
+    template <typename DrawRow>
+    void Draw(DrawRow&& draw_row, const float row_height = -1.f)
+    {
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(rows.size()), row_height);
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                draw_row(rows[static_cast<size_t>(i)]);
+            }
+        }
+        clipper.End();
+    }
+
+    void Clear()
+    {
+        rows.clear();
+        dirty = true;
+    }
+
+    [[nodiscard]] size_t size() const { return rows.size(); }
+    [[nodiscard]] bool empty() const { return rows.empty(); }
+    [[nodiscard]] const std::vector<Row>& Rows() const { return rows; }
+
+private:
+    std::vector<Row> rows;
+    std::atomic_bool dirty = true;
+};
@@ -0,0 +1,156 @@
+#include "stdafx.h"
+
+#include <Utils/StringPool.h>
+
+wchar_t StringPool::FoldCase(const wchar_t c)
+{
+    if (c < 0x80) {
+        return c >= L'A' && c <= L'Z' ? static_cast<wchar_t>(c + (L'a' - L'A')) : c;
+    }
+    return static_cast<wchar_t>(towlower(c));
+}
+
+uint32_t StringPool::Hash(const std::wstring_view str)
+{
+    // FNV-1a over the case folded code units; the same for both kinds of pool, only equality differs
+    uint32_t hash = 2166136261u;
+    for (const wchar_t c : str) {
+        hash ^= static_cast<uint16_t>(FoldCase(c));
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool StringPool::Equals(const std::wstring_view a, const std::wstring_view b) const
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    if (!ignore_case) {
+        return a == b;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i] != b[i] && FoldCase(a[i]) != FoldCase(b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t StringPool::FindSlot(const std::wstring_view str, const uint32_t hash) const
+{
+    const size_t mask = slots.size() - 1;
+    size_t i = hash & mask;
+    while (true) {
+        const Handle handle = slots[i];
+        if (handle == InvalidHandle) {
+            return i;
+        }
+        const Entry& entry = entries[handle - 1];
+        if (entry.hash == hash && Equals(std::wstring_view(entry.data, entry.length), str)) {
+            return i;
+        }
+        i = (i + 1) & mask;
+    }
+}
+
+void StringPool::GrowSlots()
+{
+    const size_t new_size = slots.empty() ? 64 : slots.size() * 2;
+    slots.assign(new_size, InvalidHandle);
+    const size_t mask = new_size - 1;
+    for (size_t i = 0; i < entries.size(); i++) {
+        size_t slot = entries[i].hash & mask;
+        while (slots[slot] != InvalidHandle) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = static_cast<Handle>(i + 1);
+    }
+}
+
+const wchar_t* StringPool::Store(const std::wstring_view str)
+{
+    wchar_t* out;
+    if (str.size() > chunk_chars / 4) {
+        // Long strings get an allocation of their own instead of wasting the rest of the current chunk
+        out = large_strings.emplace_back(std::make_unique<wchar_t[]>(str.size())).get();
+        arena_bytes += str.size() * sizeof(wchar_t);
+    }
+    else {
+        if (chunk_used + str.size() > chunk_chars) {
+            chunks.push_back(std::make_unique<wchar_t[]>(chunk_chars));
+            arena_bytes += chunk_chars * sizeof(wchar_t);
+            chunk_used = 0;
+        }
+        out = chunks.back().get() + chunk_used;
+        chunk_used += str.size();
+    }
+    std::copy(str.begin(), str.end(), out);
+    return out;
+}
+
+StringPool::Handle StringPool::Intern(const std::wstring_view str)
+{
+    if (str.empty()) {
+        return InvalidHandle;
+    }
+    const uint32_t hash = Hash(str);
+    std::unique_lock lock(mutex);
+    if ((entries.size() + 1) * 2 > slots.size()) {
+        GrowSlots();
+    }
+    const size_t slot = FindSlot(str, hash);
+    if (slots[slot] != InvalidHandle) {
+        return slots[slot];
+    }
+    entries.push_back({Store(str), static_cast<uint32_t>(str.size()), hash});
+    const auto handle = static_cast<Handle>(entries.size());
+    slots[slot] = handle;
+    return handle;
+}
+
+StringPool::Handle StringPool::Find(const std::wstring_view str) const
+{
+    if (str.empty()) {
+        return InvalidHandle;
+    }
+    const uint32_t hash = Hash(str);
+    std::shared_lock lock(mutex);
+    if (slots.empty()) {
+        return InvalidHandle;
+    }
+    return slots[FindSlot(str, hash)];
+}
+
+std::wstring_view StringPool::Get(const Handle handle) const
+{
+    std::shared_lock lock(mutex);
+    if (handle == InvalidHandle || handle > entries.size()) {
+        return {};
+    }
+    const Entry& entry = entries[handle - 1];
+    return {entry.data, entry.length};
+}
+
+void StringPool::Clear()
+{
+    std::unique_lock lock(mutex);
+    entries.clear();
+    slots.clear();
+    chunks.clear();
+    large_strings.clear();
+    chunk_used = chunk_chars;
+    arena_bytes = 0;
+}
+
+size_t StringPool::Size() const
+{
+    std::shared_lock lock(mutex);
+    return entries.size();
+}
+
+size_t StringPool::ArenaBytes() const
+{
+    std::shared_lock lock(mutex);
+    return arena_bytes;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <shared_mutex>
+
+// Append-only pool of interned wide strings.
+// Each distinct string is stored once in a chunked arena and identified by a small Handle, so that tables keyed by
+// player names can hash and compare integers instead of owning a std::wstring per entry.
+// Find() never allocates, which makes it safe to call for every incoming chat message or party update.
+// Hashes are computed on the case folded string, so a case insensitive pool (e.g. for character names, which the game treats
+// as case insensitive) costs the same to look up as an exact one. A case insensitive pool keeps the spelling first interned.
+// Strings are never removed individually; Clear() drops everything and invalidates all handles.
+class StringPool {
+public:
+    using Handle = uint32_t;
+    static constexpr Handle InvalidHandle = 0;
+
+    explicit StringPool(bool case_insensitive = false)
+        : ignore_case(case_insensitive) { }
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    // Returns the handle for this string, adding it to the pool if it isn't there yet. Empty strings are not interned.
+    Handle Intern(std::wstring_view str);
+    // Returns the handle for this string, or InvalidHandle if it has never been interned
+    [[nodiscard]] Handle Find(std::wstring_view str) const;
+    // View into the arena; stays valid until Clear()
+    [[nodiscard]] std::wstring_view Get(Handle handle) const;
+    // Forget every string. Any handle or view previously returned becomes invalid.
+    void Clear();
+
+    [[nodiscard]] size_t Size() const;
+    // Bytes reserved by the arena, for diagnostics
+    [[nodiscard]] size_t ArenaBytes() const;
+
+private:
+    struct Entry {
+        const wchar_t* data = nullptr;
+        uint32_t length = 0;
+        uint32_t hash = 0;
+    };
+
+    static wchar_t FoldCase(wchar_t c);
+    static uint32_t Hash(std::wstring_view str);
+    [[nodiscard]] bool Equals(std::wstring_view a, std::wstring_view b) const;
+    // Index into slots where str is, or the empty slot where it would go
+    [[nodiscard]] size_t FindSlot(std::wstring_view str, uint32_t hash) const;
+    void GrowSlots();
+    const wchar_t* Store(std::wstring_view str);
+
+    static constexpr size_t chunk_chars = 4096;
+
+    // entries[handle - 1]
+    std::vector<Entry> entries;
+    // Open addressing table of handles, InvalidHandle for empty slots. Size is a power of 2, kept at most half full.
+    std::vector<Handle> slots;
+    std::vector<std::unique_ptr<wchar_t[]>> chunks;
+    std::vector<std::unique_ptr<wchar_t[]>> large_strings;
+    size_t chunk_used = chunk_chars;
+    size_t arena_bytes = 0;
+    const bool ignore_case;
+    mutable std::shared_mutex mutex;
+};
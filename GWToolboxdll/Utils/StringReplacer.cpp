@@ -0,0 +1,135 @@
+#include "stdafx.h"
+
+#include <Utils/StringReplacer.h>
+
+void StringReplacer::Clear()
+{
+    nodes.clear();
+    edges.clear();
+}
+
+void StringReplacer::Build(const StringPool& pool, const std::unordered_map<StringPool::Handle, StringPool::Handle>& replacements)
+{
+    Clear();
+    nodes.emplace_back();
+
+    // Plain trie first, with the children of each node kept apart until we know how many there are
+    std::vector<std::vector<Edge>> children(1);
+    for (const auto& [from_handle, to_handle] : replacements) {
+        const auto from = pool.Get(from_handle);
+        if (from.empty()) {
+            continue;
+        }
+        uint32_t node = 0;
+        for (const wchar_t c : from) {
+            const auto& node_children = children[node];
+            const auto found = std::ranges::find(node_children, c, &Edge::c);
+            if (found != node_children.end()) {
+                node = found->node;
+                continue;
+            }
+            const auto child = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();
+            nodes.back().depth = nodes[node].depth + 1;
+            children.emplace_back();
+            children[node].push_back({c, child});
+            node = child;
+        }
+        nodes[node].terminal = true;
+        nodes[node].replacement = pool.Get(to_handle);
+    }
+
+    for (size_t i = 0; i < nodes.size(); i++) {
+        auto& node_children = children[i];
+        std::ranges::sort(node_children, {}, &Edge::c);
+        nodes[i].first_edge = static_cast<uint32_t>(edges.size());
+        nodes[i].edge_count = static_cast<uint32_t>(node_children.size());
+        edges.insert(edges.end(), node_children.begin(), node_children.end());
+    }
+
+    // Breadth first so that the fail node of each node is done before it
+    std::vector<uint32_t> queue;
+    queue.reserve(nodes.size());
+    queue.push_back(0);
+    for (size_t q = 0; q < queue.size(); q++) {
+        const uint32_t parent = queue[q];
+        const auto& parent_node = nodes[parent];
+        for (uint32_t e = parent_node.first_edge; e < parent_node.first_edge + parent_node.edge_count; e++) {
+            const auto [c, child] = edges[e];
+            uint32_t fail = 0;
+            if (parent != 0) {
+                fail = Next(nodes[parent].fail, c);
+            }
+            auto& child_node = nodes[child];
+            child_node.fail = fail;
+            child_node.output = child_node.terminal ? child : nodes[fail].output;
+            queue.push_back(child);
+        }
+    }
+}
+
+uint32_t StringReplacer::Child(const uint32_t node, const wchar_t c) const
+{
+    const auto& n = nodes[node];
+    const auto begin = edges.begin() + n.first_edge;
+    const auto end = begin + n.edge_count;
+    const auto found = std::lower_bound(begin, end, c, [](const Edge& edge, const wchar_t value) {
+        return edge.c < value;
+    });
+    return found != end && found->c == c ? found->node : 0;
+}
+
+uint32_t StringReplacer::Next(uint32_t node, const wchar_t c) const
+{
+    while (true) {
+        if (const auto child = Child(node, c)) {
+            return child;
+        }
+        if (node == 0) {
+            return 0;
+        }
+        node = nodes[node].fail;
+    }
+}
+
+bool StringReplacer::Replace(const std::wstring_view input, std::wstring& out)
+{
+    out.clear();
+    if (Empty()) {
+        out.append(input);
+        return false;
+    }
+
+    // Find the longest match starting at each position...
+    match_node.assign(input.size(), 0);
+    bool found_any = false;
+    uint32_t state = 0;
+    for (size_t i = 0; i < input.size(); i++) {
+        state = Next(state, input[i]);
+        for (uint32_t o = nodes[state].output; o; o = nodes[nodes[o].fail].output) {
+            const size_t start = i + 1 - nodes[o].depth;
+            if (!match_node[start] || nodes[match_node[start]].depth < nodes[o].depth) {
+                match_node[start] = o;
+            }
+            found_any = true;
+        }
+    }
+    if (!found_any) {
+        out.append(input);
+        return false;
+    }
+
+    // ...then take them left to right, skipping any that overlap one already taken
+    out.reserve(input.size());
+    size_t i = 0;
+    while (i < input.size()) {
+        if (const auto o = match_node[i]) {
+            out.append(nodes[o].replacement);
+            i += nodes[o].depth;
+            continue;
+        }
+        out.push_back(input[i]);
+        i++;
+    }
+    return true;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Utils/StringPool.h>
+
+// Replaces every occurrence of a set of strings in a single pass over the input (Aho-Corasick).
+// Where matches overlap, the leftmost one wins, and of those the longest; replaced text is never searched again.
+// The automaton is stored in flat arrays, and Replace() only allocates when the output buffer needs to grow.
+class StringReplacer {
+public:
+    // Rebuild the automaton from (from, to) pairs of handles into pool. Empty strings are ignored.
+    // The pool must outlive this replacer, or be followed by another Build()
+    void Build(const StringPool& pool, const std::unordered_map<StringPool::Handle, StringPool::Handle>& replacements);
+    void Clear();
+
+    // Writes input with replacements applied to out, which is cleared first. Returns true if anything was replaced.
+    // out must not refer to the same memory as input.
+    bool Replace(std::wstring_view input, std::wstring& out);
+
+    [[nodiscard]] bool Empty() const { return nodes.size() <= 1; }
+
+private:
+    struct Edge {
+        wchar_t c = 0;
+        uint32_t node = 0;
+    };
+    struct Node {
+        uint32_t first_edge = 0;
+        uint32_t edge_count = 0;
+        // Longest proper suffix of this node that is also in the trie
+        uint32_t fail = 0;
+        // Nearest node, this one included, along the fail chain that ends a string; 0 if none
+        uint32_t output = 0;
+        uint32_t depth = 0;
+        // What to replace this node's string with, if it ends one
+        std::wstring_view replacement;
+        bool terminal = false;
+    };
+
+    [[nodiscard]] uint32_t Child(uint32_t node, wchar_t c) const;
+    [[nodiscard]] uint32_t Next(uint32_t node, wchar_t c) const;
+
+    // nodes[0] is the root
+    std::vector<Node> nodes;
+    // Edges of each node are contiguous and sorted by character
+    std::vector<Edge> edges;
+    // Node of the longest match starting at each input position, 0 if none; reused between calls
+    std::vector<uint32_t> match_node;
+};
@@ -0,0 +1,432 @@
+#include "stdafx.h"
+
+#include <Utils/TextureAtlas.h>
+
+AtlasPacker::AtlasPacker(const uint32_t _width, const uint32_t _height, const uint32_t _padding, const uint32_t _alignment)
+    : width(_width), height(_height), padding(_padding), alignment(_alignment ? _alignment : 1) { }
+
+uint32_t AtlasPacker::Align(const uint32_t value) const
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+bool AtlasPacker::Allocate(const uint32_t w, const uint32_t h, Rect* out)
+{
+    const uint32_t padded_w = Align(w + padding * 2);
+    const uint32_t padded_h = Align(h + padding * 2);
+    if (!w || !h || padded_w > width || padded_h > height) {
+        return false;
+    }
+
+    // Best fit shelf; don't put a small icon onto a much taller shelf, it wastes the space above it.
+    Shelf* best_shelf = nullptr;
+    Span* best_span = nullptr;
+    for (auto& shelf : shelves) {
+        if (shelf.h < padded_h || shelf.h > padded_h + padded_h / 2) {
+            continue;
+        }
+        if (best_shelf && best_shelf->h <= shelf.h) {
+            continue;
+        }
+        Span* span = nullptr;
+        for (auto& it : shelf.free_spans) {
+            if (it.w >= padded_w && (!span || it.w < span->w)) {
+                span = &it;
+            }
+        }
+        if (!span && shelf.cursor_x + padded_w > width) {
+            continue;
+        }
+        best_shelf = &shelf;
+        best_span = span;
+    }
+
+    if (!best_shelf) {
+        if (shelf_cursor_y + padded_h > height) {
+            return false;
+        }
+        best_shelf = &shelves.emplace_back(shelf_cursor_y, padded_h);
+        shelf_cursor_y += padded_h;
+    }
+
+    uint32_t x;
+    if (best_span) {
+        x = best_span->x;
+        best_span->x += padded_w;
+        best_span->w -= padded_w;
+        if (!best_span->w) {
+            std::erase_if(best_shelf->free_spans, [](const Span& span) {
+                return span.w == 0;
+            });
+        }
+    }
+    else {
+        x = best_shelf->cursor_x;
+        best_shelf->cursor_x += padded_w;
+    }
+    used_area += static_cast<uint64_t>(padded_w) * padded_h;
+    *out = {x + padding, best_shelf->y + padding, w, h};
+    return true;
+}
+
+void AtlasPacker::Free(const Rect& rect)
+{
+    const uint32_t x = rect.x - padding;
+    const uint32_t y = rect.y - padding;
+    const uint32_t padded_w = Align(rect.w + padding * 2);
+    const uint32_t padded_h = Align(rect.h + padding * 2);
+    const auto shelf = std::ranges::find_if(shelves, [y](const Shelf& s) {
+        return s.y == y;
+    });
+    if (shelf == shelves.end()) {
+        return;
+    }
+    used_area -= static_cast<uint64_t>(padded_w) * padded_h;
+
+    auto& spans = shelf->free_spans;
+    spans.push_back({x, padded_w});
+    std::ranges::sort(spans, [](const Span& a, const Span& b) {
+        return a.x < b.x;
+    });
+    // Merge neighbouring spans
+    size_t out = 0;
+    for (size_t i = 1; i < spans.size(); i++) {
+        if (spans[out].x + spans[out].w == spans[i].x) {
+            spans[out].w += spans[i].w;
+        }
+        else {
+            spans[++out] = spans[i];
+        }
+    }
+    spans.resize(out + 1);
+    // Give the tail of the shelf back to the cursor
+    if (spans.back().x + spans.back().w == shelf->cursor_x) {
+        shelf->cursor_x = spans.back().x;
+        spans.pop_back();
+    }
+}
+
+void AtlasPacker::Clear()
+{
+    shelves.clear();
+    shelf_cursor_y = 0;
+    used_area = 0;
+}
+
+float AtlasPacker::Occupancy() const
+{
+    return static_cast<float>(static_cast<double>(used_area) / (static_cast<double>(width) * height));
+}
+
+namespace {
+    constexpr uint32_t page_size = 1024;
+    // Anything bigger than this isn't really an icon; leave it as its own texture
+    constexpr uint32_t max_icon_size = 128;
+    constexpr size_t max_pages = 4;
+    // Copying into the atlas locks textures; spread the work over a few frames when lots of icons appear at once
+    constexpr size_t max_packs_per_frame = 8;
+    // Icons that haven't been drawn for this many frames are released from the atlas (about 5 minutes at 60fps)
+    constexpr uint32_t evict_after_frames = 60 * 60 * 5;
+    constexpr uint32_t sweep_interval_frames = 600;
+
+    struct Page {
+        IDirect3DTexture9* texture = nullptr;
+        AtlasPacker packer{page_size, page_size};
+    };
+
+    struct Entry {
+        // NB: We hold a reference to the source texture while it's packed, so the address can't be reused by another texture.
+        // The source is owned by whatever cache handed it out (usually Resources), which keeps it alive regardless; dropping our
+        // reference early wouldn't free anything, but would let a new texture at the same address pick up this icon. Owners that
+        // release a source call TextureAtlas::Forget() first, and the pages themselves are capped at max_pages.
+        IDirect3DTexture9* source = nullptr;
+        size_t page = 0;
+        AtlasPacker::Rect rect;
+        uint32_t last_used_frame = 0;
+    };
+
+    std::vector<Page> pages;
+    std::unordered_map<IDirect3DTexture9*, Entry> entries;
+    // Textures that can't be packed, with the frame they were last asked for. Referenced for the same reason as Entry::source.
+    std::unordered_map<IDirect3DTexture9*, uint32_t> unpackable;
+
+    TextureAtlas::UseCallback use_callback = nullptr;
+
+    uint32_t current_frame = 0;
+    size_t packed_this_frame = 0;
+    size_t evictions = 0;
+
+    bool IsPackable(const D3DSURFACE_DESC& desc)
+    {
+        if (desc.Width > max_icon_size || desc.Height > max_icon_size) {
+            return false;
+        }
+        if (desc.Format != D3DFMT_A8R8G8B8 && desc.Format != D3DFMT_X8R8G8B8) {
+            return false;
+        }
+        // Default pool textures can't be locked
+        return desc.Pool == D3DPOOL_MANAGED || desc.Pool == D3DPOOL_SYSTEMMEM;
+    }
+
+    void MarkUnpackable(IDirect3DTexture9* source)
+    {
+        if (unpackable.emplace(source, current_frame).second) {
+            source->AddRef();
+        }
+    }
+
+    void Evict(const std::unordered_map<IDirect3DTexture9*, Entry>::iterator& it)
+    {
+        pages[it->second.page].packer.Free(it->second.rect);
+        it->second.source->Release();
+        entries.erase(it);
+        evictions++;
+    }
+
+    // Evict the least recently drawn icon that isn't on screen this frame. False if there's nothing to evict.
+    bool EvictLeastRecentlyUsed()
+    {
+        auto oldest = entries.end();
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->second.last_used_frame == current_frame) {
+                continue;
+            }
+            if (oldest == entries.end() || it->second.last_used_frame < oldest->second.last_used_frame) {
+                oldest = it;
+            }
+        }
+        if (oldest == entries.end()) {
+            return false;
+        }
+        Evict(oldest);
+        return true;
+    }
+
+    bool CreatePage(IDirect3DTexture9* source)
+    {
+        IDirect3DDevice9* device = nullptr;
+        if (source->GetDevice(&device) != D3D_OK || !device) {
+            return false;
+        }
+        IDirect3DTexture9* texture = nullptr;
+        const HRESULT res = device->CreateTexture(page_size, page_size, 1, 0, D3DFMT_A8R8G8B8, D3DPOOL_MANAGED, &texture, nullptr);
+        device->Release();
+        if (res != D3D_OK) {
+            Log::Log("TextureAtlas: Failed to create atlas page, error %#08x", res);
+            return false;
+        }
+        pages.push_back({texture});
+        return true;
+    }
+
+    // Find room for a w x h icon, adding pages or evicting old icons as needed.
+    bool Allocate(IDirect3DTexture9* source, const uint32_t w, const uint32_t h, size_t* page_out, AtlasPacker::Rect* rect_out)
+    {
+        while (true) {
+            for (size_t i = 0; i < pages.size(); i++) {
+                if (pages[i].packer.Allocate(w, h, rect_out)) {
+                    *page_out = i;
+                    return true;
+                }
+            }
+            if (pages.size() < max_pages) {
+                if (!CreatePage(source)) {
+                    return false;
+                }
+                continue;
+            }
+            if (!EvictLeastRecentlyUsed()) {
+                return false;
+            }
+        }
+    }
+
+    // Copy level 0 of the source texture into the page, extruding the outermost pixels into the padding so that bilinear filtering never samples a neighbouring icon.
+    bool CopyToPage(IDirect3DTexture9* source, const D3DSURFACE_DESC& desc, const Page& page, const AtlasPacker::Rect& rect)
+    {
+        const auto pad = static_cast<int>(page.packer.Padding());
+        const auto w = static_cast<int>(rect.w);
+        const auto h = static_cast<int>(rect.h);
+        D3DLOCKED_RECT src;
+        if (source->LockRect(0, &src, nullptr, D3DLOCK_READONLY) != D3D_OK) {
+            return false;
+        }
+        RECT dst_area;
+        dst_area.left = static_cast<LONG>(rect.x) - pad;
+        dst_area.top = static_cast<LONG>(rect.y) - pad;
+        dst_area.right = static_cast<LONG>(rect.x + rect.w) + pad;
+        dst_area.bottom = static_cast<LONG>(rect.y + rect.h) + pad;
+        D3DLOCKED_RECT dst;
+        if (page.texture->LockRect(0, &dst, &dst_area, 0) != D3D_OK) {
+            source->UnlockRect(0);
+            return false;
+        }
+        const uint32_t alpha_mask = desc.Format == D3DFMT_X8R8G8B8 ? 0xff000000 : 0;
+        for (int y = 0; y < h + pad * 2; y++) {
+            const int src_y = std::clamp(y - pad, 0, h - 1);
+            const auto src_row = reinterpret_cast<const uint32_t*>(static_cast<const uint8_t*>(src.pBits) + src_y * src.Pitch);
+            const auto dst_row = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(dst.pBits) + y * dst.Pitch);
+            for (int x = 0; x < w + pad * 2; x++) {
+                dst_row[x] = src_row[std::clamp(x - pad, 0, w - 1)] | alpha_mask;
+            }
+        }
+        page.texture->UnlockRect(0);
+        source->UnlockRect(0);
+        return true;
+    }
+
+    TextureAtlas::Region ToRegion(const Entry& entry)
+    {
+        const auto inv_size = 1.f / static_cast<float>(page_size);
+        TextureAtlas::Region region;
+        region.texture = pages[entry.page].texture;
+        region.uv0 = {static_cast<float>(entry.rect.x) * inv_size, static_cast<float>(entry.rect.y) * inv_size};
+        region.uv1 = {static_cast<float>(entry.rect.x + entry.rect.w) * inv_size, static_cast<float>(entry.rect.y + entry.rect.h) * inv_size};
+        region.size = {static_cast<float>(entry.rect.w), static_cast<float>(entry.rect.h)};
+        return region;
+    }
+}
+
+TextureAtlas::Region TextureAtlas::Get(IDirect3DTexture9* source)
+{
+    Region region;
+    region.texture = source;
+    if (!source) {
+        return region;
+    }
+    if (use_callback) {
+        use_callback(source);
+    }
+    const auto found = entries.find(source);
+    if (found != entries.end()) {
+        found->second.last_used_frame = current_frame;
+        return ToRegion(found->second);
+    }
+    D3DSURFACE_DESC desc;
+    if (source->GetLevelDesc(0, &desc) != D3D_OK) {
+        return region;
+    }
+    region.size = {static_cast<float>(desc.Width), static_cast<float>(desc.Height)};
+    if (const auto found_unpackable = unpackable.find(source); found_unpackable != unpackable.end()) {
+        found_unpackable->second = current_frame;
+        return region;
+    }
+    if (packed_this_frame >= max_packs_per_frame) {
+        return region;
+    }
+    if (!IsPackable(desc)) {
+        MarkUnpackable(source);
+        return region;
+    }
+    packed_this_frame++;
+
+    Entry entry;
+    if (!Allocate(source, desc.Width, desc.Height, &entry.page, &entry.rect)) {
+        return region;
+    }
+    if (!CopyToPage(source, desc, pages[entry.page], entry.rect)) {
+        pages[entry.page].packer.Free(entry.rect);
+        MarkUnpackable(source);
+        return region;
+    }
+    source->AddRef();
+    entry.source = source;
+    entry.last_used_frame = current_frame;
+    entries[source] = entry;
+    return ToRegion(entry);
+}
+
+TextureAtlas::Region TextureAtlas::GetCropped(IDirect3DTexture9* source, const ImVec2& size)
+{
+    auto region = Get(source);
+    if (region.size.x <= 0.f || region.size.y <= 0.f || size.y <= 0.f) {
+        return region;
+    }
+    // Same crop as ImGui::CalculateUvCrop, but relative to the region within the page
+    ImVec2 crop = {1.f, 1.f};
+    const float ratio = size.x / size.y;
+    const float image_ratio = region.size.x / region.size.y;
+    if (image_ratio < ratio) {
+        crop.y = ratio * image_ratio;
+    }
+    else if (image_ratio > ratio) {
+        crop.x = ratio / image_ratio;
+    }
+    region.uv1 = {region.uv0.x + (region.uv1.x - region.uv0.x) * crop.x, region.uv0.y + (region.uv1.y - region.uv0.y) * crop.y};
+    return region;
+}
+
+void TextureAtlas::NewFrame()
+{
+    current_frame++;
+    packed_this_frame = 0;
+    if (current_frame % sweep_interval_frames) {
+        return;
+    }
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (current_frame - it->second.last_used_frame > evict_after_frames) {
+            const auto to_evict = it++;
+            Evict(to_evict);
+        }
+        else {
+            ++it;
+        }
+    }
+    for (auto it = unpackable.begin(); it != unpackable.end();) {
+        if (current_frame - it->second > evict_after_frames) {
+            it->first->Release();
+            it = unpackable.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void TextureAtlas::Forget(IDirect3DTexture9* source)
+{
+    if (const auto found = entries.find(source); found != entries.end()) {
+        Evict(found);
+    }
+    if (const auto found = unpackable.find(source); found != unpackable.end()) {
+        found->first->Release();
+        unpackable.erase(found);
+    }
+}
+
+void TextureAtlas::SetUseCallback(const UseCallback callback)
+{
+    use_callback = callback;
+}
+
+void TextureAtlas::Clear()
+{
+    for (const auto& entry : entries | std::views::values) {
+        entry.source->Release();
+    }
+    entries.clear();
+    for (const auto texture : unpackable | std::views::keys) {
+        texture->Release();
+    }
+    unpackable.clear();
+    for (const auto& page : pages) {
+        page.texture->Release();
+    }
+    pages.clear();
+}
+
+TextureAtlas::Stats TextureAtlas::GetStats()
+{
+    Stats stats;
+    stats.pages = pages.size();
+    stats.entries = entries.size();
+    stats.unpackable = unpackable.size();
+    stats.evictions = evictions;
+    for (const auto& page : pages) {
+        stats.occupancy += page.packer.Occupancy();
+    }
+    if (!pages.empty()) {
+        stats.occupancy /= static_cast<float>(pages.size());
+    }
+    return stats;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+// Shelf packer used to place icons into a fixed size atlas page.
+// Has no dependency on DirectX so that the allocation logic can be reasoned about (and exercised) in isolation.
+class AtlasPacker {
+public:
+    struct Rect {
+        uint32_t x = 0;
+        uint32_t y = 0;
+        uint32_t w = 0;
+        uint32_t h = 0;
+    };
+
+    // padding is the gutter kept around each allocation, alignment is the granularity that allocations are rounded up to.
+    // Keeping allocations aligned to a power of 2 means that a downsampled mip level of the page never blends two neighbouring icons.
+    AtlasPacker(uint32_t width, uint32_t height, uint32_t padding = 1, uint32_t alignment = 4);
+
+    // Reserve space for a w x h image. Returned rect is the usable area, excluding padding. False if there is no room left.
+    bool Allocate(uint32_t w, uint32_t h, Rect* out);
+    // Release a rect previously returned by Allocate() so that its slot can be reused.
+    void Free(const Rect& rect);
+    // Forget all allocations.
+    void Clear();
+
+    [[nodiscard]] uint32_t Width() const { return width; }
+    [[nodiscard]] uint32_t Height() const { return height; }
+    [[nodiscard]] uint32_t Padding() const { return padding; }
+    // Fraction of the page currently allocated, 0.f to 1.f
+    [[nodiscard]] float Occupancy() const;
+
+private:
+    struct Span {
+        uint32_t x = 0;
+        uint32_t w = 0;
+    };
+    struct Shelf {
+        uint32_t y = 0;
+        uint32_t h = 0;
+        uint32_t cursor_x = 0;
+        std::vector<Span> free_spans;
+    };
+
+    [[nodiscard]] uint32_t Align(uint32_t value) const;
+
+    uint32_t width;
+    uint32_t height;
+    uint32_t padding;
+    uint32_t alignment;
+    uint32_t shelf_cursor_y = 0;
+    uint64_t used_area = 0;
+    std::vector<Shelf> shelves;
+};
+
+// Shared atlas for small icon textures (skills, items, professions).
+// Icons are copied into a handful of large pages on first draw, so ImGui can batch consecutive icons into a single draw call instead of switching texture per icon.
+// Must only be used from the render thread.
+namespace TextureAtlas {
+    struct Region {
+        ImTextureID texture = nullptr;
+        ImVec2 uv0 = {0.f, 0.f};
+        ImVec2 uv1 = {1.f, 1.f};
+        // Dimensions of the source image in px
+        ImVec2 size = {0.f, 0.f};
+    };
+
+    // Returns the atlas region for the given texture, packing it on demand.
+    // Until the texture has been packed (or if it can't be, e.g. compressed or too large), the source texture is returned with full uvs.
+    Region Get(IDirect3DTexture9* source);
+
+    // Same as Get(), but with uv1 adjusted to crop the image to the aspect ratio of the given size; see ImGui::CalculateUvCrop
+    Region GetCropped(IDirect3DTexture9* source, const ImVec2& size);
+
+    // Called once per frame from the render loop; handles eviction of icons that haven't been drawn for a while
+    void NewFrame();
+
+    // Drop the atlas' reference to source, and its packed copy if any. Call before releasing a texture that may have been drawn through the atlas.
+    void Forget(IDirect3DTexture9* source);
+
+    // Called with the source texture every time Get() is asked for it. Icons drawn from a page never show up as their own
+    // texture in ImGui's draw data, so owners that track usage of their textures (Resources) need to hear about it here.
+    using UseCallback = void (*)(IDirect3DTexture9* source);
+    void SetUseCallback(UseCallback callback);
+
+    // Release all atlas pages and references to source textures
+    void Clear();
+
+    struct Stats {
+        size_t pages = 0;
+        size_t entries = 0;
+        size_t unpackable = 0;
+        size_t evictions = 0;
+        float occupancy = 0.f;
+    };
+    Stats GetStats();
+}
@@ -0,0 +1,203 @@
+#include "stdafx.h"
+
+#include <atomic>
+
+#include <Modules/Resources.h>
+#include <Utils/WikiCache.h>
+
+namespace {
+    constexpr int cache_version = 1;
+    // Changes are written out in batches at most this often, rather than on every Set
+    constexpr auto save_interval = std::chrono::seconds(30);
+    // Entries nobody has refreshed for this long are dropped when the cache is written, so the files don't grow forever
+    constexpr auto max_entry_age = std::chrono::days(90);
+
+    struct Cache {
+        nlohmann::json pages = nlohmann::json::object();
+        bool loaded = false;
+        bool load_queued = false;
+        bool dirty = false;
+    };
+
+    std::mutex cache_mutex;
+    std::map<std::string, Cache, std::less<>> caches;
+    std::chrono::steady_clock::time_point next_save;
+    bool save_requested = false;
+    std::atomic_bool save_queued = false;
+
+    std::filesystem::path GetCacheFile(const std::string_view cache_name)
+    {
+        return Resources::GetPath(L"wiki_cache") / (std::string(cache_name) + ".json");
+    }
+
+    // Missing, corrupt or from an older format all give an empty object; start over
+    nlohmann::json ReadCacheFile(const std::string_view cache_name)
+    {
+        std::ifstream file(GetCacheFile(cache_name));
+        if (!file.is_open()) {
+            return nlohmann::json::object();
+        }
+        auto contents = nlohmann::json::parse(file, nullptr, false);
+        if (!contents.is_object() || contents.value("version", 0) != cache_version || !contents.contains("pages") || !contents["pages"].is_object()) {
+            return nlohmann::json::object();
+        }
+        return std::move(contents["pages"]);
+    }
+
+    // Call with cache_mutex held. Loads the cache from disk if it isn't already, so only call this off the render and game threads.
+    Cache& GetCache(const std::string_view cache_name)
+    {
+        auto found = caches.find(cache_name);
+        if (found == caches.end()) {
+            found = caches.emplace(std::string(cache_name), Cache{}).first;
+        }
+        auto& cache = found->second;
+        if (!cache.loaded) {
+            cache.pages = ReadCacheFile(cache_name);
+            cache.loaded = true;
+        }
+        return cache;
+    }
+
+    time_t Now()
+    {
+        return std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    }
+
+    // Writes every cache with unsaved changes; the files are written without holding cache_mutex
+    void SaveDirty()
+    {
+        std::vector<std::pair<std::filesystem::path, std::string>> files;
+        {
+            std::lock_guard lock(cache_mutex);
+            const auto oldest = Now() - std::chrono::duration_cast<std::chrono::seconds>(max_entry_age).count();
+            for (auto& [cache_name, cache] : caches) {
+                if (!cache.dirty) {
+                    continue;
+                }
+                cache.dirty = false;
+                for (auto it = cache.pages.begin(); it != cache.pages.end();) {
+                    if (!it->is_object() || it->value("saved_at", static_cast<time_t>(0)) < oldest) {
+                        it = cache.pages.erase(it);
+                    }
+                    else {
+                        ++it;
+                    }
+                }
+                files.emplace_back(GetCacheFile(cache_name), nlohmann::json{{"version", cache_version}, {"pages", cache.pages}}.dump());
+            }
+        }
+        for (const auto& [path, contents] : files) {
+            if (!Resources::EnsureFolderExists(path.parent_path())) {
+                continue;
+            }
+            std::ofstream file(path, std::ios::trunc);
+            if (!file.is_open()) {
+                Log::Log("Failed to write wiki cache %s", path.string().c_str());
+                continue;
+            }
+            file << contents;
+        }
+    }
+}
+
+bool WikiCache::IsLoaded(const std::string_view cache_name)
+{
+    std::lock_guard lock(cache_mutex);
+    auto found = caches.find(cache_name);
+    if (found == caches.end()) {
+        found = caches.emplace(std::string(cache_name), Cache{}).first;
+    }
+    auto& cache = found->second;
+    if (cache.loaded) {
+        return true;
+    }
+    if (!cache.load_queued) {
+        cache.load_queued = true;
+        Resources::EnqueueWorkerTask([name = found->first] {
+            auto pages = ReadCacheFile(name);
+            std::lock_guard worker_lock(cache_mutex);
+            auto& loaded = caches[name];
+            if (!loaded.loaded) {
+                loaded.pages = std::move(pages);
+                loaded.loaded = true;
+            }
+        });
+    }
+    return false;
+}
+
+bool WikiCache::Get(const std::string_view cache_name, const std::string& page, nlohmann::json& result, const std::chrono::seconds max_age)
+{
+    std::lock_guard lock(cache_mutex);
+    const auto& pages = GetCache(cache_name).pages;
+    const auto found = pages.find(page);
+    if (found == pages.end() || !found->is_object()) {
+        return false;
+    }
+    const auto saved_at = found->value("saved_at", static_cast<time_t>(0));
+    if (Now() - saved_at > max_age.count() || !found->contains("result")) {
+        return false;
+    }
+    result = (*found)["result"];
+    return true;
+}
+
+bool WikiCache::GetForRevision(const std::string_view cache_name, const std::string& page, const uint32_t revision, nlohmann::json& result)
+{
+    if (!revision) {
+        return false;
+    }
+    std::lock_guard lock(cache_mutex);
+    auto& cache = GetCache(cache_name);
+    const auto found = cache.pages.find(page);
+    if (found == cache.pages.end() || !found->is_object() || found->value("revision", 0u) != revision || !found->contains("result")) {
+        return false;
+    }
+    result = (*found)["result"];
+    (*found)["saved_at"] = Now();
+    cache.dirty = true;
+    return true;
+}
+
+void WikiCache::Set(const std::string_view cache_name, const std::string& page, const uint32_t revision, const nlohmann::json& result)
+{
+    std::lock_guard lock(cache_mutex);
+    auto& cache = GetCache(cache_name);
+    cache.pages[page] = {{"revision", revision}, {"saved_at", Now()}, {"result", result}};
+    cache.dirty = true;
+}
+
+void WikiCache::Update()
+{
+    const auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard lock(cache_mutex);
+        if (!save_requested && now < next_save) {
+            return;
+        }
+        save_requested = false;
+        next_save = now + save_interval;
+        if (!std::ranges::any_of(caches | std::views::values, &Cache::dirty)) {
+            return;
+        }
+    }
+    // One save in flight at a time; anything changed meanwhile goes out with the next one
+    if (!save_queued.exchange(true)) {
+        Resources::EnqueueWorkerTask([] {
+            SaveDirty();
+            save_queued = false;
+        });
+    }
+}
+
+void WikiCache::RequestSave()
+{
+    std::lock_guard lock(cache_mutex);
+    save_requested = true;
+}
+
+void WikiCache::Save()
+{
+    SaveDirty();
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+// Results extracted from Guild Wars Wiki pages (or other scraped pages, e.g. Hall of Monuments), kept on disk as json so that
+// later lookups can skip both the download and the parse.
+// Each cache is a file under the wiki_cache folder, with one entry per page remembering the page revision it came from.
+// Safe to call from any thread, but a cache is read from disk on first use: callers on the render or game thread check IsLoaded()
+// first. Changes are kept in memory and written out in batches by Update() on a worker, and by Save() on shutdown.
+// Entries not refreshed for 90 days are dropped when the file is written.
+namespace WikiCache {
+    // True once the cache has been read from disk; the first call queues that on a worker instead of waiting for it
+    bool IsLoaded(std::string_view cache_name);
+    // Result cached for page, if it was saved less than max_age ago
+    bool Get(std::string_view cache_name, const std::string& page, nlohmann::json& result, std::chrono::seconds max_age);
+    // Result cached for page, if it was extracted from this revision of it; the entry counts as fresh again afterwards
+    bool GetForRevision(std::string_view cache_name, const std::string& page, uint32_t revision, nlohmann::json& result);
+    // revision: wgRevisionId of the page the result was extracted from, 0 if unknown
+    void Set(std::string_view cache_name, const std::string& page, uint32_t revision, const nlohmann::json& result);
+
+    // Called from Resources::Update; queues a worker task writing out changed caches every so often
+    void Update();
+    // Have the next Update() write out changed caches without waiting for the usual interval; for when a batch of Sets is done
+    void RequestSave();
+    // Write out changed caches now, on the calling thread
+    void Save();
+}
@@ -15,6 +15,7 @@
 #include <Defines.h>
 #include <Utils/GuiUtils.h>
 #include <Modules/Resources.h>
+#include <Utf8.h>
 #include <Widgets/HealthWidget.h>
 
 constexpr const wchar_t* HEALTH_THRESHOLD_INIFILENAME = L"HealthThreshold.ini";
@@ -254,7 +255,7 @@ void HealthWidget::Draw(IDirect3DDevice9*)
                         GW::Agents::AsyncGetAgentName(target, agent_name_ping);
                         if (!agent_name_ping.empty()) {
                             char buffer[512];
-                            const std::string agent_name_str = GuiUtils::WStringToString(agent_name_ping);
+                            const utf8::Buffer agent_name_str(agent_name_ping);
                             const auto current_hp = static_cast<int>(target->hp * target->max_hp);
                             snprintf(buffer, sizeof(buffer), "%s's Health is %d of %d. (%.0f %%)", agent_name_str.c_str(), current_hp, target->max_hp, target->hp * 100.f);
                             GW::Chat::SendChat('#', buffer);
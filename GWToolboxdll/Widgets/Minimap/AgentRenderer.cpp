@@ -18,6 +18,7 @@
 #include <GWCA/Managers/StoCMgr.h>
 
 #include <Defines.h>
+#include <Utils/AgentSnapshot.h>
 #include <Utils/GuiUtils.h>
 
 #include <Modules/Resources.h>
@@ -609,20 +610,15 @@ void AgentRenderer::Shape_t::AddVertex(const float x, const float y, const Color
     vertices.push_back(Shape_Vertex(x, y, mod));
 }
 
-void AgentRenderer::Initialize(IDirect3DDevice9* device)
+void AgentRenderer::Initialize(IDirect3DDevice9*)
 {
     if (initialized) {
         return;
     }
     initialized = true;
     type = D3DPT_TRIANGLELIST;
-    vertices_max = max_shape_verts * 0x200; // support for up to 512 agents, should be enough
-    vertices = nullptr;
-    const HRESULT hr = device->CreateVertexBuffer(sizeof(D3DVertex) * vertices_max, 0,
-                                                  D3DFVF_CUSTOMVERTEX, D3DPOOL_MANAGED, &buffer, nullptr);
-    if (FAILED(hr)) {
-        printf("AgentRenderer initialize error: HRESULT: 0x%lX\n", hr);
-    }
+    // Room for 512 agents up front; grows as needed, the device buffer follows in Upload()
+    vertices.reserve(max_shape_verts * 0x200);
 
     constexpr GW::UI::UIMessage hook_messages[] = {
         GW::UI::UIMessage::kShowAgentNameTag,
@@ -678,12 +674,7 @@ void AgentRenderer::Render(IDirect3DDevice9* device)
         initialized = true;
     }
 
-    const HRESULT res = buffer->Lock(0, sizeof(D3DVertex) * vertices_max, (VOID**)&vertices, D3DLOCK_DISCARD);
-    if (FAILED(res)) {
-        printf("AgentRenderer Lock() HRESULT: 0x%lX\n", res);
-    }
-
-    vertices_count = 0;
+    instances.clear();
 
     if (show_props_on_minimap) {
         const auto& props = GW::GetMapContext()->props->propArray;
@@ -709,26 +700,20 @@ void AgentRenderer::Render(IDirect3DDevice9* device)
     }
 
     // 1. eoes
-    for (GW::Agent* agent_ptr : *agents) {
-        if (!agent_ptr) {
-            continue;
-        }
-        const GW::AgentLiving* agent = agent_ptr->GetAsAgentLiving();
-        if (!agent) {
+    const auto& snapshot = AgentSnapshot::Get();
+    for (size_t i = 0; i < snapshot.Size(); i++) {
+        if (!snapshot.IsAliveLiving(i)) {
             continue;
         }
-        if (agent->GetIsDead()) {
-            continue;
-        }
-        switch (agent->player_number) {
+        switch (snapshot.player_numbers[i]) {
             case GW::Constants::ModelID::EoE:
-                Enqueue(BigCircle, agent, GW::Constants::Range::Spirit, color_eoe);
+                Enqueue(BigCircle, snapshot.agents[i], GW::Constants::Range::Spirit, color_eoe);
                 break;
             case GW::Constants::ModelID::QZ:
-                Enqueue(BigCircle, agent, GW::Constants::Range::Spirit, color_qz);
+                Enqueue(BigCircle, snapshot.agents[i], GW::Constants::Range::Spirit, color_qz);
                 break;
             case GW::Constants::ModelID::Winnowing:
-                Enqueue(BigCircle, agent, GW::Constants::Range::Spirit, color_winnowing);
+                Enqueue(BigCircle, snapshot.agents[i], GW::Constants::Range::Spirit, color_winnowing);
                 break;
             default:
                 break;
@@ -893,12 +878,11 @@ void AgentRenderer::Render(IDirect3DDevice9* device)
         Enqueue(player);
     }
 
-    buffer->Unlock();
+    BuildVertices();
 
-    if (vertices_count != 0) {
+    if (!vertices.empty() && Upload(device, vertices, true)) {
         device->SetStreamSource(0, buffer, 0, sizeof(D3DVertex));
-        device->DrawPrimitive(D3DPT_TRIANGLELIST, 0, vertices_count / 3);
-        vertices_count = 0;
+        device->DrawPrimitive(D3DPT_TRIANGLELIST, 0, vertices.size() / 3);
     }
 }
 
@@ -1247,32 +1231,61 @@ void AgentRenderer::Enqueue(const Shape_e shape, const RenderPosition& pos, cons
     if ((color & IM_COL32_A_MASK) == 0) {
         return;
     }
-    const size_t num_v = shapes[shape].vertices.size();
-    ASSERT(vertices_count < vertices_max - num_v);
+    instances.push_back(shape, pos, size, color, modifier);
+}
 
-    for (size_t i = 0; i < num_v; ++i) {
-        const Shape_Vertex& vert = shapes[shape].vertices[i];
-        const GW::Vec2f calc_pos = Rotate(vert, pos.rotation_cos, pos.rotation_sin) * size + pos.position;
-        switch (vert.modifier) {
-            case Dark:
-                vertices[i].color = Colors::Sub(color, modifier);
-                break;
-            case Light:
-                vertices[i].color = Colors::Add(color, modifier);
-                break;
-            case CircleCenter:
-                vertices[i].color = Colors::Sub(color, IM_COL32(0, 0, 0, 50));
-                break;
-            default:
-                vertices[i].color = color;
-                break;
+void AgentRenderer::BuildVertices()
+{
+    size_t vertex_count = 0;
+    for (const auto shape : instances.shape) {
+        vertex_count += shapes[shape].vertices.size();
+    }
+    vertices.resize(vertex_count);
+
+    D3DVertex* out = vertices.data();
+    for (size_t i = 0; i < instances.size(); ++i) {
+        const Color color = instances.color[i];
+        const Color modifier = instances.modifier[i];
+        // One colour per Color_Modifier, worked out once per agent rather than once per vertex
+        const Color palette[] = {
+            color,
+            Colors::Sub(color, modifier),
+            Colors::Add(color, modifier),
+            Colors::Sub(color, IM_COL32(0, 0, 0, 50))
+        };
+        const float size = instances.scale[i];
+        const float rotation_cos = instances.rotation_cos[i] * size;
+        const float rotation_sin = instances.rotation_sin[i] * size;
+        const GW::Vec2f position = {instances.x[i], instances.y[i]};
+        for (const Shape_Vertex& vert : shapes[instances.shape[i]].vertices) {
+            const GW::Vec2f calc_pos = Rotate(vert, rotation_cos, rotation_sin) + position;
+            *out++ = {calc_pos.x, calc_pos.y, 0.0f, palette[vert.modifier]};
         }
-        vertices[i].z = 0.0f;
-        vertices[i].x = calc_pos.x;
-        vertices[i].y = calc_pos.y;
     }
-    vertices += num_v;
-    vertices_count += num_v;
+}
+
+void AgentRenderer::InstanceStream::clear()
+{
+    x.clear();
+    y.clear();
+    rotation_cos.clear();
+    rotation_sin.clear();
+    scale.clear();
+    color.clear();
+    modifier.clear();
+    shape.clear();
+}
+
+void AgentRenderer::InstanceStream::push_back(const Shape_e _shape, const RenderPosition& pos, const float _size, const Color _color, const Color _modifier)
+{
+    x.push_back(pos.position.x);
+    y.push_back(pos.position.y);
+    rotation_cos.push_back(pos.rotation_cos);
+    rotation_sin.push_back(pos.rotation_sin);
+    scale.push_back(_size);
+    color.push_back(_color);
+    modifier.push_back(_modifier);
+    shape.push_back(static_cast<uint8_t>(_shape));
 }
 
 void AgentRenderer::BuildCustomAgentsMap()
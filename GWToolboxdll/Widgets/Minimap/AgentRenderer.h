@@ -133,12 +133,29 @@ private:
     void Enqueue(Shape_e shape, const GW::Agent* agent, float size, Color color);
     void Enqueue(Shape_e shape, const GW::MapProp* agent, float size, Color color);
     void Enqueue(Shape_e shape, const RenderPosition& pos, float size, Color color, Color modifier = 0);
+    // Expand the queued instances into the triangle list that is uploaded to the device
+    void BuildVertices();
 
     std::vector<const CustomAgent*>* GetCustomAgentsToDraw(const GW::Agent* agent);
 
-    D3DVertex* vertices = nullptr;    // vertices array
-    unsigned int vertices_count = 0;  // count of vertices
-    unsigned int vertices_max = 0;    // max number of vertices to draw in one call
+    // Agents queued for drawing this frame, in draw order; a handful of values per agent instead of a tessellated shape.
+    // Stored as one array per field so that BuildVertices() walks tightly packed data.
+    struct InstanceStream {
+        std::vector<float> x{};
+        std::vector<float> y{};
+        std::vector<float> rotation_cos{};
+        std::vector<float> rotation_sin{};
+        std::vector<float> scale{};
+        std::vector<Color> color{};
+        std::vector<Color> modifier{};
+        std::vector<uint8_t> shape{};
+
+        [[nodiscard]] size_t size() const { return shape.size(); }
+        void clear();
+        void push_back(Shape_e _shape, const RenderPosition& pos, float _size, Color _color, Color _modifier);
+    } instances;
+
+    std::vector<D3DVertex> vertices{}; // agent vertices built this frame
     unsigned int max_shape_verts = 0; // max number of triangles in a single shape
 
     Color color_agent_modifier = 0;
@@ -17,8 +17,10 @@
 #include <GWCA/Managers/UIMgr.h>
 
 #include <Modules/Resources.h>
+#include <Utf8.h>
 #include <Widgets/Minimap/CustomRenderer.h>
 #include <Widgets/Minimap/Minimap.h>
+#include <Widgets/Minimap/MinimapGeometry.h>
 
 #include <Color.h>
 
@@ -257,7 +259,7 @@ void CustomRenderer::SetTooltipMapID(const GW::Constants::MapID& map_id)
         }
     }
     if (!map_id_tooltip.map_name_ws.empty()) {
-        snprintf(map_id_tooltip.tooltip_str, sizeof(map_id_tooltip.tooltip_str), "Map ID (%s)", GuiUtils::WStringToString(map_id_tooltip.map_name_ws).c_str());
+        snprintf(map_id_tooltip.tooltip_str, sizeof(map_id_tooltip.tooltip_str), "Map ID (%s)", utf8::Buffer(map_id_tooltip.map_name_ws).c_str());
         map_id_tooltip.map_name_ws.clear();
     }
     ImGui::SetTooltip(map_id_tooltip.tooltip_str);
@@ -641,7 +643,7 @@ void CustomRenderer::DrawSettings()
     }
 }
 
-void CustomRenderer::Initialize(IDirect3DDevice9* device)
+void CustomRenderer::Initialize(IDirect3DDevice9*)
 {
     if (!buffer) {
         initialized = false;
@@ -651,14 +653,7 @@ void CustomRenderer::Initialize(IDirect3DDevice9* device)
     }
     initialized = true;
     type = D3DPT_LINELIST;
-    vertices_max = 0x100; // support for up to 256 line segments, should be enough
-    vertices = nullptr;
-
-    const HRESULT hr = device->CreateVertexBuffer(
-        sizeof(D3DVertex) * vertices_max, 0, D3DFVF_CUSTOMVERTEX, D3DPOOL_MANAGED, &buffer, nullptr);
-    if (FAILED(hr)) {
-        printf("Error setting up CustomRenderer vertex buffer: HRESULT: 0x%lX\n", hr);
-    }
+    vertices.reserve(vertices_max);
 }
 
 void CustomRenderer::Terminate()
@@ -672,34 +667,27 @@ void CustomRenderer::Terminate()
 
 void CustomRenderer::CustomPolygon::Initialize(IDirect3DDevice9* device)
 {
+    std::vector<D3DVertex> _vertices;
     if (filled && points.size() < max_points_filled) {
         if (points.size() < 3) {
             return; // can't draw a triangle with less than 3 vertices
         }
         type = D3DPT_TRIANGLELIST;
 
-        const auto poly = std::vector{{points}};
-        point_indices.clear();
-        point_indices = mapbox::earcut<unsigned>(poly);
-
-        const auto vertex_count = point_indices.size();
-        D3DVertex* _vertices = nullptr;
-
-        if (buffer) {
-            buffer->Release();
+        // Colour or visibility changes also land here; only triangulate again if the outline itself changed
+        const auto same_outline = std::ranges::equal(points, triangulated_points, [](const GW::Vec2f& a, const GW::Vec2f& b) {
+            return a.x == b.x && a.y == b.y;
+        });
+        if (point_indices.empty() || !same_outline) {
+            const auto poly = std::vector{{points}};
+            point_indices = mapbox::earcut<unsigned>(poly);
+            triangulated_points = points;
         }
-        device->CreateVertexBuffer(
-            sizeof(D3DVertex) * vertex_count, 0, D3DFVF_CUSTOMVERTEX, D3DPOOL_MANAGED, &buffer, nullptr);
-        buffer->Lock(0, sizeof(D3DVertex) * vertex_count, reinterpret_cast<void**>(&_vertices), D3DLOCK_DISCARD);
 
-        for (auto i = 0u; i < point_indices.size(); i++) {
-            _vertices[i].x = points.at(point_indices.at(i)).x;
-            _vertices[i].y = points.at(point_indices.at(i)).y;
-            _vertices[i].z = 0.f;
-            _vertices[i].color = color;
+        _vertices.reserve(point_indices.size());
+        for (const auto index : point_indices) {
+            MinimapGeometry::AppendVertex(_vertices, points.at(index).x, points.at(index).y, color);
         }
-
-        buffer->Unlock();
     }
     else {
         if (points.size() < 2) {
@@ -707,25 +695,12 @@ void CustomRenderer::CustomPolygon::Initialize(IDirect3DDevice9* device)
         }
         type = D3DPT_LINESTRIP;
 
-        const auto vertex_count = points.size() + 1;
-        D3DVertex* _vertices = nullptr;
-
-        if (buffer) {
-            buffer->Release();
+        _vertices.reserve(points.size());
+        for (const auto& point : points) {
+            MinimapGeometry::AppendVertex(_vertices, point.x, point.y, color);
         }
-        device->CreateVertexBuffer(
-            sizeof(D3DVertex) * vertex_count, 0, D3DFVF_CUSTOMVERTEX, D3DPOOL_MANAGED, &buffer, nullptr);
-        buffer->Lock(0, sizeof(D3DVertex) * vertex_count, reinterpret_cast<void**>(&_vertices), D3DLOCK_DISCARD);
-
-        for (auto i = 0u; i < points.size(); i++) {
-            _vertices[i].x = points.at(i).x;
-            _vertices[i].y = points.at(i).y;
-            _vertices[i].z = 0.f;
-            _vertices[i].color = color;
-        }
-
-        buffer->Unlock();
     }
+    Upload(device, _vertices);
     initialized = true;
 }
 
@@ -749,59 +724,17 @@ void CustomRenderer::CustomPolygon::Render(IDirect3DDevice9* device)
 void CustomRenderer::CustomMarker::Initialize(IDirect3DDevice9* device)
 {
     const auto colour = color >> IM_COL32_A_SHIFT == 0 ? CustomRenderer::color : color;
+    count = 48;
+    std::vector<D3DVertex> _vertices;
     if (shape == Shape::FullCircle) {
         type = D3DPT_TRIANGLEFAN;
-        count = 48;
-        const unsigned vertex_count = count + 2;
-        D3DVertex* _vertices = nullptr;
-
-        if (buffer) {
-            buffer->Release();
-        }
-        device->CreateVertexBuffer(
-            sizeof(D3DVertex) * vertex_count, 0, D3DFVF_CUSTOMVERTEX, D3DPOOL_MANAGED, &buffer, nullptr);
-        buffer->Lock(0, sizeof(D3DVertex) * vertex_count, reinterpret_cast<void**>(&_vertices), D3DLOCK_DISCARD);
-
-        _vertices[0].x = 0.0f;
-        _vertices[0].y = 0.0f;
-        _vertices[0].z = 0.0f;
-        _vertices[0].color = Colors::Sub(colour, Colors::ARGB(50, 0, 0, 0));
-        for (auto i = 1u; i < vertex_count; i++) {
-            constexpr auto pi = DirectX::XM_PI;
-            const float angle = (i - 1) * (2 * pi / static_cast<float>(count));
-            _vertices[i].x = std::cos(angle);
-            _vertices[i].y = std::sin(angle);
-            _vertices[i].z = 0.0f;
-            _vertices[i].color = colour;
-        }
-
-        buffer->Unlock();
+        MinimapGeometry::AppendFilledCircle(_vertices, count, Colors::Sub(colour, Colors::ARGB(50, 0, 0, 0)), colour);
     }
     else {
         type = D3DPT_LINESTRIP;
-        count = 48;
-        const auto vertex_count = count + 1;
-        D3DVertex* _vertices = nullptr;
-
-        if (buffer) {
-            buffer->Release();
-        }
-        device->CreateVertexBuffer(
-            sizeof(D3DVertex) * vertex_count, 0, D3DFVF_CUSTOMVERTEX, D3DPOOL_MANAGED, &buffer, nullptr);
-        buffer->Lock(0, sizeof(D3DVertex) * vertex_count, reinterpret_cast<void**>(&_vertices), D3DLOCK_DISCARD);
-
-        for (auto i = 0u; i < count; i++) {
-            constexpr auto pi = DirectX::XM_PI;
-            const float angle = i * (2 * pi / (count + 1));
-            _vertices[i].x = std::cos(angle);
-            _vertices[i].y = std::sin(angle);
-            _vertices[i].z = 0.0f;
-            _vertices[i].color = colour;
-        }
-        _vertices[count] = _vertices[0];
-
-        buffer->Unlock();
+        MinimapGeometry::AppendLineCircle(_vertices, count, colour);
     }
+    Upload(device, _vertices);
     initialized = true;
 }
 
@@ -829,26 +762,9 @@ void CustomRenderer::LineCircle::Initialize(IDirect3DDevice9* device)
 {
     type = D3DPT_LINESTRIP;
     count = 48; // poly count
-    const auto vertex_count = count + 1;
-    D3DVertex* _vertices = nullptr;
-
-    if (buffer) {
-        buffer->Release();
-    }
-    device->CreateVertexBuffer(
-        sizeof(D3DVertex) * vertex_count, 0, D3DFVF_CUSTOMVERTEX, D3DPOOL_MANAGED, &buffer, nullptr);
-    buffer->Lock(0, sizeof(D3DVertex) * vertex_count, reinterpret_cast<void**>(&_vertices), D3DLOCK_DISCARD);
-
-    for (size_t i = 0; i < count; i++) {
-        const float angle = i * (DirectX::XM_2PI / (count + 1));
-        _vertices[i].x = std::cos(angle);
-        _vertices[i].y = std::sin(angle);
-        _vertices[i].z = 0.0f;
-        _vertices[i].color = color; // 0xFF666677;
-    }
-    _vertices[count] = _vertices[0];
-
-    buffer->Unlock();
+    std::vector<D3DVertex> _vertices;
+    MinimapGeometry::AppendLineCircle(_vertices, count, color); // 0xFF666677;
+    Upload(device, _vertices);
 }
 
 void CustomRenderer::Render(IDirect3DDevice9* device)
@@ -860,21 +776,16 @@ void CustomRenderer::Render(IDirect3DDevice9* device)
 
     DrawCustomMarkers(device);
 
-    vertices_count = 0;
-    if (const HRESULT res = buffer->Lock(0, sizeof(D3DVertex) * vertices_max, reinterpret_cast<void**>(&vertices), D3DLOCK_DISCARD); FAILED(res)) {
-        printf("PingsLinesRenderer Lock() error: HRESULT: 0x%lX\n", res);
-    }
+    vertices.clear();
 
     DrawCustomLines(device);
 
     const auto xmi = DirectX::XMMatrixIdentity();
     device->SetTransform(D3DTS_WORLD, reinterpret_cast<const D3DMATRIX*>(&xmi));
 
-    buffer->Unlock();
-    if (vertices_count != 0) {
+    if (!vertices.empty() && Upload(device, vertices, true)) {
         device->SetStreamSource(0, buffer, 0, sizeof(D3DVertex));
-        device->DrawPrimitive(type, 0, vertices_count / 2);
-        vertices_count = 0;
+        device->DrawPrimitive(type, 0, vertices.size() / 2);
     }
 }
 
@@ -923,13 +834,8 @@ void CustomRenderer::DrawCustomLines(const IDirect3DDevice9*)
 
 void CustomRenderer::EnqueueVertex(const float x, const float y, const Color _color)
 {
-    if (vertices_count == vertices_max) {
+    if (vertices.size() == vertices_max) {
         return;
     }
-    vertices[0].x = x;
-    vertices[0].y = y;
-    vertices[0].z = 0.0f;
-    vertices[0].color = _color;
-    ++vertices;
-    ++vertices_count;
+    MinimapGeometry::AppendVertex(vertices, x, y, _color);
 }
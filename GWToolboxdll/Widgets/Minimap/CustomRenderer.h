@@ -71,6 +71,8 @@ class CustomRenderer : public VBuffer {
     private:
         void Initialize(IDirect3DDevice9* device) override;
         std::vector<unsigned> point_indices{};
+        // Outline point_indices was worked out for
+        std::vector<GW::Vec2f> triangulated_points{};
     };
 
 public:
@@ -126,9 +128,8 @@ private:
 
     inline static Color color{0xFF00FFFF};
 
-    D3DVertex* vertices = nullptr;
-    unsigned int vertices_count = 0;
-    unsigned int vertices_max = 0;
+    std::vector<D3DVertex> vertices{};
+    const size_t vertices_max = 0x100; // support for up to 128 line segments, should be enough
 
     int show_polygon_details = -1;
     bool markers_changed = false;
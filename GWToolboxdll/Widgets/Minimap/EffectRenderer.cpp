@@ -14,6 +14,7 @@
 #include <Timer.h>
 #include <Utils/GuiUtils.h>
 #include <Widgets/Minimap/EffectRenderer.h>
+#include <Widgets/Minimap/MinimapGeometry.h>
 
 namespace {
     enum SkillEffect {
@@ -33,30 +34,22 @@ namespace {
         Churning_earth       = 994
     };
 
-    class EffectCircle : public VBuffer {
-        void Initialize(IDirect3DDevice9* device) override;
-
-    public:
-        Color* color = nullptr;
-        float range = GW::Constants::Range::Adjacent;
-    };
-
     struct Effect {
         Effect(const uint32_t _effect_id, const float _x, const float _y, const uint32_t _duration,
-               const float range, Color* _color)
+               const float _range, Color* _color)
             : start(TIMER_INIT())
             , effect_id(_effect_id)
             , pos(_x, _y)
             , duration(_duration)
-        {
-            circle.range = range;
-            circle.color = _color;
-        }
+            , range(_range)
+            , color(_color) { }
+
         clock_t start;
         const uint32_t effect_id;
         const GW::Vec2f pos;
         uint32_t duration;
-        EffectCircle circle;
+        float range;
+        const Color* color;
     };
 
     struct pair_hash {
@@ -103,7 +96,9 @@ namespace {
 
     GW::HookEntry StoC_Hook;
 
-    unsigned int vertices_max = 0x1000; // max number of vertices to draw in one call
+    constexpr size_t effect_circle_segments = 16;
+    // All effect circles are drawn with a single call each frame
+    std::vector<D3DVertex> vertices;
 }
 
 void EffectRenderer::LoadDefaults()
@@ -218,7 +213,7 @@ void EffectRenderer::RemoveTriggeredEffect(const uint32_t effect_id, GW::Vec2f*
         // Trigger this trap to time out in 2 seconds' time. Increase damage radius from adjacent to nearby.
         closest->start = TIMER_INIT();
         closest->duration = trigger->duration;
-        closest->circle.range = trigger->range;
+        closest->range = trigger->range;
     }
 }
 
@@ -300,7 +295,7 @@ void EffectRenderer::PacketCallback(GW::Packet::StoC::PlayEffect* pak) const
     aoe_effects.push_back(new Effect(pak->effect_id, pak->coords.x, pak->coords.y, settings->duration, settings->range, &settings->color));
 }
 
-void EffectRenderer::Initialize(IDirect3DDevice9* device)
+void EffectRenderer::Initialize(IDirect3DDevice9*)
 {
     if (initialized) {
         return;
@@ -308,11 +303,6 @@ void EffectRenderer::Initialize(IDirect3DDevice9* device)
     initialized = true;
     type = D3DPT_LINELIST;
 
-    const HRESULT hr = device->CreateVertexBuffer(sizeof(D3DVertex) * vertices_max, 0,
-                                                  D3DFVF_CUSTOMVERTEX, D3DPOOL_MANAGED, &buffer, nullptr);
-    if (FAILED(hr)) {
-        printf("Error setting up PingsLinesRenderer vertex buffer: HRESULT: 0x%lX\n", hr);
-    }
     GW::StoC::RegisterPacketCallback<GW::Packet::StoC::GameSrvTransfer>(&StoC_Hook, [&](GW::HookStatus*, GW::Packet::StoC::GameSrvTransfer*) {
         need_to_clear_effects = true;
     });
@@ -334,6 +324,7 @@ void EffectRenderer::DrawAoeEffects(IDirect3DDevice9* device)
         return;
     }
     std::lock_guard lock(effects_mutex);
+    vertices.clear();
     size_t effect_size = aoe_effects.size();
     for (size_t i = 0; i < effect_size; i++) {
         Effect* effect = aoe_effects[i];
@@ -347,37 +338,12 @@ void EffectRenderer::DrawAoeEffects(IDirect3DDevice9* device)
             effect_size--;
             continue;
         }
-        const auto translate = DirectX::XMMatrixTranslation(effect->pos.x, effect->pos.y, 0.0f);
-        const auto scale = DirectX::XMMatrixScaling(effect->circle.range, effect->circle.range, 1.0f);
-        auto world = scale * translate;
-        device->SetTransform(D3DTS_WORLD, reinterpret_cast<D3DMATRIX*>(&world));
-        effect->circle.Render(device);
+        MinimapGeometry::AppendCircleOutline(vertices, effect->pos, effect->range, effect_circle_segments, *effect->color);
     }
-}
-
-void EffectCircle::Initialize(IDirect3DDevice9* device)
-{
-    type = D3DPT_LINESTRIP;
-    count = 16; // polycount
-    const auto vertex_count = count + 1;
-    D3DVertex* vertices = nullptr;
-
-    if (buffer) {
-        buffer->Release();
-    }
-    device->CreateVertexBuffer(sizeof(D3DVertex) * vertex_count, 0,
-                               D3DFVF_CUSTOMVERTEX, D3DPOOL_MANAGED, &buffer, nullptr);
-    buffer->Lock(0, sizeof(D3DVertex) * vertex_count,
-                 (VOID**)&vertices, D3DLOCK_DISCARD);
-
-    for (size_t i = 0; i < count; i++) {
-        const float angle = i * (DirectX::XM_2PI / count);
-        vertices[i].x = std::cos(angle);
-        vertices[i].y = std::sin(angle);
-        vertices[i].z = 0.0f;
-        vertices[i].color = *color;
+    if (vertices.empty() || !Upload(device, vertices, true)) {
+        return;
     }
-    vertices[count] = vertices[0];
-
-    buffer->Unlock();
+    device->SetFVF(D3DFVF_CUSTOMVERTEX);
+    device->SetStreamSource(0, buffer, 0, sizeof(D3DVertex));
+    device->DrawPrimitive(type, 0, vertices.size() / 2);
 }
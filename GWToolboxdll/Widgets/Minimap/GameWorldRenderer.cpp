@@ -1,5 +1,6 @@
 #include "stdafx.h"
 
+#include <GWCA/Constants/Maps.h>
 #include <GWCA/Context/MapContext.h>
 #include <GWCA/GameContainers/GamePos.h>
 #include <GWCA/GameEntities/Camera.h>
@@ -9,6 +10,7 @@
 #include <GWCA/Managers/RenderMgr.h>
 
 #include <Defines.h>
+#include <Modules/Resources.h>
 #include <Widgets/Minimap/GameWorldRenderer.h>
 #include <Widgets/Minimap/Minimap.h>
 
@@ -48,6 +50,146 @@ namespace {
         points.push_back(points.at(0)); // to complete the line list
         return points;
     }
+
+    void hash_combine(size_t& seed, const size_t value)
+    {
+        seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+
+    // Everything that affects the generated vertices, so that unchanged shapes can be kept across a re-sync
+    size_t renderable_hash(const GW::Constants::MapID map_id, const std::vector<GW::Vec2f>& points, const unsigned int col, const bool filled)
+    {
+        size_t seed = std::hash<std::string_view>{}({reinterpret_cast<const char*>(points.data()), points.size() * sizeof(GW::Vec2f)});
+        hash_combine(seed, std::hash<uint32_t>{}(static_cast<uint32_t>(map_id)));
+        hash_combine(seed, std::hash<unsigned int>{}(col));
+        hash_combine(seed, std::hash<bool>{}(filled));
+        hash_combine(seed, std::hash<unsigned>{}(lerp_steps_per_line));
+        return seed;
+    }
+
+    bool SamePoints(const std::vector<GW::Vec2f>& a, const std::vector<GW::Vec2f>& b)
+    {
+        return std::ranges::equal(a, b, [](const GW::Vec2f& lhs, const GW::Vec2f& rhs) {
+            return lhs.x == rhs.x && lhs.y == rhs.y;
+        });
+    }
+
+    // Renderables from before the current re-sync, looked up by content hash so that they can be reused
+    std::unordered_multimap<size_t, std::unique_ptr<GameWorldRenderer::GenericPolyRenderable>> previous_renderables;
+
+    // Terrain altitude only depends on the map and the x/y of a vertex, so query results are remembered per map and persisted between sessions.
+    // Avoids the multi-frame altitude query on every map load and every marker edit.
+    namespace AltitudeCache {
+        constexpr uint32_t file_version = 1;
+
+        GW::Constants::MapID map_id = GW::Constants::MapID::None;
+        std::unordered_map<uint64_t, float> altitudes;
+        bool dirty = false;
+
+        uint64_t Key(const float x, const float y)
+        {
+            return static_cast<uint64_t>(std::bit_cast<uint32_t>(x)) << 32 | std::bit_cast<uint32_t>(y);
+        }
+
+        std::filesystem::path GetFilePath(const GW::Constants::MapID for_map_id)
+        {
+            return Resources::GetPath(L"terrain cache", std::format(L"{}.bin", static_cast<uint32_t>(for_map_id)));
+        }
+
+        void Write(const std::filesystem::path& path, const std::vector<std::pair<uint64_t, float>>& entries)
+        {
+            if (!Resources::EnsureFolderExists(path.parent_path())) {
+                return;
+            }
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                Log::Log("GameWorldRenderer: failed to write %ls", path.c_str());
+                return;
+            }
+            const auto count = static_cast<uint32_t>(entries.size());
+            file.write(reinterpret_cast<const char*>(&file_version), sizeof(file_version));
+            file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+            for (const auto& [key, altitude] : entries) {
+                file.write(reinterpret_cast<const char*>(&key), sizeof(key));
+                file.write(reinterpret_cast<const char*>(&altitude), sizeof(altitude));
+            }
+        }
+
+        // Written on the worker thread unless async is false; the render thread shouldn't wait on disk, but on terminate
+        // the worker (and this module's state) may be gone before a queued task gets to run.
+        void Save(const bool async = true)
+        {
+            if (!dirty || map_id == GW::Constants::MapID::None) {
+                return;
+            }
+            dirty = false;
+            auto path = GetFilePath(map_id);
+            std::vector<std::pair<uint64_t, float>> entries(altitudes.begin(), altitudes.end());
+            if (!async) {
+                Write(path, entries);
+                return;
+            }
+            Resources::EnqueueWorkerTask([path = std::move(path), entries = std::move(entries)] {
+                Write(path, entries);
+            });
+        }
+
+        void Load(const GW::Constants::MapID for_map_id)
+        {
+            if (map_id == for_map_id) {
+                return;
+            }
+            Save();
+            map_id = for_map_id;
+            altitudes.clear();
+            dirty = false;
+
+            std::ifstream file(GetFilePath(map_id), std::ios::binary);
+            if (!file.is_open()) {
+                return;
+            }
+            uint32_t version = 0;
+            uint32_t count = 0;
+            file.read(reinterpret_cast<char*>(&version), sizeof(version));
+            file.read(reinterpret_cast<char*>(&count), sizeof(count));
+            if (!file || version != file_version) {
+                return;
+            }
+            altitudes.reserve(count);
+            for (uint32_t i = 0; i < count; i++) {
+                uint64_t key = 0;
+                float altitude = ALTITUDE_UNKNOWN;
+                file.read(reinterpret_cast<char*>(&key), sizeof(key));
+                file.read(reinterpret_cast<char*>(&altitude), sizeof(altitude));
+                if (!file) {
+                    break; // truncated file; keep what was read
+                }
+                altitudes[key] = altitude;
+            }
+        }
+
+        // Fill in the Z of every vertex from the cache; false if any of them is missing
+        bool Apply(std::vector<D3DVertex>& vertices)
+        {
+            for (const auto& vertex : vertices) {
+                if (!altitudes.contains(Key(vertex.x, vertex.y))) {
+                    return false;
+                }
+            }
+            for (auto& vertex : vertices) {
+                vertex.z = altitudes.at(Key(vertex.x, vertex.y));
+            }
+            return true;
+        }
+
+        void Store(const std::vector<D3DVertex>& vertices)
+        {
+            for (const auto& vertex : vertices) {
+                altitudes[Key(vertex.x, vertex.y)] = vertex.z;
+            }
+            dirty = true;
+        }
+    }
 } // namespace
 
 GameWorldRenderer::GenericPolyRenderable::GenericPolyRenderable(
@@ -60,6 +202,7 @@ GameWorldRenderer::GenericPolyRenderable::GenericPolyRenderable(
     , col(col)
     , points(points)
     , filled(filled)
+    , lerp_steps(lerp_steps_per_line)
 {
     if (filled && points.size() >= 3) {
         // (filling doesn't make sense if there is not at least enough points for one triangle)
@@ -106,6 +249,23 @@ GameWorldRenderer::GenericPolyRenderable::~GenericPolyRenderable()
     }
 }
 
+bool GameWorldRenderer::GenericPolyRenderable::Matches(const GW::Constants::MapID other_map_id, const std::vector<GW::Vec2f>& other_points, const unsigned int other_col, const bool other_filled) const
+{
+    return map_id == other_map_id && col == other_col && filled == other_filled && lerp_steps == lerp_steps_per_line && SamePoints(points, other_points);
+}
+
+void GameWorldRenderer::GenericPolyRenderable::Upload() const
+{
+    // commit the completed vertices to vram
+    void* mem_loc = nullptr;
+    // map the vertex buffer memory and write vertices to it.
+    if (vb->Lock(0, vertices.size() * sizeof(D3DVertex), &mem_loc, D3DLOCK_DISCARD) == S_OK && mem_loc != nullptr) {
+        // this should avoid an invalid memcpy, if locking fails for some reason
+        memcpy(mem_loc, vertices.data(), vertices.size() * sizeof(D3DVertex));
+        vb->Unlock();
+    }
+}
+
 void GameWorldRenderer::GenericPolyRenderable::Draw(IDirect3DDevice9* device)
 {
     // draw this specific renderable
@@ -113,6 +273,11 @@ void GameWorldRenderer::GenericPolyRenderable::Draw(IDirect3DDevice9* device)
         // a safe failure mode
         return;
     }
+    // altitudes may already be known from an earlier session or another renderable sharing these points
+    if (!all_altitudes_queried && cur_altitude == 0 && AltitudeCache::map_id == map_id && AltitudeCache::Apply(vertices)) {
+        all_altitudes_queried = true;
+        Upload();
+    }
     // update altitudes if not done already
     if (!all_altitudes_queried) {
         // altitudes (Z value) for each vertex can't be known until we are in the correct map,
@@ -140,14 +305,10 @@ void GameWorldRenderer::GenericPolyRenderable::Draw(IDirect3DDevice9* device)
                 }
                 if (cur_altitude++ == pmap_size - 1) {
                     all_altitudes_queried = true;
-                    // commit the completed vertices to vram
-                    void* mem_loc = nullptr;
-                    // map the vertex buffer memory and write vertices to it.
-                    if (vb->Lock(0, vertices.size() * sizeof(D3DVertex), &mem_loc, D3DLOCK_DISCARD) == S_OK && mem_loc != nullptr) {
-                        // this should avoid an invalid memcpy, if locking fails for some reason
-                        memcpy(mem_loc, vertices.data(), vertices.size() * sizeof(D3DVertex));
-                        vb->Unlock();
+                    if (AltitudeCache::map_id == map_id) {
+                        AltitudeCache::Store(vertices);
                     }
+                    Upload();
                 }
             }
         }
@@ -276,6 +437,7 @@ void GameWorldRenderer::Render(IDirect3DDevice9* device)
         }
 
         const auto map_id = GW::Map::GetMapID();
+        AltitudeCache::Load(map_id);
         renderables_mutex.lock();
         for (const auto& renderable : renderables) {
             if (renderable->map_id == map_id) {
@@ -351,19 +513,43 @@ void GameWorldRenderer::Terminate()
 {
     // free up any vertex buffers
     renderables.clear();
+    previous_renderables.clear();
+    AltitudeCache::Save(false);
 }
 
 void GameWorldRenderer::SyncAllMarkers(IDirect3DDevice9* device)
 {
     renderables_mutex.lock();
+    // keep hold of the current renderables; any whose content is unchanged is moved back rather than rebuilt
+    for (auto& renderable : renderables) {
+        const auto hash = renderable->content_hash;
+        previous_renderables.emplace(hash, std::move(renderable));
+    }
     renderables.clear();
     SyncLines(device);
     SyncPolys(device);
     SyncMarkers(device);
+    previous_renderables.clear();
     renderables_mutex.unlock();
     need_sync_markers = false;
 }
 
+void GameWorldRenderer::AddRenderable(IDirect3DDevice9* device, const GW::Constants::MapID map_id, const std::vector<GW::Vec2f>& points, const unsigned int col, const bool filled)
+{
+    const auto hash = renderable_hash(map_id, points, col, filled);
+    const auto [first, last] = previous_renderables.equal_range(hash);
+    for (auto found = first; found != last; ++found) {
+        if (found->second->Matches(map_id, points, col, filled)) {
+            renderables.push_back(std::move(found->second));
+            previous_renderables.erase(found);
+            return;
+        }
+    }
+    auto renderable = std::make_unique<GenericPolyRenderable>(device, map_id, points, col, filled);
+    renderable->content_hash = hash;
+    renderables.push_back(std::move(renderable));
+}
+
 void GameWorldRenderer::SyncLines(IDirect3DDevice9* device)
 {
     // sync lines with CustomRenderer
@@ -374,7 +560,7 @@ void GameWorldRenderer::SyncLines(IDirect3DDevice9* device)
             continue;
         }
         std::vector points = {line->p1, line->p2};
-        renderables.push_back(std::make_unique<GenericPolyRenderable>(device, line->map, points, line->color, false));
+        AddRenderable(device, line->map, points, line->color, false);
     }
 }
 
@@ -390,7 +576,7 @@ void GameWorldRenderer::SyncPolys(IDirect3DDevice9* device)
         if (poly.points.empty()) {
             continue;
         }
-        renderables.push_back(std::make_unique<GenericPolyRenderable>(device, poly.map, poly.points, poly.color, poly.filled));
+        AddRenderable(device, poly.map, poly.points, poly.color, poly.filled);
     }
 }
 
@@ -404,6 +590,6 @@ void GameWorldRenderer::SyncMarkers(IDirect3DDevice9* device)
             continue;
         }
         std::vector<GW::Vec2f> points = circular_points_from_marker(marker.pos.x, marker.pos.y, marker.size);
-        renderables.push_back(std::make_unique<GenericPolyRenderable>(device, marker.map, points, marker.color, marker.IsFilled()));
+        AddRenderable(device, marker.map, points, marker.color, marker.IsFilled());
     }
 }
@@ -13,14 +13,20 @@ public:
         ~GenericPolyRenderable();
 
         void Draw(IDirect3DDevice9* device);
+        // Whether this was built from exactly this content, with the current interpolation setting; content_hash alone can collide
+        [[nodiscard]] bool Matches(GW::Constants::MapID other_map_id, const std::vector<GW::Vec2f>& other_points, unsigned int other_col, bool other_filled) const;
         GW::Constants::MapID map_id{};
+        size_t content_hash = 0;
 
     private:
+        void Upload() const;
+
         IDirect3DVertexBuffer9* vb = nullptr;
         unsigned int col = 0u;
         std::vector<GW::Vec2f> points{};
         std::vector<D3DVertex> vertices{};
         bool filled = false;
+        unsigned lerp_steps = 0;
         unsigned int cur_altitude = 0u;
         bool all_altitudes_queried = false;
     };
@@ -37,6 +43,8 @@ private:
     static void SyncPolys(IDirect3DDevice9* device);
     static void SyncMarkers(IDirect3DDevice9* device);
     static void SyncAllMarkers(IDirect3DDevice9* device);
+    // Reuses the renderable from before the current sync if its content is unchanged, builds a new one otherwise
+    static void AddRenderable(IDirect3DDevice9* device, GW::Constants::MapID map_id, const std::vector<GW::Vec2f>& points, unsigned int col, bool filled);
     static bool ConfigureProgrammablePipeline(IDirect3DDevice9* device);
     static bool SetD3DTransform(IDirect3DDevice9* device);
 };
@@ -34,6 +34,7 @@
 #include <GWCA/Utilities/Scanner.h>
 #include <ImGuiAddons.h>
 #include <Logger.h>
+#include <Utils/GenericPacketBus.h>
 #include <Utils/GuiUtils.h>
 
 #include "Minimap.h"
@@ -566,6 +567,8 @@ void Minimap::SignalTerminate()
     effect_renderer.Terminate();
     GameWorldRenderer::Terminate();
 
+    GenericPacketBus::Unsubscribe(&GenericValue_Entry);
+
     hide_flagging_controls_patch.Reset();
 
     GW::GameThread::Enqueue([]() {
@@ -626,19 +629,21 @@ void Minimap::Initialize()
             }
         }
     });
-    GW::StoC::RegisterPacketCallback<GW::Packet::StoC::GenericValue>(&GenericValueTarget_Entry, [this](const GW::HookStatus*, const GW::Packet::StoC::GenericValue* pak) -> void {
-        if (visible) {
-            if (GW::Map::GetInstanceType() == GW::Constants::InstanceType::Explorable) {
-                effect_renderer.PacketCallback(pak);
-            }
+    GenericPacketBus::Subscribe(&GenericValue_Entry, {GenericPacketBus::Header::GenericValue, GenericPacketBus::Header::GenericValueTarget}, [this](const GW::HookStatus*, const GenericPacketBus::Event& event) -> void {
+        if (!visible) {
+            return;
         }
-    });
-    GW::StoC::RegisterPacketCallback<GW::Packet::StoC::GenericValueTarget>(&GenericValueTarget_Entry, [this](GW::HookStatus*, const GW::Packet::StoC::GenericValueTarget* pak) -> void {
-        if (visible) {
-            pingslines_renderer.P153Callback(pak);
-            if (GW::Map::GetInstanceType() == GW::Constants::InstanceType::Explorable) {
-                effect_renderer.PacketCallback(pak);
+        const bool is_explorable = GW::Map::GetInstanceType() == GW::Constants::InstanceType::Explorable;
+        if (event.header == GenericPacketBus::Header::GenericValue) {
+            if (is_explorable) {
+                effect_renderer.PacketCallback(static_cast<const GW::Packet::StoC::GenericValue*>(event.packet));
             }
+            return;
+        }
+        const auto pak = static_cast<const GW::Packet::StoC::GenericValueTarget*>(event.packet);
+        pingslines_renderer.P153Callback(pak);
+        if (is_explorable) {
+            effect_renderer.PacketCallback(pak);
         }
     });
     constexpr std::array hook_messages = {
@@ -1430,6 +1435,7 @@ void Minimap::Render(IDirect3DDevice9* device)
 
 void Minimap::SelectTarget(const GW::Vec2f pos)
 {
+    // NB: Called from WndProc, not Draw; AgentSnapshot's pointers are only valid for the frame it was taken, so walk the live agent array
     const auto* agents = GW::Agents::GetAgentArray();
     if (agents == nullptr) {
         return;
@@ -99,7 +99,7 @@ private:
 
     GW::HookEntry AgentPinged_Entry;
     GW::HookEntry CompassEvent_Entry;
-    GW::HookEntry GenericValueTarget_Entry;
+    GW::HookEntry GenericValue_Entry;
     GW::HookEntry SkillActivate_Entry;
     GW::HookEntry InstanceLoadFile_Entry;
     GW::HookEntry InstanceLoadInfo_Entry;
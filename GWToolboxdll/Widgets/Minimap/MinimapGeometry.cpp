@@ -0,0 +1,52 @@
+#include "stdafx.h"
+
+#include <Widgets/Minimap/MinimapGeometry.h>
+
+void MinimapGeometry::AppendLineCircle(Vertices& out, const size_t segments, const Color color)
+{
+    out.reserve(out.size() + segments + 1);
+    const auto first = out.size();
+    for (size_t i = 0; i < segments; i++) {
+        const float angle = static_cast<float>(i) * (DirectX::XM_2PI / static_cast<float>(segments));
+        AppendVertex(out, std::cos(angle), std::sin(angle), color);
+    }
+    out.push_back(out[first]);
+}
+
+void MinimapGeometry::AppendFilledCircle(Vertices& out, const size_t segments, const Color center_color, const Color edge_color)
+{
+    out.reserve(out.size() + segments + 2);
+    AppendVertex(out, 0.f, 0.f, center_color);
+    for (size_t i = 0; i <= segments; i++) {
+        const float angle = static_cast<float>(i) * (DirectX::XM_2PI / static_cast<float>(segments));
+        AppendVertex(out, std::cos(angle), std::sin(angle), edge_color);
+    }
+}
+
+void MinimapGeometry::AppendCircleOutline(Vertices& out, const GW::Vec2f& center, const float radius, const size_t segments, const Color color)
+{
+    out.reserve(out.size() + segments * 2);
+    const float step = DirectX::XM_2PI / static_cast<float>(segments);
+    float prev_x = center.x + radius;
+    float prev_y = center.y;
+    for (size_t i = 1; i <= segments; i++) {
+        const float angle = static_cast<float>(i) * step;
+        const float x = center.x + radius * std::cos(angle);
+        const float y = center.y + radius * std::sin(angle);
+        AppendVertex(out, prev_x, prev_y, color);
+        AppendVertex(out, x, y, color);
+        prev_x = x;
+        prev_y = y;
+    }
+}
+
+void MinimapGeometry::AppendRing(Vertices& out, const float radius, const float thickness_x, const float thickness_y, const size_t points, const Color color)
+{
+    out.reserve(out.size() + points);
+    const auto last = static_cast<float>(points - 2);
+    for (size_t i = 0; i < points; i += 2) {
+        const float angle = static_cast<float>(i) / last * DirectX::XM_2PI;
+        AppendVertex(out, radius * std::cos(angle), radius * std::sin(angle), color);
+        AppendVertex(out, (radius - thickness_x) * std::cos(angle), (radius - thickness_y) * std::sin(angle), color);
+    }
+}
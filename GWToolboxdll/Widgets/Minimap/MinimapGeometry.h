@@ -0,0 +1,37 @@
+#pragma once
+
+#include <GWCA/GameContainers/GamePos.h>
+
+#include <Widgets/Minimap/D3DVertex.h>
+
+using Color = uint32_t;
+
+// CPU side geometry generation shared by the minimap renderers.
+// Nothing in here touches the device; renderers build their vertices into plain arrays and hand them to VBuffer::Upload()
+namespace MinimapGeometry {
+    using Vertices = std::vector<D3DVertex>;
+
+    inline void AppendVertex(Vertices& out, const float x, const float y, const Color color)
+    {
+        out.push_back({x, y, 0.f, color});
+    }
+
+    // Single segment for a D3DPT_LINELIST; 2 vertices
+    inline void AppendLine(Vertices& out, const GW::Vec2f& from, const GW::Vec2f& to, const Color color)
+    {
+        AppendVertex(out, from.x, from.y, color);
+        AppendVertex(out, to.x, to.y, color);
+    }
+
+    // Unit circle for a D3DPT_LINESTRIP; segments + 1 vertices
+    void AppendLineCircle(Vertices& out, size_t segments, Color color);
+
+    // Unit circle for a D3DPT_TRIANGLEFAN around the origin; segments + 2 vertices
+    void AppendFilledCircle(Vertices& out, size_t segments, Color center_color, Color edge_color);
+
+    // Circle outline in world space for a D3DPT_LINELIST, so that many circles can be drawn with a single call; segments * 2 vertices
+    void AppendCircleOutline(Vertices& out, const GW::Vec2f& center, float radius, size_t segments, Color color);
+
+    // Ring of the given radius and thickness for a D3DPT_TRIANGLESTRIP; points vertices, points must be even
+    void AppendRing(Vertices& out, float radius, float thickness_x, float thickness_y, size_t points, Color color);
+}
@@ -15,6 +15,7 @@
 #include <Defines.h>
 #include <Utils/GuiUtils.h>
 #include <Widgets/Minimap/Minimap.h>
+#include <Widgets/Minimap/MinimapGeometry.h>
 #include <GWCA/Managers/PlayerMgr.h>
 
 void PingsLinesRenderer::LoadSettings(const ToolboxIni* ini, const char* section)
@@ -171,7 +172,7 @@ void PingsLinesRenderer::P153Callback(const GW::Packet::StoC::GenericValueTarget
     }
 }
 
-void PingsLinesRenderer::Initialize(IDirect3DDevice9* device)
+void PingsLinesRenderer::Initialize(IDirect3DDevice9*)
 {
     if (initialized) {
         return;
@@ -180,15 +181,7 @@ void PingsLinesRenderer::Initialize(IDirect3DDevice9* device)
     initialized = true;
     type = D3DPT_LINELIST;
 
-    vertices_max = 0x1000; // support for up to 4096 line segments, should be enough
-
-    vertices = nullptr;
-
-    const HRESULT hr = device->CreateVertexBuffer(sizeof(D3DVertex) * vertices_max, 0,
-                                                  D3DFVF_CUSTOMVERTEX, D3DPOOL_MANAGED, &buffer, nullptr);
-    if (FAILED(hr)) {
-        printf("Error setting up PingsLinesRenderer vertex buffer: HRESULT: 0x%lX\n", hr);
-    }
+    vertices.reserve(vertices_max);
 }
 
 void PingsLinesRenderer::Render(IDirect3DDevice9* device)
@@ -199,11 +192,7 @@ void PingsLinesRenderer::Render(IDirect3DDevice9* device)
 
     DrawShadowstepMarker(device);
 
-    vertices_count = 0;
-    const HRESULT res = buffer->Lock(0, sizeof(D3DVertex) * vertices_max, reinterpret_cast<void**>(&vertices), D3DLOCK_DISCARD);
-    if (FAILED(res)) {
-        printf("PingsLinesRenderer Lock() error: HRESULT 0x%lX\n", res);
-    }
+    vertices.clear();
 
     DrawShadowstepLine(device);
 
@@ -214,11 +203,9 @@ void PingsLinesRenderer::Render(IDirect3DDevice9* device)
     const auto i = DirectX::XMMatrixIdentity();
     device->SetTransform(D3DTS_WORLD, reinterpret_cast<const D3DMATRIX*>(&i));
 
-    buffer->Unlock();
-    if (vertices_count != 0) {
+    if (!vertices.empty() && Upload(device, vertices, true)) {
         device->SetStreamSource(0, buffer, 0, sizeof(D3DVertex));
-        device->DrawPrimitive(type, 0, vertices_count / 2);
-        vertices_count = 0;
+        device->DrawPrimitive(type, 0, vertices.size() / 2);
     }
 }
 
@@ -263,15 +250,10 @@ void PingsLinesRenderer::DrawPings(IDirect3DDevice9* device)
 
 void PingsLinesRenderer::EnqueueVertex(const float x, const float y, const Color color)
 {
-    if (vertices_count == vertices_max) {
+    if (vertices.size() == vertices_max) {
         return;
     }
-    vertices[0].x = x;
-    vertices[0].y = y;
-    vertices[0].z = 0.0f;
-    vertices[0].color = color;
-    ++vertices;
-    ++vertices_count;
+    MinimapGeometry::AppendVertex(vertices, x, y, color);
 }
 
 void PingsLinesRenderer::DrawDrawings(IDirect3DDevice9*)
@@ -282,7 +264,7 @@ void PingsLinesRenderer::DrawDrawings(IDirect3DDevice9*)
         }
         std::deque<DrawingLine>& lines = it->second.lines;
 
-        if (vertices_count < vertices_max - 2) {
+        if (vertices.size() < vertices_max - 2) {
             for (const DrawingLine& line : lines) {
                 const uint32_t max_alpha = (color_drawings & IM_COL32_A_MASK) >> IM_COL32_A_SHIFT;
                 const uint32_t left = static_cast<uint32_t>(drawing_timeout - TIMER_DIFF(line.start));
@@ -299,7 +281,7 @@ void PingsLinesRenderer::DrawDrawings(IDirect3DDevice9*)
                 EnqueueVertex(line.x1, line.y1, color);
                 EnqueueVertex(line.x2, line.y2, color);
 
-                if (vertices_count >= vertices_max - 2) {
+                if (vertices.size() >= vertices_max - 2) {
                     break;
                 }
             }
@@ -386,60 +368,29 @@ void PingsLinesRenderer::PingCircle::Initialize(IDirect3DDevice9* device)
 {
     type = D3DPT_TRIANGLESTRIP;
     count = 96; // polycount
-    const auto vertex_count = count + 2;
-    D3DVertex* _vertices = nullptr;
-
-    if (buffer) {
-        buffer->Release();
-    }
-    device->CreateVertexBuffer(sizeof(D3DVertex) * vertex_count, 0,
-                               D3DFVF_CUSTOMVERTEX, D3DPOOL_MANAGED, &buffer, nullptr);
-    buffer->Lock(0, sizeof(D3DVertex) * vertex_count, reinterpret_cast<void**>(&_vertices),
-                 D3DLOCK_DISCARD);
+    std::vector<D3DVertex> _vertices;
+    _vertices.reserve(count + 2);
 
     for (size_t i = 0; i < count; i++) {
         const float angle = i * (2 * DirectX::XM_PI / count);
         const bool outer = i % 2 == 0;
         const float radius = outer ? 1.0f : 0.8f;
-        _vertices[i].x = radius * std::cos(angle);
-        _vertices[i].y = radius * std::sin(angle);
-        _vertices[i].z = 0.0f;
-        _vertices[i].color = outer ? color : Colors::Sub(color, 0xFF000000);
+        MinimapGeometry::AppendVertex(_vertices, radius * std::cos(angle), radius * std::sin(angle), outer ? color : Colors::Sub(color, 0xFF000000));
     }
-    _vertices[count] = _vertices[0];
-    _vertices[count + 1] = _vertices[1];
+    _vertices.push_back(_vertices[0]);
+    _vertices.push_back(_vertices[1]);
 
-    buffer->Unlock();
+    Upload(device, _vertices);
 }
 
 void PingsLinesRenderer::Marker::Initialize(IDirect3DDevice9* device)
 {
     type = D3DPT_TRIANGLEFAN;
     count = 16; // polycount
-    const unsigned int vertex_count = count + 2;
-    D3DVertex* _vertices = nullptr;
-
-    if (buffer) {
-        buffer->Release();
-    }
-    device->CreateVertexBuffer(sizeof(D3DVertex) * vertex_count, 0,
-                               D3DFVF_CUSTOMVERTEX, D3DPOOL_MANAGED, &buffer, nullptr);
-    buffer->Lock(0, sizeof(D3DVertex) * vertex_count, reinterpret_cast<void**>(&_vertices),
-                 D3DLOCK_DISCARD);
-
-    _vertices[0].x = 0.0f;
-    _vertices[0].y = 0.0f;
-    _vertices[0].z = 0.0f;
-    _vertices[0].color = Colors::Sub(color, Colors::ARGB(50, 0, 0, 0));
-    for (size_t i = 1; i < vertex_count; i++) {
-        const float angle = (i - 1) * (2 * DirectX::XM_PI / count);
-        _vertices[i].x = std::cos(angle);
-        _vertices[i].y = std::sin(angle);
-        _vertices[i].z = 0.0f;
-        _vertices[i].color = color;
-    }
-
-    buffer->Unlock();
+    std::vector<D3DVertex> _vertices;
+    MinimapGeometry::AppendFilledCircle(_vertices, count, Colors::Sub(color, Colors::ARGB(50, 0, 0, 0)), color);
+
+    Upload(device, _vertices);
 }
 
 float PingsLinesRenderer::AgentPing::GetX() const
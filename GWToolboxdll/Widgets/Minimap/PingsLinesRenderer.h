@@ -176,7 +176,6 @@ private:
     DWORD recall_target = 0;
 
     // for the gpu
-    D3DVertex* vertices = nullptr;   // vertices array
-    unsigned int vertices_count = 0; // count of vertices
-    unsigned int vertices_max = 0;   // max number of vertices to draw in one call
+    std::vector<D3DVertex> vertices{};  // line vertices built this frame
+    const size_t vertices_max = 0x1000; // max number of vertices to draw in one call
 };
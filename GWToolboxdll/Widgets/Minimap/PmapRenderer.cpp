@@ -1,13 +1,170 @@
 #include "stdafx.h"
 
+#include <GWCA/Constants/Maps.h>
 #include <GWCA/GameContainers/Array.h>
 #include <GWCA/GameEntities/Pathing.h>
 
 #include <GWCA/Managers/MapMgr.h>
 
+#include <Modules/Resources.h>
 #include <Widgets/Minimap/D3DVertex.h>
+#include <Widgets/Minimap/MinimapGeometry.h>
 #include <Widgets/Minimap/PmapRenderer.h>
 
+namespace {
+    constexpr uint32_t mesh_cache_version = 1;
+
+    struct Trapezoid {
+        float XTL, XTR, YT;
+        float XBL, XBR, YB;
+    };
+
+    // True if b lies on the line through a and c; used to check that stacking two trapezoids keeps the sides straight
+    bool IsCollinear(const GW::Vec2f& a, const GW::Vec2f& b, const GW::Vec2f& c)
+    {
+        const float ab_x = b.x - a.x;
+        const float ab_y = b.y - a.y;
+        const float bc_x = c.x - b.x;
+        const float bc_y = c.y - b.y;
+        const float cross = ab_x * bc_y - ab_y * bc_x;
+        return std::abs(cross) <= 1e-4f * std::hypot(ab_x, ab_y) * std::hypot(bc_x, bc_y);
+    }
+
+    // Merge neighbouring trapezoids into larger ones; the union of two trapezoids that share a full edge is still a trapezoid
+    // as long as the sides stay straight, so the resulting mesh covers exactly the same area with fewer triangles.
+    void MergeTrapezoids(std::vector<Trapezoid>& trapezoids)
+    {
+        // Side by side: same vertical span, right edge of one is the left edge of the next
+        std::ranges::sort(trapezoids, [](const Trapezoid& a, const Trapezoid& b) {
+            return std::tie(a.YT, a.YB, a.XTL) < std::tie(b.YT, b.YB, b.XTL);
+        });
+        std::vector<Trapezoid> merged;
+        merged.reserve(trapezoids.size());
+        for (const Trapezoid& trap : trapezoids) {
+            if (!merged.empty()) {
+                Trapezoid& last = merged.back();
+                if (last.YT == trap.YT && last.YB == trap.YB && last.XTR == trap.XTL && last.XBR == trap.XBL) {
+                    last.XTR = trap.XTR;
+                    last.XBR = trap.XBR;
+                    continue;
+                }
+            }
+            merged.push_back(trap);
+        }
+
+        // Stacked: bottom edge of one is the top edge of the other, and both sides continue in a straight line
+        using Edge = std::tuple<float, float, float>;
+        std::map<Edge, size_t> by_top_edge;
+        for (size_t i = 0; i < merged.size(); i++) {
+            by_top_edge.emplace(Edge{merged[i].YT, merged[i].XTL, merged[i].XTR}, i);
+        }
+        std::vector<bool> consumed(merged.size(), false);
+        for (size_t i = 0; i < merged.size(); i++) {
+            if (consumed[i]) {
+                continue;
+            }
+            Trapezoid& trap = merged[i];
+            while (true) {
+                const auto found = by_top_edge.find(Edge{trap.YB, trap.XBL, trap.XBR});
+                if (found == by_top_edge.end() || found->second == i || consumed[found->second]) {
+                    break;
+                }
+                const Trapezoid& below = merged[found->second];
+                if (!IsCollinear({trap.XTL, trap.YT}, {trap.XBL, trap.YB}, {below.XBL, below.YB})
+                    || !IsCollinear({trap.XTR, trap.YT}, {trap.XBR, trap.YB}, {below.XBR, below.YB})) {
+                    break;
+                }
+                consumed[found->second] = true;
+                trap.XBL = below.XBL;
+                trap.XBR = below.XBR;
+                trap.YB = below.YB;
+            }
+        }
+        trapezoids.clear();
+        for (size_t i = 0; i < merged.size(); i++) {
+            if (!consumed[i]) {
+                trapezoids.push_back(merged[i]);
+            }
+        }
+    }
+
+    // Triangle 1: (XTL, YT) (XTR, YT), (XBL, YB)
+    // Triangle 2: (XBL, YB), (XTR, YT), (XBR, YB)
+    // Triangles with no area (trapezoids that narrow to a point) are skipped
+    std::vector<GW::Vec2f> BuildMesh(const std::vector<Trapezoid>& trapezoids)
+    {
+        std::vector<GW::Vec2f> mesh;
+        mesh.reserve(trapezoids.size() * 6);
+        for (const Trapezoid& trap : trapezoids) {
+            if (trap.XTL != trap.XTR) {
+                mesh.emplace_back(trap.XTL, trap.YT);
+                mesh.emplace_back(trap.XTR, trap.YT);
+                mesh.emplace_back(trap.XBL, trap.YB);
+            }
+            if (trap.XBL != trap.XBR) {
+                mesh.emplace_back(trap.XBL, trap.YB);
+                mesh.emplace_back(trap.XTR, trap.YT);
+                mesh.emplace_back(trap.XBR, trap.YB);
+            }
+        }
+        return mesh;
+    }
+
+    std::filesystem::path GetMeshCachePath(const GW::Constants::MapID map_id)
+    {
+        return Resources::GetPath(L"pathing cache", std::format(L"{}.bin", static_cast<uint32_t>(map_id)));
+    }
+
+    struct MeshCacheHeader {
+        uint32_t version;
+        uint32_t source_trapezoid_count; // to spot a cache from a different version of the map
+        uint32_t vertex_count;
+    };
+
+    bool LoadMeshCache(const GW::Constants::MapID map_id, const size_t trapezoid_count, std::vector<GW::Vec2f>& out)
+    {
+        std::ifstream file(GetMeshCachePath(map_id), std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            return false;
+        }
+        const auto file_size = static_cast<size_t>(file.tellg());
+        if (file_size < sizeof(MeshCacheHeader)) {
+            return false;
+        }
+        std::vector<char> bytes(file_size);
+        file.seekg(0);
+        if (!file.read(bytes.data(), static_cast<std::streamsize>(file_size))) {
+            return false;
+        }
+        MeshCacheHeader header{};
+        memcpy(&header, bytes.data(), sizeof(header));
+        if (header.version != mesh_cache_version
+            || header.source_trapezoid_count != trapezoid_count
+            || file_size != sizeof(header) + header.vertex_count * sizeof(GW::Vec2f)) {
+            return false;
+        }
+        out.resize(header.vertex_count);
+        memcpy(out.data(), bytes.data() + sizeof(header), header.vertex_count * sizeof(GW::Vec2f));
+        return true;
+    }
+
+    void SaveMeshCache(const GW::Constants::MapID map_id, const size_t trapezoid_count, const std::vector<GW::Vec2f>& mesh)
+    {
+        Resources::EnqueueWorkerTask([path = GetMeshCachePath(map_id), trapezoid_count, mesh] {
+            if (!Resources::EnsureFolderExists(path.parent_path())) {
+                return;
+            }
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                Log::Log("PmapRenderer: failed to write %ls", path.c_str());
+                return;
+            }
+            const MeshCacheHeader header = {mesh_cache_version, static_cast<uint32_t>(trapezoid_count), static_cast<uint32_t>(mesh.size())};
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(mesh.data()), static_cast<std::streamsize>(mesh.size() * sizeof(GW::Vec2f)));
+        });
+    }
+}
 
 void PmapRenderer::LoadSettings(const ToolboxIni* ini, const char* section)
 {
@@ -44,127 +201,79 @@ void PmapRenderer::DrawSettings()
     }
 }
 
-void PmapRenderer::Initialize(IDirect3DDevice9* device)
+bool PmapRenderer::LoadMesh()
 {
-    //#define WIREFRAME_MODE
-
-    GW::PathingMapArray* path_map;
-    if (GW::Map::GetIsMapLoaded()) {
-        path_map = GW::Map::GetPathingMap();
-    }
-    else {
-        initialized = false;
-        return; // no map loaded yet, so don't render anything
+    const GW::PathingMapArray* path_map = GW::Map::GetIsMapLoaded() ? GW::Map::GetPathingMap() : nullptr;
+    if (!path_map) {
+        return false;
     }
-    const bool shadow_show = (color_mapshadow & IM_COL32_A_MASK) > 0;
+    const auto map_id = GW::Map::GetMapID();
 
-    // get the number of trapezoids, need it to allocate the vertex buffer
+    // get the number of trapezoids, cheap to work out and tells us if the cached mesh still matches the map
     trapez_count_ = 0;
     for (const GW::PathingMap& map : *path_map) {
         trapez_count_ += map.trapezoid_count;
     }
+    if (mesh_map_id_ == map_id && mesh_trapez_count_ == trapez_count_) {
+        return true;
+    }
+    mesh_.clear();
+    mesh_map_id_ = map_id;
+    mesh_trapez_count_ = trapez_count_;
     if (trapez_count_ == 0) {
-        return;
+        return true;
     }
 
-#ifdef WIREFRAME_MODE
-
-    total_tri_count_ = tri_count_ = trapez_count_ * 4;
-    if (shadow_show) total_tri_count_ = tri_count_ * 2;
-
-    vert_count_ = tri_count_ * 2;
-    total_vert_count_ = total_tri_count_ * 2;
-
-#else
-
-    total_tri_count_ = tri_count_ = trapez_count_ * 2;
-    if (shadow_show) {
-        total_tri_count_ = tri_count_ * 2;
+    if (LoadMeshCache(map_id, trapez_count_, mesh_)) {
+        return true;
     }
 
-    vert_count_ = tri_count_ * 3;
-    total_vert_count_ = total_tri_count_ * 3;
-
-#endif
-
-    D3DVertex* vertices = nullptr;
-
-    // allocate new vertex buffer
-    if (buffer) {
-        buffer->Release();
+    std::vector<Trapezoid> trapezoids;
+    trapezoids.reserve(trapez_count_);
+    for (const GW::PathingMap& pmap : *path_map) {
+        for (size_t j = 0; j < pmap.trapezoid_count; ++j) {
+            const GW::PathingTrapezoid& trap = pmap.trapezoids[j];
+            trapezoids.push_back({trap.XTL, trap.XTR, trap.YT, trap.XBL, trap.XBR, trap.YB});
+        }
     }
-    device->CreateVertexBuffer(sizeof(D3DVertex) * total_vert_count_, D3DUSAGE_WRITEONLY,
-                               D3DFVF_CUSTOMVERTEX, D3DPOOL_MANAGED, &buffer, nullptr);
-    buffer->Lock(0, sizeof(D3DVertex) * total_vert_count_,
-                 reinterpret_cast<void**>(&vertices), D3DLOCK_DISCARD);
-
-    D3DVertex* vertices_begin = vertices;
-
-#ifdef WIREFRAME_MODE
-    type = D3DPT_LINELIST;
-
-    // populate vertex buffer
-    for (autok = 0; k < (shadow_show ? 2 : 1); ++k) {
-        for (size_t i = 0; i < path_map.size(); i++) {
-            GW::PathingMap pmap = path_map[i];
-            for (size_t j = 0; j < pmap.trapezoid_count; ++j) {
-                GW::PathingTrapezoid& trap = pmap.trapezoids[j];
-                vertices[0].x = trap.XTL; vertices[0].y = trap.YT;
-                vertices[1].x = trap.XTR; vertices[1].y = trap.YT;
-
-                vertices[2].x = trap.XTR; vertices[2].y = trap.YT;
-                vertices[3].x = trap.XBR; vertices[3].y = trap.YB;
+    MergeTrapezoids(trapezoids);
+    mesh_ = BuildMesh(trapezoids);
+    SaveMeshCache(map_id, trapez_count_, mesh_);
+    return true;
+}
 
-                vertices[4].x = trap.XBR; vertices[4].y = trap.YB;
-                vertices[5].x = trap.XBL; vertices[5].y = trap.YB;
+void PmapRenderer::Initialize(IDirect3DDevice9* device)
+{
+    if (!LoadMesh()) {
+        initialized = false;
+        return; // no map loaded yet, so don't render anything
+    }
+    if (mesh_.empty()) {
+        vert_count_ = tri_count_ = total_vert_count_ = total_tri_count_ = 0;
+        return;
+    }
+    const bool shadow_show = (color_mapshadow & IM_COL32_A_MASK) > 0;
 
-                vertices[6].x = trap.XBL; vertices[6].y = trap.YB;
-                vertices[7].x = trap.XTL; vertices[7].y = trap.YT;
+    // The mesh is colour independent; colours are patched into a fresh copy of the vertices, so a colour change never touches the pathing map
+    vert_count_ = mesh_.size();
+    tri_count_ = vert_count_ / 3;
+    total_vert_count_ = shadow_show ? vert_count_ * 2 : vert_count_;
+    total_tri_count_ = total_vert_count_ / 3;
 
-                vertices += 8;
-            }
-        }
-    }
-#else
     type = D3DPT_TRIANGLELIST;
 
-    // populate vertex buffer
-    for (auto k = 0; k < (shadow_show ? 2 : 1); ++k) {
-        for (const GW::PathingMap& pmap : *path_map) {
-            for (size_t j = 0; j < pmap.trapezoid_count; ++j) {
-                GW::PathingTrapezoid& trap = pmap.trapezoids[j];
-
-                vertices[0].x = trap.XTL;
-                vertices[0].y = trap.YT;
-                vertices[1].x = trap.XTR;
-                vertices[1].y = trap.YT;
-                vertices[2].x = trap.XBL;
-                vertices[2].y = trap.YB;
-
-                vertices[3].x = trap.XBL;
-                vertices[3].y = trap.YB;
-                vertices[4].x = trap.XTR;
-                vertices[4].y = trap.YT;
-                vertices[5].x = trap.XBR;
-                vertices[5].y = trap.YB;
-                vertices += 6;
-            }
-        }
-    }
-#endif
+    std::vector<D3DVertex> vertices;
+    vertices.reserve(total_vert_count_);
 
-    vertices = vertices_begin;
-    for (auto i = 0u; i < total_vert_count_; i++) {
-        vertices[i].z = 0.0f;
-        if (shadow_show && i < vert_count_) {
-            vertices[i].color = color_mapshadow;
-        }
-        else {
-            vertices[i].color = color_map;
+    // shadow batch first (if any), then the map itself
+    for (auto k = 0; k < (shadow_show ? 2 : 1); ++k) {
+        const Color color = shadow_show && k == 0 ? color_mapshadow : color_map;
+        for (const GW::Vec2f& pos : mesh_) {
+            MinimapGeometry::AppendVertex(vertices, pos.x, pos.y, color);
         }
     }
 
-    buffer->Unlock();
+    Upload(device, vertices);
 }
 
 void PmapRenderer::Render(IDirect3DDevice9* device)
@@ -173,6 +282,9 @@ void PmapRenderer::Render(IDirect3DDevice9* device)
         initialized = true;
         Initialize(device);
     }
+    if (!buffer || tri_count_ == 0) {
+        return;
+    }
 
     if ((color_mapshadow & IM_COL32_A_MASK) > 0) {
         D3DMATRIX oldview;
@@ -1,12 +1,16 @@
 #pragma once
 
+#include <GWCA/GameContainers/GamePos.h>
+
 #include <Color.h>
 #include <Widgets/Minimap/VBuffer.h>
 
+namespace GW::Constants {
+    enum class MapID : uint32_t;
+}
+
 class PmapRenderer : public VBuffer {
 public:
-    // Triangle 1: (XTL, YT) (XTR, YT), (XBL, YB)
-    // Triangle 2: (XBL, YB), (XTR, YT), (XBR, YB)
     void Render(IDirect3DDevice9* device) override;
 
     void DrawSettings();
@@ -18,6 +22,10 @@ protected:
     void Initialize(IDirect3DDevice9* device) override;
 
 private:
+    // Make sure mesh_ matches the current map; from the disk cache if possible, otherwise built from the pathing map and cached.
+    // False if no map is loaded.
+    bool LoadMesh();
+
     Color color_map = 0;
     Color color_mapshadow = 0;
     Color color_mapbackground = 0;
@@ -27,4 +35,9 @@ private:
     size_t total_tri_count_ = 0; // including shadow
     size_t vert_count_ = 0;
     size_t total_vert_count_ = 0; // including shadow
+
+    // Triangle list of the map outline, without colour; merged trapezoids, 2 triangles each
+    std::vector<GW::Vec2f> mesh_{};
+    GW::Constants::MapID mesh_map_id_{};
+    size_t mesh_trapez_count_ = 0;
 };
@@ -11,6 +11,7 @@
 #include <GWCA/Managers/MapMgr.h>
 #include <GWCA/Managers/SkillbarMgr.h>
 
+#include <Widgets/Minimap/MinimapGeometry.h>
 #include <Widgets/Minimap/RangeRenderer.h>
 
 #include "Minimap.h"
@@ -78,21 +79,12 @@ void RangeRenderer::DrawSettings()
     }
 }
 
-size_t RangeRenderer::CreateCircle(D3DVertex* vertices, const float radius, const DWORD color) const
+void RangeRenderer::CreateCircle(std::vector<D3DVertex>& vertices, const float radius, const DWORD color) const
 {
     const auto scale = Minimap::GetGwinchScale();
     const auto xdiff = static_cast<float>(line_thickness) / scale.x;
     const auto ydiff = static_cast<float>(line_thickness) / scale.y;
-    for (auto i = 0; i <= circle_triangles; i += 2) {
-        const auto angle = i / static_cast<float>(circle_triangles) * DirectX::XM_2PI;
-        vertices[i].x = radius * cos(angle);
-        vertices[i].y = radius * sin(angle);
-        vertices[i + 1].x = (radius - xdiff) * cos(angle);
-        vertices[i + 1].y = (radius - ydiff) * sin(angle);
-        vertices[i].z = vertices[i + 1].z = 0.0f;
-        vertices[i].color = vertices[i + 1].color = color;
-    }
-    return circle_points;
+    MinimapGeometry::AppendRing(vertices, radius, xdiff, ydiff, circle_points, color);
 }
 
 void RangeRenderer::Initialize(IDirect3DDevice9* device)
@@ -107,65 +99,36 @@ void RangeRenderer::Initialize(IDirect3DDevice9* device)
     checkforhos_ = true;
     havehos_ = false;
 
-    D3DVertex* vertices = nullptr;
-    const size_t vertex_count = count + 6;
-
-    device->CreateVertexBuffer(sizeof(D3DVertex) * vertex_count, D3DUSAGE_WRITEONLY, D3DFVF_CUSTOMVERTEX, D3DPOOL_MANAGED, &buffer, nullptr);
-    buffer->Lock(0, sizeof(D3DVertex) * vertex_count, reinterpret_cast<void**>(&vertices), D3DLOCK_DISCARD);
-    ASSERT(vertices != nullptr);
-
-    const D3DVertex* vertices_max = vertices + vertex_count;
+    std::vector<D3DVertex> vertices;
+    vertices.reserve(count + 6);
 
     // Compass range
-    float radius = GW::Constants::Range::Compass;
-    vertices += CreateCircle(vertices, radius, color_range_compass);
-    ASSERT(vertices < vertices_max);
-
+    CreateCircle(vertices, GW::Constants::Range::Compass, color_range_compass);
     // Spirit range
-    radius = GW::Constants::Range::Spirit;
-    vertices += CreateCircle(vertices, radius, color_range_spirit);
-    ASSERT(vertices < vertices_max);
-
+    CreateCircle(vertices, GW::Constants::Range::Spirit, color_range_spirit);
     // Spellcast range
-    radius = GW::Constants::Range::Spellcast;
-    vertices += CreateCircle(vertices, radius, color_range_cast);
-    ASSERT(vertices < vertices_max);
-
+    CreateCircle(vertices, GW::Constants::Range::Spellcast, color_range_cast);
     // Aggro range
-    radius = GW::Constants::Range::Earshot;
-    vertices += CreateCircle(vertices, radius, color_range_aggro);
-    ASSERT(vertices < vertices_max);
-
+    CreateCircle(vertices, GW::Constants::Range::Earshot, color_range_aggro);
     // HoS range
-    radius = 360.0f;
-    vertices += CreateCircle(vertices, radius, color_range_hos);
-    ASSERT(vertices < vertices_max);
-
+    CreateCircle(vertices, 360.0f, color_range_hos);
     // Chain aggro range
-    radius = 700.f;
-    vertices += CreateCircle(vertices, radius, color_range_chain_aggro);
-    ASSERT(vertices < vertices_max);
-
+    CreateCircle(vertices, 700.f, color_range_chain_aggro);
     // Res aggro range
-    radius = GW::Constants::Range::Earshot;
-    vertices += CreateCircle(vertices, radius, color_range_res_aggro);
-    ASSERT(vertices < vertices_max);
-
+    CreateCircle(vertices, GW::Constants::Range::Earshot, color_range_res_aggro);
     // Shadowstep location aggro range
-    radius = GW::Constants::Range::Earshot;
-    vertices += CreateCircle(vertices, radius, color_range_shadowstep_aggro);
-    ASSERT(vertices < vertices_max);
+    CreateCircle(vertices, GW::Constants::Range::Earshot, color_range_shadowstep_aggro);
+    ASSERT(vertices.size() == count);
 
     // HoS line
-    ASSERT(vertices + 5 < vertices_max);
-    vertices[0] = {260.f, 0.f, 0.f, color_range_hos};
-    vertices[1] = {460.f, 0.f, 0.f, color_range_hos};
-    vertices[2] = {-150.f, 0.f, 0.f, color_range_hos};
-    vertices[3] = {150, 0.f, 0.f, color_range_hos};
-    vertices[4] = {0, -150.f, 0.f, color_range_hos};
-    vertices[5] = {0.f, 150.f, 0.f, color_range_hos};
-
-    buffer->Unlock();
+    MinimapGeometry::AppendVertex(vertices, 260.f, 0.f, color_range_hos);
+    MinimapGeometry::AppendVertex(vertices, 460.f, 0.f, color_range_hos);
+    MinimapGeometry::AppendVertex(vertices, -150.f, 0.f, color_range_hos);
+    MinimapGeometry::AppendVertex(vertices, 150.f, 0.f, color_range_hos);
+    MinimapGeometry::AppendVertex(vertices, 0.f, -150.f, color_range_hos);
+    MinimapGeometry::AppendVertex(vertices, 0.f, 150.f, color_range_hos);
+
+    Upload(device, vertices);
 }
 
 void RangeRenderer::Render(IDirect3DDevice9* device)
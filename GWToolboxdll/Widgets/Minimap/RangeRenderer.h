@@ -16,8 +16,8 @@ public:
     void LoadSettings(const ToolboxIni* ini, const char* section);
     void SaveSettings(ToolboxIni* ini, const char* section) const;
     void LoadDefaults();
-    // Returns number of vertices used.
-    size_t CreateCircle(D3DVertex* vertices, float radius, DWORD color) const;
+    // Appends circle_points vertices.
+    void CreateCircle(std::vector<D3DVertex>& vertices, float radius, DWORD color) const;
 
 private:
     void Initialize(IDirect3DDevice9* device) override;
@@ -12,6 +12,7 @@
 
 #include <GWCA/Managers/QuestMgr.h>
 #include <Widgets/Minimap/Minimap.h>
+#include <Widgets/Minimap/MinimapGeometry.h>
 #include <Widgets/Minimap/SymbolsRenderer.h>
 
 void SymbolsRenderer::LoadSettings(const ToolboxIni* ini, const char* section)
@@ -66,21 +67,13 @@ void SymbolsRenderer::Initialize(IDirect3DDevice9* device)
     initialized = true;
     type = D3DPT_TRIANGLELIST;
 
-    D3DVertex* vertices = nullptr;
     const DWORD vertex_count = (star_ntriangles + arrow_ntriangles + other_arrow_ntriangles + other_star_ntriangles + north_ntriangles) * 3;
+    std::vector<D3DVertex> vertices;
+    vertices.reserve(vertex_count);
     DWORD offset = 0;
 
-    device->CreateVertexBuffer(sizeof(D3DVertex) * vertex_count, D3DUSAGE_WRITEONLY,
-                               D3DFVF_CUSTOMVERTEX, D3DPOOL_MANAGED, &buffer, nullptr);
-    buffer->Lock(0, sizeof(D3DVertex) * vertex_count,
-                 reinterpret_cast<void**>(&vertices), D3DLOCK_DISCARD);
-
     const auto add_vertex = [&vertices, &offset](const float x, const float y, const Color color) -> void {
-        vertices[0].x = x;
-        vertices[0].y = y;
-        vertices[0].z = 0.0f;
-        vertices[0].color = color;
-        ++vertices;
+        MinimapGeometry::AppendVertex(vertices, x, y, color);
         ++offset;
     };
 
@@ -142,8 +135,9 @@ void SymbolsRenderer::Initialize(IDirect3DDevice9* device)
     add_vertex(0.0f, 0.0f, color_north);
     add_vertex(-250.0f, -500.0f, color_north);
     add_vertex(0.0f, -375.0f, Colors::Add(color_north, color_modifier));
+    ASSERT(vertices.size() == vertex_count);
 
-    buffer->Unlock();
+    Upload(device, vertices);
 }
 
 void SymbolsRenderer::Invalidate()
@@ -8,7 +8,7 @@ that is necessary to render the vertex buffer.
 
 classes implementing this class only need to implement Initialize which
 should contain code that:
-- populates the vertex buffer "buffer_"
+- generates its vertices into a plain array (see MinimapGeometry.h) and passes them to Upload()
 - sets the primitive type "type_"
 - sets the primitive count "count_"
 
@@ -27,6 +27,7 @@ public:
             buffer->Release();
         }
         buffer = nullptr;
+        buffer_capacity = 0;
         initialized = false;
     }
 
@@ -50,7 +51,43 @@ public:
     virtual void Initialize(IDirect3DDevice9* device) = 0;
 
 protected:
+    // Copy vertices generated on the CPU into "buffer", (re)creating it if it's too small.
+    // This is the only point where geometry touches the device; pass dynamic = true for geometry that is regenerated every frame.
+    bool Upload(IDirect3DDevice9* device, const std::vector<D3DVertex>& vertices, const bool dynamic = false)
+    {
+        if (vertices.empty()) {
+            return true;
+        }
+        if (buffer && buffer_capacity < vertices.size()) {
+            buffer->Release();
+            buffer = nullptr;
+        }
+        if (!buffer) {
+            // Leave some headroom for per-frame geometry so that the buffer isn't recreated every time it grows by a few vertices
+            const size_t capacity = dynamic ? std::max<size_t>(vertices.size() + vertices.size() / 2, 0x100) : vertices.size();
+            const HRESULT hr = device->CreateVertexBuffer(sizeof(D3DVertex) * capacity, dynamic ? 0 : D3DUSAGE_WRITEONLY,
+                                                          D3DFVF_CUSTOMVERTEX, D3DPOOL_MANAGED, &buffer, nullptr);
+            if (FAILED(hr)) {
+                printf("VBuffer CreateVertexBuffer() error: HRESULT: 0x%lX\n", hr);
+                buffer = nullptr;
+                buffer_capacity = 0;
+                return false;
+            }
+            buffer_capacity = capacity;
+        }
+        void* mem = nullptr;
+        const HRESULT hr = buffer->Lock(0, sizeof(D3DVertex) * vertices.size(), &mem, 0);
+        if (FAILED(hr) || !mem) {
+            printf("VBuffer Lock() error: HRESULT: 0x%lX\n", hr);
+            return false;
+        }
+        memcpy(mem, vertices.data(), sizeof(D3DVertex) * vertices.size());
+        buffer->Unlock();
+        return true;
+    }
+
     IDirect3DVertexBuffer9* buffer = nullptr;
+    size_t buffer_capacity = 0;
     D3DPRIMITIVETYPE type = D3DPT_TRIANGLELIST;
     unsigned long count = 0;
     bool initialized = false;
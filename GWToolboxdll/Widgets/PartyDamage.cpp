@@ -2,10 +2,14 @@
 #include "stdafx.h"
 #include "Timer.h"
 
+#include <atomic>
+
 #include <GWCA/GameEntities/Agent.h>
+#include <GWCA/GameEntities/Skill.h>
 
 #include <GWCA/Managers/MapMgr.h>
 #include <GWCA/Managers/ChatMgr.h>
+#include <GWCA/Managers/GameThreadMgr.h>
 #include <GWCA/Managers/StoCMgr.h>
 #include <GWCA/Managers/AgentMgr.h>
 #include <GWCA/Managers/UIMgr.h>
@@ -15,6 +19,8 @@
 
 #include <Modules/Resources.h>
 #include <Modules/ToolboxSettings.h>
+#include <Utils/GenericPacketBus.h>
+#include <Utils/TextureAtlas.h>
 #include <Widgets/PartyDamage.h>
 
 constexpr const wchar_t* INI_FILENAME = L"healthlog.ini";
@@ -27,8 +33,33 @@ namespace {
 
     uint32_t total = 0;
 
-    std::map<DWORD, uint32_t> hp_map{};
-    
+    // Last known max hp, indexed by player_number (model id for npcs); 0 if unknown.
+    // Grown on demand, player numbers past max_hp_cache_size are approximated instead of cached.
+    constexpr size_t max_hp_cache_size = 0x10000;
+    std::vector<uint32_t> max_hp_by_player_number{};
+
+    uint32_t GetCachedMaxHp(const uint32_t player_number)
+    {
+        return player_number < max_hp_by_player_number.size() ? max_hp_by_player_number[player_number] : 0;
+    }
+
+    void SetCachedMaxHp(const uint32_t player_number, const uint32_t max_hp)
+    {
+        if (player_number >= max_hp_cache_size) {
+            return;
+        }
+        if (player_number >= max_hp_by_player_number.size()) {
+            max_hp_by_player_number.resize(player_number + 1, 0);
+        }
+        max_hp_by_player_number[player_number] = max_hp;
+    }
+
+    // Damage dealt within this long after a party member activates (or finishes) a skill is attributed to that skill
+    constexpr clock_t skill_attribution_time = 2000;
+    // Number of distinct skills tracked per party member; any further skills are counted with attacks and other sources
+    constexpr size_t max_tracked_skills = 12;
+    // Upper bound for dps_window, in seconds
+    constexpr int max_dps_window = 60;
 
     // main routine variables
     bool in_explorable = false;
@@ -43,6 +74,11 @@ namespace {
     float width = 100.0f;
     bool bars_left = true;
     int recent_max_time = 7000;
+    // Setting, as shown and changed in the UI; the game thread works with game_dps_window, updated through ApplyDpsWindow
+    int dps_window = 10;
+    int game_dps_window = 10;
+    bool show_dps = false;
+    bool show_skill_breakdown = true;
     bool hide_in_outpost = false;
     bool print_by_click = false;
 
@@ -50,6 +86,7 @@ namespace {
     int user_offset = 0;
 
     GW::HookEntry GenericModifier_Entry;
+    GW::HookEntry SkillPacket_Entry;
     GW::HookEntry MapLoaded_Entry;
 
     float GetPartOfTotal(uint32_t dmg) {
@@ -64,6 +101,11 @@ namespace {
 }
 
 struct PartyDamage::PlayerDamage {
+    struct SkillDamage {
+        GW::Constants::SkillID skill_id = GW::Constants::SkillID::No_Skill;
+        uint32_t damage = 0;
+    };
+
     uint32_t damage = 0;
     uint32_t recent_damage = 0;
     clock_t last_damage = 0;
@@ -71,6 +113,20 @@ struct PartyDamage::PlayerDamage {
     GW::Constants::Profession primary = GW::Constants::Profession::None;
     GW::Constants::Profession secondary = GW::Constants::Profession::None;
 
+    // Damage by skill; the first entry is always No_Skill, which collects attacks and anything else that can't be attributed
+    std::array<SkillDamage, max_tracked_skills + 1> skills{};
+    size_t skill_count = 1;
+    GW::Constants::SkillID last_skill_id = GW::Constants::SkillID::No_Skill;
+    clock_t last_skill_time = 0;
+
+    // Damage per second of the last game_dps_window seconds, kept as a ring of per second buckets plus their running sum.
+    // Game thread only; the result is published to dps for Draw to read.
+    std::array<uint32_t, max_dps_window> damage_by_second{};
+    clock_t window_second = 0;
+    uint32_t window_damage = 0;
+    // Only accessed through std::atomic_ref, so that the entry stays copyable
+    float dps = 0.f;
+
     void Reset()
     {
         damage = 0;
@@ -78,6 +134,89 @@ struct PartyDamage::PlayerDamage {
         agent_id = 0;
         primary = GW::Constants::Profession::None;
         secondary = GW::Constants::Profession::None;
+        skills = {};
+        skill_count = 1;
+        last_skill_id = GW::Constants::SkillID::No_Skill;
+        last_skill_time = 0;
+        ResetWindow();
+    }
+
+    void ResetWindow()
+    {
+        damage_by_second = {};
+        window_second = 0;
+        window_damage = 0;
+        PublishDps();
+    }
+
+    // Moves the dps window up to the given second, dropping the buckets that fall out of it
+    void AdvanceWindow(const clock_t second)
+    {
+        if (second <= window_second) {
+            return;
+        }
+        if (second - window_second >= game_dps_window) {
+            damage_by_second = {};
+            window_damage = 0;
+        }
+        else {
+            for (auto s = window_second + 1; s <= second; s++) {
+                auto& bucket = damage_by_second[s % game_dps_window];
+                window_damage -= bucket;
+                bucket = 0;
+            }
+        }
+        window_second = second;
+    }
+
+    void PublishDps()
+    {
+        std::atomic_ref(dps).store(static_cast<float>(window_damage) / game_dps_window, std::memory_order_relaxed);
+    }
+
+    // Game thread; called every frame, so that the window keeps moving while no damage is dealt
+    void UpdateDps(const clock_t now)
+    {
+        AdvanceWindow(now / CLOCKS_PER_SEC);
+        PublishDps();
+    }
+
+    // Any thread
+    [[nodiscard]] float GetDps()
+    {
+        return std::atomic_ref(dps).load(std::memory_order_relaxed);
+    }
+
+    void OnSkillUsed(const GW::Constants::SkillID skill_id, const clock_t now)
+    {
+        last_skill_id = skill_id;
+        last_skill_time = now;
+    }
+
+    void AddDamage(const uint32_t dmg, const clock_t now)
+    {
+        damage += dmg;
+        recent_damage += dmg;
+        last_damage = now;
+
+        AdvanceWindow(now / CLOCKS_PER_SEC);
+        damage_by_second[window_second % game_dps_window] += dmg;
+        window_damage += dmg;
+        PublishDps();
+
+        const auto skill_id = now - last_skill_time <= skill_attribution_time ? last_skill_id : GW::Constants::SkillID::No_Skill;
+        auto* skill_damage = &skills[0];
+        for (size_t i = 1; i < skill_count; i++) {
+            if (skills[i].skill_id == skill_id) {
+                skill_damage = &skills[i];
+                break;
+            }
+        }
+        if (skill_damage == &skills[0] && skill_id != GW::Constants::SkillID::No_Skill && skill_count < skills.size()) {
+            skill_damage = &skills[skill_count++];
+            skill_damage->skill_id = skill_id;
+        }
+        skill_damage->damage += dmg;
     }
 };
 
@@ -151,23 +290,14 @@ void PartyDamage::MapLoadedCallback(GW::HookStatus*, const GW::Packet::StoC::Map
     }
 }
 
-void PartyDamage::DamagePacketCallback(GW::HookStatus*, const GW::Packet::StoC::GenericModifier* packet)
+void PartyDamage::DamagePacketCallback(GW::HookStatus*, const GenericPacketBus::Event& packet)
 {
-    // ignore non-damage packets
-    switch (packet->type) {
-    case GW::Packet::StoC::P156_Type::damage:
-    case GW::Packet::StoC::P156_Type::critical:
-    case GW::Packet::StoC::P156_Type::armorignoring:
-        break;
-    default:
-        return;
-    }
-
+    // NB: only damage packets are subscribed to; see Initialize()
     // ignore heals
-    if (packet->value >= 0) {
+    if (packet.float_value >= 0) {
         return;
     }
-    const auto cause = static_cast<GW::AgentLiving*>(GW::Agents::GetAgentByID(packet->cause_id));
+    const auto cause = static_cast<GW::AgentLiving*>(GW::Agents::GetAgentByID(packet.caster_id));
     if (!(cause && cause->GetIsLivingType()))
         return; // Ignore damage caused by non-living agents
     if (cause->allegiance != GW::Constants::Allegiance::Ally_NonAttackable)
@@ -177,7 +307,7 @@ void PartyDamage::DamagePacketCallback(GW::HookStatus*, const GW::Packet::StoC::
     if (!entry)
         return;
 
-    const auto target = static_cast<GW::AgentLiving*>(GW::Agents::GetAgentByID(packet->target_id));
+    const auto target = static_cast<GW::AgentLiving*>(GW::Agents::GetAgentByID(packet.target_id));
     if (!(target && target->GetIsLivingType()))
         return; // Ignore damage inflicted on non-living agents
     if (target->login_number != 0)
@@ -191,34 +321,50 @@ void PartyDamage::DamagePacketCallback(GW::HookStatus*, const GW::Packet::StoC::
 
     long ldmg;
     if (target->max_hp > 0 && target->max_hp < 100000) {
-        ldmg = std::lround(-packet->value * target->max_hp);
-        hp_map[target->player_number] = target->max_hp;
+        ldmg = std::lround(-packet.float_value * target->max_hp);
+        SetCachedMaxHp(target->player_number, target->max_hp);
+    }
+    else if (const auto max_hp = GetCachedMaxHp(target->player_number)) {
+        ldmg = std::lround(-packet.float_value * max_hp);
     }
     else {
-        const auto it = hp_map.find(target->player_number);
-        if (it == hp_map.end()) {
-            // max hp not found, approximate with hp/lvl formula
-            ldmg = std::lround(-packet->value * (target->level * 20 + 100));
-        }
-        else {
-            // size_t maxhp = it->second;
-            ldmg = std::lround(-packet->value * it->second);
-        }
+        // max hp not found, approximate with hp/lvl formula
+        ldmg = std::lround(-packet.float_value * (target->level * 20 + 100));
     }
 
     const uint32_t dmg = static_cast<uint32_t>(ldmg);
 
     if (entry->damage == 0) {
-        entry->agent_id = packet->cause_id;
+        entry->agent_id = packet.caster_id;
         entry->primary = static_cast<GW::Constants::Profession>(cause->primary);
         entry->secondary = static_cast<GW::Constants::Profession>(cause->secondary);
     }
 
-    entry->damage += dmg;
+    entry->AddDamage(dmg, TIMER_INIT());
     total += dmg;
+}
 
-    entry->recent_damage += dmg;
-    entry->last_damage = TIMER_INIT();
+void PartyDamage::SkillCallback(const uint32_t value_id, const uint32_t caster_id, const uint32_t value)
+{
+    switch (value_id) {
+        case GW::Packet::StoC::GenericValueID::instant_skill_activated:
+        case GW::Packet::StoC::GenericValueID::skill_activated:
+        case GW::Packet::StoC::GenericValueID::skill_finished:
+        case GW::Packet::StoC::GenericValueID::attack_skill_activated:
+        case GW::Packet::StoC::GenericValueID::attack_skill_finished:
+            break;
+        default:
+            return;
+    }
+    const auto entry = GetDamageByAgentId(caster_id);
+    if (!entry) {
+        return;
+    }
+    // Finish packets don't carry the skill id; keep the one that was activated
+    const auto skill_id = value_id == GW::Packet::StoC::GenericValueID::skill_finished || value_id == GW::Packet::StoC::GenericValueID::attack_skill_finished
+                              ? entry->last_skill_id
+                              : static_cast<GW::Constants::SkillID>(value);
+    entry->OnSkillUsed(skill_id, TIMER_INIT());
 }
 
 void PartyDamage::ResetDamage()
@@ -281,7 +427,21 @@ void PartyDamage::Initialize()
     total = 0;
     send_timer = TIMER_INIT();
 
-    GW::StoC::RegisterPacketCallback<GW::Packet::StoC::GenericModifier>(&GenericModifier_Entry, DamagePacketCallback,0x8000);
+    // After the game (and other hooks) have handled the packet, as before moving to the bus
+    GenericPacketBus::Subscribe(&GenericModifier_Entry, {GenericPacketBus::Header::GenericModifier}, DamagePacketCallback, {
+        GW::Packet::StoC::P156_Type::damage,
+        GW::Packet::StoC::P156_Type::critical,
+        GW::Packet::StoC::P156_Type::armorignoring
+    }, true);
+    GenericPacketBus::Subscribe(&SkillPacket_Entry, {GenericPacketBus::Header::GenericValue, GenericPacketBus::Header::GenericValueTarget}, [](GW::HookStatus*, const GenericPacketBus::Event& packet) {
+        SkillCallback(packet.value_id, packet.GetSkillCaster(), packet.value);
+    }, {
+        GW::Packet::StoC::GenericValueID::instant_skill_activated,
+        GW::Packet::StoC::GenericValueID::skill_activated,
+        GW::Packet::StoC::GenericValueID::skill_finished,
+        GW::Packet::StoC::GenericValueID::attack_skill_activated,
+        GW::Packet::StoC::GenericValueID::attack_skill_finished
+    });
     GW::StoC::RegisterPacketCallback<GW::Packet::StoC::MapLoaded>(&MapLoaded_Entry, MapLoadedCallback, 0x8000);
 
     GW::Chat::CreateCommand(L"dmg", CmdDamage);
@@ -292,7 +452,8 @@ void PartyDamage::Initialize()
 void PartyDamage::Terminate()
 {
     SnapsToPartyWindow::Terminate();
-    GW::StoC::RemoveCallbacks(&GenericModifier_Entry);
+    GenericPacketBus::Unsubscribe(&GenericModifier_Entry);
+    GenericPacketBus::Unsubscribe(&SkillPacket_Entry);
     GW::StoC::RemoveCallbacks(&MapLoaded_Entry);
     GW::Chat::DeleteCommand(L"dmg");
     GW::Chat::DeleteCommand(L"damage");
@@ -321,13 +482,26 @@ void PartyDamage::Update(const float)
     }
 
     // reset recent if needed
+    const auto now = TIMER_INIT();
     for (auto& entry : damage) {
         if (TIMER_DIFF(entry.last_damage) > recent_max_time) {
             entry.recent_damage = 0;
         }
+        entry.UpdateDps(now);
     }
 }
 
+void PartyDamage::ApplyDpsWindow(const int seconds)
+{
+    // The windows are only written on the game thread
+    GW::GameThread::Enqueue([seconds] {
+        game_dps_window = seconds;
+        for (auto& entry : damage) {
+            entry.ResetWindow();
+        }
+    });
+}
+
 void PartyDamage::Draw(IDirect3DDevice9* )
 {
     if (!visible) {
@@ -450,14 +624,22 @@ void PartyDamage::Draw(IDirect3DDevice9* )
                 ImVec2(x + ImGui::GetStyle().ItemSpacing.x, text_y),
                 IM_COL32(255, 255, 255, 255), buffer);
 
-            // Damage text - percentage
-            const float perc_of_total = GetPercentageOfTotal(entry->damage);
-            snprintf(buffer, buffer_size, "%.1f %%", perc_of_total);
+            // Damage text - percentage or damage per second
+            if (show_dps) {
+                snprintf(buffer, buffer_size, "%.0f dps", entry->GetDps());
+            }
+            else {
+                snprintf(buffer, buffer_size, "%.1f %%", GetPercentageOfTotal(entry->damage));
+            }
             draw_list->AddText(
                 ImVec2(x + width / 2, text_y),
                 IM_COL32(255, 255, 255, 255), buffer
             );
 
+            if (show_skill_breakdown && entry->damage && ImGui::IsMouseHoveringRect(damage_top_left, damage_bottom_right)) {
+                DrawSkillBreakdown(*entry);
+            }
+
             if (print_by_click
                 && ImGui::IsMouseClicked(ImGuiMouseButton_Left)
                 && ImGui::IsMouseInRect(damage_top_left, damage_bottom_right)
@@ -473,12 +655,49 @@ void PartyDamage::Draw(IDirect3DDevice9* )
     
 }
 
+void PartyDamage::DrawSkillBreakdown(PlayerDamage& entry)
+{
+    std::array<const PlayerDamage::SkillDamage*, max_tracked_skills + 1> sorted{};
+    for (size_t i = 0; i < entry.skill_count; i++) {
+        sorted[i] = &entry.skills[i];
+    }
+    std::sort(sorted.begin(), sorted.begin() + entry.skill_count, [](const auto* a, const auto* b) {
+        return a->damage > b->damage;
+    });
+
+    ImGui::BeginTooltip();
+    ImGui::Text("%u damage, %.0f dps over the last %d seconds", entry.damage, entry.GetDps(), dps_window);
+    const ImVec2 icon_size = {ImGui::GetTextLineHeight(), ImGui::GetTextLineHeight()};
+    for (size_t i = 0; i < entry.skill_count; i++) {
+        const auto& [skill_id, skill_damage] = *sorted[i];
+        if (!skill_damage) {
+            continue;
+        }
+        const auto texture = skill_id == GW::Constants::SkillID::No_Skill ? nullptr : *Resources::GetSkillImage(skill_id);
+        if (texture) {
+            const auto region = TextureAtlas::GetCropped(texture, icon_size);
+            ImGui::Image(region.texture, icon_size, region.uv0, region.uv1);
+        }
+        else {
+            ImGui::Dummy(icon_size);
+        }
+        ImGui::SameLine();
+        ImGui::Text("%u (%.1f %%)%s", skill_damage, static_cast<float>(skill_damage) * 100.f / entry.damage,
+                    skill_id == GW::Constants::SkillID::No_Skill ? " Attacks & other" : "");
+    }
+    ImGui::EndTooltip();
+}
+
 void PartyDamage::LoadSettings(ToolboxIni* ini)
 {
     ToolboxWidget::LoadSettings(ini);
     width = static_cast<float>(ini->GetDoubleValue(Name(), VAR_NAME(width), width));
     LOAD_BOOL(bars_left);
     recent_max_time = ini->GetLongValue(Name(), VAR_NAME(recent_max_time), recent_max_time);
+    dps_window = std::clamp(static_cast<int>(ini->GetLongValue(Name(), VAR_NAME(dps_window), dps_window)), 1, max_dps_window);
+    ApplyDpsWindow(dps_window);
+    LOAD_BOOL(show_dps);
+    LOAD_BOOL(show_skill_breakdown);
     LOAD_COLOR(color_background);
     LOAD_COLOR(color_damage);
     LOAD_COLOR(color_recent);
@@ -502,7 +721,7 @@ void PartyDamage::LoadSettings(ToolboxIni* ini)
             if (lval <= 0) {
                 continue;
             }
-            hp_map[static_cast<size_t>(lkey)] = static_cast<uint32_t>(lval);
+            SetCachedMaxHp(static_cast<uint32_t>(lkey), static_cast<uint32_t>(lval));
         }
     }
 }
@@ -514,6 +733,9 @@ void PartyDamage::SaveSettings(ToolboxIni* ini)
     ini->SetDoubleValue(Name(), VAR_NAME(width), width);
     SAVE_BOOL(bars_left);
     SAVE_UINT(recent_max_time);
+    SAVE_UINT(dps_window);
+    SAVE_BOOL(show_dps);
+    SAVE_BOOL(show_skill_breakdown);
     SAVE_COLOR(color_background);
     SAVE_COLOR(color_damage);
     SAVE_COLOR(color_recent);
@@ -521,7 +743,11 @@ void PartyDamage::SaveSettings(ToolboxIni* ini)
     SAVE_BOOL(print_by_click);
     SAVE_UINT(user_offset);
 
-    for (const auto& [player_number, hp] : hp_map) {
+    for (size_t player_number = 0; player_number < max_hp_by_player_number.size(); player_number++) {
+        const auto hp = max_hp_by_player_number[player_number];
+        if (!hp) {
+            continue;
+        }
         std::string key = std::to_string(player_number);
         inifile->SetLongValue(IniSection, key.c_str(), hp, nullptr, false, true);
     }
@@ -548,6 +774,14 @@ void PartyDamage::DrawSettingsInternal()
         recent_max_time = 0;
     }
     ImGui::ShowHelp("After this amount of time, each player recent damage (blue bar) will be reset");
+    if (ImGui::SliderInt("DPS window", &dps_window, 1, max_dps_window, "%d seconds")) {
+        dps_window = std::clamp(dps_window, 1, max_dps_window);
+        ApplyDpsWindow(dps_window);
+    }
+    ImGui::ShowHelp("Damage per second is averaged over this many seconds");
+    ImGui::Checkbox("Show damage per second instead of percentage", &show_dps);
+    ImGui::Checkbox("Show damage by skill on hover", &show_skill_breakdown);
+    ImGui::ShowHelp("Damage dealt shortly after a skill is used is attributed to that skill;\nanything else is listed as attacks & other");
     Colors::DrawSettingHueWheel("Background", &color_background);
     Colors::DrawSettingHueWheel("Damage", &color_damage);
     Colors::DrawSettingHueWheel("Recent", &color_recent);
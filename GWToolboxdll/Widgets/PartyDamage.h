@@ -16,6 +16,10 @@ namespace GW {
     struct HookStatus;
 }
 
+namespace GenericPacketBus {
+    struct Event;
+}
+
 class PartyDamage : public SnapsToPartyWindow {
 protected:
     struct PlayerDamage;
@@ -25,13 +29,18 @@ protected:
     static void WritePartyDamage();
     static void WriteOwnDamage();
     static void ResetDamage();
+    // Queues the new dps window for the game thread, which resets every window to it
+    static void ApplyDpsWindow(int seconds);
 
     static PlayerDamage* GetDamageByAgentId(uint32_t agent_id, uint32_t* party_index_out = nullptr);
 
     static void CHAT_CMD_FUNC(CmdDamage);
 
     static void MapLoadedCallback(GW::HookStatus*, const GW::Packet::StoC::MapLoaded*);
-    static void DamagePacketCallback(GW::HookStatus*, const GW::Packet::StoC::GenericModifier*);
+    static void DamagePacketCallback(GW::HookStatus*, const GenericPacketBus::Event& packet);
+    static void SkillCallback(uint32_t value_id, uint32_t caster_id, uint32_t value);
+
+    static void DrawSkillBreakdown(PlayerDamage& entry);
 
 public:
     static PartyDamage& Instance()
@@ -13,6 +13,8 @@
 
 #include <Defines.h>
 #include <Modules/Resources.h>
+#include <Utils/GenericPacketBus.h>
+#include <Utils/TextureAtlas.h>
 #include <Widgets/SkillMonitorWidget.h>
 
 namespace {
@@ -32,8 +34,79 @@ namespace {
         float cast_time = .0f;
     };
 
-    std::unordered_map<GW::AgentID, std::vector<SkillActivation>> history{};
-    std::unordered_map<GW::AgentID, float> casttime_map{};
+    constexpr size_t max_history_length = 32;
+
+    // Fixed capacity ring of the most recent skill activations of one agent, oldest first
+    struct SkillHistory {
+        GW::AgentID agent_id = 0;
+        // Cast time received for the agent's upcoming skill activation, 0 if none
+        float next_cast_time = .0f;
+        // No activation in the history was last updated before this; lets Update() skip agents with nothing to expire
+        clock_t earliest_update = 0;
+
+        [[nodiscard]] size_t size() const { return count; }
+
+        SkillActivation& operator[](const size_t index)
+        {
+            return activations[(head + index) % activations.size()];
+        }
+
+        void Reset(const GW::AgentID _agent_id)
+        {
+            agent_id = _agent_id;
+            next_cast_time = .0f;
+            head = count = 0;
+        }
+
+        void Push(const SkillActivation& activation)
+        {
+            if (count == activations.size()) {
+                PopFront();
+            }
+            if (!count) {
+                earliest_update = activation.last_update;
+            }
+            (*this)[count++] = activation;
+        }
+
+        void Trim(const size_t max_count)
+        {
+            while (count > max_count) {
+                PopFront();
+            }
+        }
+
+        // Drops activations that haven't been updated for timeout ms, keeping the order of the rest
+        void Expire(const clock_t timeout)
+        {
+            size_t kept = 0;
+            for (size_t i = 0; i < count; i++) {
+                const auto activation = (*this)[i];
+                if (TIMER_DIFF(activation.last_update) > timeout) {
+                    continue;
+                }
+                if (!kept || activation.last_update < earliest_update) {
+                    earliest_update = activation.last_update;
+                }
+                (*this)[kept++] = activation;
+            }
+            count = kept;
+        }
+
+    private:
+        void PopFront()
+        {
+            head = (head + 1) % activations.size();
+            count--;
+        }
+
+        std::array<SkillActivation, max_history_length> activations{};
+        size_t head = 0;
+        size_t count = 0;
+    };
+
+    // Indexed by party slot; only grows when the party does, so recording activations doesn't allocate
+    std::vector<SkillHistory> history{};
 
     bool hide_in_outpost = false;
     bool show_non_party_members = false;
@@ -55,7 +128,33 @@ namespace {
 
     int history_length = 5;
     int history_timeout = 5000;
-    std::unordered_map<uint32_t, GW::HookEntry*> packet_hooks;
+    GW::HookEntry InstanceLoadInfo_Entry;
+    GW::HookEntry GenericPacket_Entry;
+
+    // History for the agent in its current party slot; nullptr if the agent isn't in the party window.
+    // If create is false, also nullptr if nothing has been recorded for the agent in this slot yet.
+    SkillHistory* GetHistory(const std::unordered_map<uint32_t, uint32_t>& party_slots, const GW::AgentID agent_id, const bool create)
+    {
+        const auto found = party_slots.find(agent_id);
+        if (found == party_slots.end()) {
+            return nullptr;
+        }
+        const auto party_slot = found->second;
+        if (party_slot >= history.size()) {
+            if (!create) {
+                return nullptr;
+            }
+            history.resize(party_slot + 1);
+        }
+        auto& skill_history = history[party_slot];
+        if (skill_history.agent_id != agent_id) {
+            if (!create) {
+                return nullptr;
+            }
+            skill_history.Reset(agent_id);
+        }
+        return &skill_history;
+    }
 
     Color GetColor(const SkillActivationStatus status)
     {
@@ -72,62 +171,43 @@ namespace {
         return Colors::Empty();
     }
 
-    void CasttimeCallback(const uint32_t value_id, const uint32_t caster_id, const float value)
+    void CasttimeCallback(const std::unordered_map<uint32_t, uint32_t>& party_slots, const uint32_t value_id, const uint32_t caster_id, const float value)
     {
         if (value_id != GW::Packet::StoC::GenericValueID::casttime) {
             return;
         }
 
-        casttime_map[caster_id] = value;
+        if (const auto skill_history = GetHistory(party_slots, caster_id, true)) {
+            skill_history->next_cast_time = value;
+        }
     }
 
 }
 
-void SkillMonitorWidget::OnStoCPacket(GW::HookStatus* status, GW::Packet::StoC::PacketBase* base) {
+void SkillMonitorWidget::OnGenericPacket(GW::HookStatus* status, const GenericPacketBus::Event& event)
+{
     if (status->blocked)
         return;
-    switch (base->header) {
-    case GW::Packet::StoC::InstanceLoadInfo::STATIC_HEADER: {
-        history.clear();
-        casttime_map.clear();
-    } break;
-
-    case GW::Packet::StoC::GenericModifier::STATIC_HEADER: {
-        const auto packet = (GW::Packet::StoC::GenericModifier*)base;
-        CasttimeCallback(packet->type, packet->target_id, packet->value);
-    } break;
-
-    case GW::Packet::StoC::GenericFloat::STATIC_HEADER: {
-        const auto packet = (GW::Packet::StoC::GenericFloat*)base;
-        CasttimeCallback(packet->type, packet->agent_id, packet->value);
-    } break;
-
-    case GW::Packet::StoC::GenericValue::STATIC_HEADER: {
-        const auto packet = (GW::Packet::StoC::GenericValue*)base;
-        SkillCallback(packet->value_id, packet->agent_id, packet->value);
-    } break;
-
-    case GW::Packet::StoC::GenericValueTarget::STATIC_HEADER: {
-        using namespace GW::Packet::StoC::GenericValueID;
-
-        const auto packet = (GW::Packet::StoC::GenericValueTarget*)base;
-        const auto value_id = packet->Value_id;
-        const auto caster_id = packet->caster;
-        const auto target_id = packet->target;
-
-        const bool isSwapped = value_id == skill_activated || value_id == attack_skill_activated;
-        SkillCallback(value_id, isSwapped ? target_id : caster_id, packet->value);
-    } break;
-
+    switch (event.header) {
+    case GenericPacketBus::Header::GenericModifier:
+        CasttimeCallback(party_indeces_by_agent_id, event.value_id, event.target_id, event.float_value);
+        break;
+    case GenericPacketBus::Header::GenericFloat:
+        CasttimeCallback(party_indeces_by_agent_id, event.value_id, event.caster_id, event.float_value);
+        break;
+    case GenericPacketBus::Header::GenericValue:
+    case GenericPacketBus::Header::GenericValueTarget:
+        SkillCallback(event.value_id, event.GetSkillCaster(), event.value);
+        break;
+    default:
+        break;
     }
 }
 void SkillMonitorWidget::SkillCallback(const uint32_t value_id, const uint32_t caster_id, const uint32_t value)
 {
-    if (!party_indeces_by_agent_id.contains(caster_id))
-        return;
     using namespace GW::Packet::StoC;
 
-    const auto skill_history = &history[caster_id];
+    const auto skill_history = GetHistory(party_indeces_by_agent_id, caster_id, true);
     if (!skill_history) {
         return;
     }
@@ -136,7 +216,7 @@ void SkillMonitorWidget::SkillCallback(const uint32_t value_id, const uint32_t c
     case GenericValueID::instant_skill_activated:
     case GenericValueID::attack_skill_activated:
     case GenericValueID::skill_activated: {
-        float casttime = casttime_map[caster_id];
+        float casttime = skill_history->next_cast_time;
         const bool is_instant = value_id == GenericValueID::instant_skill_activated;
         if (!is_instant && !casttime) {
             if (const auto skill = GW::SkillbarMgr::GetSkillConstantData(static_cast<GW::Constants::SkillID>(value))) {
@@ -144,7 +224,7 @@ void SkillMonitorWidget::SkillCallback(const uint32_t value_id, const uint32_t c
             }
         }
 
-        skill_history->push_back({
+        skill_history->Push({
             static_cast<GW::Constants::SkillID>(value),
             is_instant ? COMPLETED : CASTING,
             TIMER_INIT(),
@@ -152,32 +232,35 @@ void SkillMonitorWidget::SkillCallback(const uint32_t value_id, const uint32_t c
             casttime,
             });
 
-        casttime_map.erase(caster_id);
+        skill_history->next_cast_time = .0f;
         break;
     }
     case GenericValueID::skill_stopped:
     case GenericValueID::skill_finished:
     case GenericValueID::attack_skill_finished: {
-        const auto casting = find_if(skill_history->begin(), skill_history->end(),
-            [&](const SkillActivation& skill_activation) { return skill_activation.status == CASTING; });
-        if (casting == skill_history->end()) {
+        for (size_t i = 0; i < skill_history->size(); i++) {
+            auto& casting = (*skill_history)[i];
+            if (casting.status != CASTING) {
+                continue;
+            }
+            casting.status = value_id == GenericValueID::skill_stopped
+                ? CANCELLED
+                : COMPLETED;
+            casting.last_update = TIMER_INIT();
             break;
         }
-        casting->status = value_id == GenericValueID::skill_stopped
-            ? CANCELLED
-            : COMPLETED;
-        casting->last_update = TIMER_INIT();
         break;
     }
     case GenericValueID::interrupted: {
-        const auto cancelled = find_if(skill_history->begin(), skill_history->end(),
-            [&](const SkillActivation& skill_activation) { return skill_activation.status == CANCELLED; });
-        if (cancelled == skill_history->end()) {
+        for (size_t i = 0; i < skill_history->size(); i++) {
+            auto& cancelled = (*skill_history)[i];
+            if (cancelled.status != CANCELLED) {
+                continue;
+            }
+            cancelled.status = INTERRUPTED;
+            cancelled.last_update = TIMER_INIT();
             break;
         }
-
-        cancelled->status = INTERRUPTED;
-        cancelled->last_update = TIMER_INIT();
         break;
     }
     default:
@@ -189,29 +272,35 @@ void SkillMonitorWidget::Initialize()
 {
     SnapsToPartyWindow::Initialize();
 
-    uint32_t packet_headers_to_hook[] = {
-        GW::Packet::StoC::GenericModifier::STATIC_HEADER,
-        GW::Packet::StoC::GenericFloat::STATIC_HEADER,
-        GW::Packet::StoC::GenericValue::STATIC_HEADER,
-        GW::Packet::StoC::GenericValueTarget::STATIC_HEADER,
-        GW::Packet::StoC::InstanceLoadInfo::STATIC_HEADER
-    };
+    GW::StoC::RegisterPostPacketCallback<GW::Packet::StoC::InstanceLoadInfo>(&InstanceLoadInfo_Entry, [](GW::HookStatus* status, const GW::Packet::StoC::InstanceLoadInfo*) {
+        if (!status->blocked) {
+            history.clear();
+        }
+    });
 
-    for (const auto header : packet_headers_to_hook) {
-        const auto entry = new GW::HookEntry;
-        packet_hooks[header] = entry;
-        GW::StoC::RegisterPostPacketCallback(entry, header, OnStoCPacket);
-    }
+    using namespace GW::Packet::StoC;
+    GenericPacketBus::Subscribe(&GenericPacket_Entry, {
+            GenericPacketBus::Header::GenericModifier,
+            GenericPacketBus::Header::GenericFloat,
+            GenericPacketBus::Header::GenericValue,
+            GenericPacketBus::Header::GenericValueTarget
+        }, OnGenericPacket, {
+            GenericValueID::casttime,
+            GenericValueID::instant_skill_activated,
+            GenericValueID::attack_skill_activated,
+            GenericValueID::skill_activated,
+            GenericValueID::skill_stopped,
+            GenericValueID::skill_finished,
+            GenericValueID::attack_skill_finished,
+            GenericValueID::interrupted
+        }, true);
 }
 
 void SkillMonitorWidget::Terminate()
 {
     SnapsToPartyWindow::Terminate();
-    for (const auto& it : packet_hooks) {
-        GW::StoC::RemoveCallback(it.first, it.second);
-        delete it.second;
-    }
-    packet_hooks.clear();
+    GW::StoC::RemoveCallbacks(&InstanceLoadInfo_Entry);
+    GenericPacketBus::Unsubscribe(&GenericPacket_Entry);
 }
 
 void SkillMonitorWidget::Draw(IDirect3DDevice9*)
@@ -265,15 +354,19 @@ void SkillMonitorWidget::Draw(IDirect3DDevice9*)
                 continue;
             draw_list->AddRectFilled({ window_x , health_bar_pos->top_left.y }, { window_x + width, health_bar_pos->bottom_right.y }, background);
 
-            auto& skill_history = history[agent_id];
-            for (size_t i = 0; i < skill_history.size(); i++) {
-                const auto& skill_activation = skill_history.at(i);
+            const auto skill_history = GetHistory(party_indeces_by_agent_id, agent_id, false);
+            if (!skill_history) {
+                continue;
+            }
+            for (size_t i = 0; i < skill_history->size(); i++) {
+                const auto& skill_activation = (*skill_history)[i];
                 const ImVec2 top_left = {history_flip_direction ? window_x + (i * img_size) : window_x + width - (i * img_size) - img_size, health_bar_pos->top_left.y};
                 const ImVec2 bottom_right = {top_left.x + img_size, top_left.y + img_size};
 
                 const auto texture = *Resources::GetSkillImage(skill_activation.id);
                 if (texture) {
-                    draw_list->AddImage(texture, top_left, bottom_right);
+                    const auto region = TextureAtlas::Get(texture);
+                    draw_list->AddImage(region.texture, top_left, bottom_right, region.uv0, region.uv1);
                 }
 
                 if (status_border_thickness != 0) {
@@ -305,17 +398,11 @@ void SkillMonitorWidget::Draw(IDirect3DDevice9*)
 
 void SkillMonitorWidget::Update(const float)
 {
-    for (auto& skill_history : history | std::views::values) {
-        if (skill_history.size() > static_cast<size_t>(history_length)) {
-            skill_history.erase(skill_history.begin(), skill_history.begin() + (skill_history.size() - history_length));
-        }
+    for (auto& skill_history : history) {
+        skill_history.Trim(static_cast<size_t>(history_length));
 
-        if (history_timeout != 0) {
-            std::erase_if(
-                skill_history,
-                [&](const SkillActivation& skill_activation) -> bool {
-                    return TIMER_DIFF(skill_activation.last_update) > history_timeout;
-                });
+        if (history_timeout != 0 && skill_history.size() && TIMER_DIFF(skill_history.earliest_update) > history_timeout) {
+            skill_history.Expire(history_timeout);
         }
     }
 }
@@ -341,6 +428,7 @@ void SkillMonitorWidget::LoadSettings(ToolboxIni* ini)
 
     LOAD_UINT(history_length);
     LOAD_UINT(history_timeout);
+    history_length = std::clamp(history_length, 0, static_cast<int>(max_history_length));
 }
 
 void SkillMonitorWidget::SaveSettings(ToolboxIni* ini)
@@ -401,9 +489,7 @@ void SkillMonitorWidget::DrawSettingsInternal()
 
     ImGui::Text("History");
     ImGui::InputInt("Length", &history_length, 0, 25);
-    if (history_length < 0) {
-        history_length = 0;
-    }
+    history_length = std::clamp(history_length, 0, static_cast<int>(max_history_length));
     ImGui::DragInt("Timeout", &history_timeout, 1.0f, 0, 0, "%d milliseconds");
     ImGui::ShowHelp("Amount of time after which a skill gets removed from the skill history. Set to 0 to disable.");
     if (history_timeout < 0) {
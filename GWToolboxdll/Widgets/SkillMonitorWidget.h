@@ -9,9 +9,13 @@
 #include <Timer.h>
 #include <Widgets/SnapsToPartyWindow.h>
 
+namespace GenericPacketBus {
+    struct Event;
+}
+
 class SkillMonitorWidget : public SnapsToPartyWindow {
 protected:
-    static void OnStoCPacket(GW::HookStatus* status, GW::Packet::StoC::PacketBase* base);
+    static void OnGenericPacket(GW::HookStatus* status, const GenericPacketBus::Event& event);
     static void SkillCallback(const uint32_t value_id, const uint32_t caster_id, const uint32_t value);
 public:
     static SkillMonitorWidget& Instance()
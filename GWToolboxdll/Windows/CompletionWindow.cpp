@@ -264,7 +264,11 @@ namespace {
     bool hide_collected_hats = false;
 
     bool pending_sort = true;
+    // Only read to migrate older installs; progress is saved to completion_bin_filename
     const char* completion_ini_filename = "character_completion.ini";
+    const char* completion_bin_filename = "character_completion.bin";
+    constexpr uint32_t completion_bin_magic = 0x43435447; // "GTCC"
+    constexpr uint32_t completion_bin_version = 1;
 
     bool hard_mode = false;
 
@@ -282,6 +286,24 @@ namespace {
     };
 
     std::unordered_map<std::wstring, CharacterCompletion*> character_completion;
+
+    // CheckProgress() looks up the same character once per achievement; remember the last one found
+    std::wstring last_completion_name;
+    CharacterCompletion* last_completion = nullptr;
+
+    CharacterCompletion* FindCharacterCompletion(const std::wstring& player_name)
+    {
+        if (last_completion && player_name == last_completion_name) {
+            return last_completion;
+        }
+        const auto found = character_completion.find(player_name);
+        if (found == character_completion.end()) {
+            return nullptr;
+        }
+        last_completion_name = player_name;
+        last_completion = found->second;
+        return last_completion;
+    }
     GW::HookEntry skills_unlocked_stoc_entry;
 
     std::map<Campaign, std::vector<OutpostUnlock*>> outposts;
@@ -455,6 +477,34 @@ namespace {
         }
     }
 
+    std::vector<uint32_t>* GetCompletionBuffer(CharacterCompletion* cc, const CompletionType type)
+    {
+        switch (type) {
+            case CompletionType::Mission:
+                return &cc->mission;
+            case CompletionType::MissionBonus:
+                return &cc->mission_bonus;
+            case CompletionType::MissionHM:
+                return &cc->mission_hm;
+            case CompletionType::MissionBonusHM:
+                return &cc->mission_bonus_hm;
+            case CompletionType::Skills:
+                return &cc->skills;
+            case CompletionType::Vanquishes:
+                return &cc->vanquishes;
+            case CompletionType::Heroes:
+                return &cc->heroes;
+            case CompletionType::MapsUnlocked:
+                return &cc->maps_unlocked;
+            case CompletionType::MinipetsUnlocked:
+                return &cc->minipets_unlocked;
+            case CompletionType::FestivalHats:
+                return &cc->festival_hats;
+        }
+        ASSERT("Invalid CompletionType" && false);
+        return nullptr;
+    }
+
     bool ParseCompletionBuffer(const CompletionType type, const wchar_t* character_name = nullptr, uint32_t* buffer = nullptr, size_t len = 0)
     {
         bool from_game = false;
@@ -510,52 +560,18 @@ namespace {
             }
         }
         const auto this_character_completion = CompletionWindow::GetCharacterCompletion(character_name, true);
-        std::vector<uint32_t>* write_buf = nullptr;
-        switch (type) {
-            case CompletionType::Mission:
-                write_buf = &this_character_completion->mission;
-                break;
-            case CompletionType::MissionBonus:
-                write_buf = &this_character_completion->mission_bonus;
-                break;
-            case CompletionType::MissionHM:
-                write_buf = &this_character_completion->mission_hm;
-                break;
-            case CompletionType::MissionBonusHM:
-                write_buf = &this_character_completion->mission_bonus_hm;
-                break;
-            case CompletionType::Skills:
-                write_buf = &this_character_completion->skills;
-                break;
-            case CompletionType::Vanquishes:
-                write_buf = &this_character_completion->vanquishes;
-                break;
-            case CompletionType::Heroes: {
-                write_buf = &this_character_completion->heroes;
-                if (from_game) {
-                    // Writing from game memory, not from file
-                    std::vector<uint32_t>& write = *write_buf;
-                    const GW::HeroInfo* hero_arr = (GW::HeroInfo*)buffer;
-                    if (write.size() < len) {
-                        write.resize(len, 0);
-                    }
-                    for (size_t i = 0; i < len; i++) {
-                        write[i] = hero_arr[i].hero_id;
-                    }
-                    return true;
-                }
+        std::vector<uint32_t>* write_buf = GetCompletionBuffer(this_character_completion, type);
+        if (type == CompletionType::Heroes && from_game) {
+            // Writing from game memory, not from file
+            std::vector<uint32_t>& write = *write_buf;
+            const GW::HeroInfo* hero_arr = (GW::HeroInfo*)buffer;
+            if (write.size() < len) {
+                write.resize(len, 0);
             }
-            break;
-            case CompletionType::MapsUnlocked:
-                write_buf = &this_character_completion->maps_unlocked;
-                break;
-            case CompletionType::MinipetsUnlocked:
-                write_buf = &this_character_completion->minipets_unlocked;
-                break;
-            case CompletionType::FestivalHats:
-                write_buf = &this_character_completion->festival_hats;
-                break;
-            default: ASSERT("Invalid CompletionType" && false);
+            for (size_t i = 0; i < len; i++) {
+                write[i] = hero_arr[i].hero_id;
+            }
+            return true;
         }
         std::vector<uint32_t>& write = *write_buf;
         if (write.size() < len) {
@@ -567,6 +583,132 @@ namespace {
         return true;
     }
 
+    constexpr CompletionType saved_completion_types[] = {
+        CompletionType::Skills,
+        CompletionType::Mission,
+        CompletionType::MissionBonus,
+        CompletionType::MissionHM,
+        CompletionType::MissionBonusHM,
+        CompletionType::Vanquishes,
+        CompletionType::Heroes,
+        CompletionType::MapsUnlocked,
+        CompletionType::MinipetsUnlocked,
+        CompletionType::FestivalHats
+    };
+
+    // completion_bin_filename is a flat array of uint32_t:
+    //   magic, version, character count, then per character:
+    //   profession, name length, account length, utf8 name and account each padded to a whole word,
+    //   then for each of saved_completion_types its word count followed by the words themselves
+    bool ParseCompletionFile(const uint8_t* data, const size_t size)
+    {
+        size_t pos = 0;
+        const auto read_words = [&](const size_t count) -> const uint32_t* {
+            if (count > (size - pos) / sizeof(uint32_t)) {
+                return nullptr;
+            }
+            const auto words = reinterpret_cast<const uint32_t*>(data + pos);
+            pos += count * sizeof(uint32_t);
+            return words;
+        };
+        const auto read_string = [&](const uint32_t len, std::string& out) {
+            const auto chars = read_words((static_cast<size_t>(len) + 3) / 4);
+            if (!chars) {
+                return false;
+            }
+            out.assign(reinterpret_cast<const char*>(chars), len);
+            return true;
+        };
+
+        const auto header = read_words(3);
+        if (!header || header[0] != completion_bin_magic || header[1] != completion_bin_version) {
+            return false;
+        }
+        std::string name;
+        std::string account;
+        std::wstring name_ws;
+        for (uint32_t i = 0; i < header[2]; i++) {
+            const auto char_header = read_words(3);
+            if (!char_header || !read_string(char_header[1], name) || !read_string(char_header[2], account)) {
+                return false;
+            }
+            GuiUtils::StringToWString(name, name_ws);
+            for (const auto type : saved_completion_types) {
+                const auto count = read_words(1);
+                const auto words = count ? read_words(*count) : nullptr;
+                if (!words) {
+                    return false;
+                }
+                if (*count) {
+                    // Read only; ParseCompletionBuffer ORs the words into the character's own copy
+                    ParseCompletionBuffer(type, name_ws.c_str(), const_cast<uint32_t*>(words), *count);
+                }
+            }
+            const auto c = CompletionWindow::GetCharacterCompletion(name_ws.c_str(), true);
+            c->profession = static_cast<Profession>(char_header[0]);
+            c->account = GuiUtils::StringToWString(account);
+        }
+        return true;
+    }
+
+    // Maps the file rather than reading it; it's parsed once, straight out of the page cache
+    bool LoadCompletionFile(const std::filesystem::path& path)
+    {
+        const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER file_size{};
+        const HANDLE mapping = GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0
+                                   ? CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr)
+                                   : nullptr;
+        const auto view = mapping ? static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+        const bool ok = view && ParseCompletionFile(view, static_cast<size_t>(file_size.QuadPart));
+        if (view) {
+            UnmapViewOfFile(view);
+        }
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return ok;
+    }
+
+    bool SaveCompletionFile(const std::filesystem::path& path)
+    {
+        std::vector<uint32_t> out = {completion_bin_magic, completion_bin_version, static_cast<uint32_t>(character_completion.size())};
+        const auto write_string = [&out](const std::string& str) {
+            const size_t at = out.size();
+            out.resize(at + (str.size() + 3) / 4, 0);
+            memcpy(out.data() + at, str.data(), str.size());
+        };
+        std::string account;
+        for (const auto& [_, char_comp] : character_completion) {
+            GuiUtils::WStringToString(char_comp->account, account);
+            out.push_back(static_cast<uint32_t>(char_comp->profession));
+            out.push_back(static_cast<uint32_t>(char_comp->name_str.size()));
+            out.push_back(static_cast<uint32_t>(account.size()));
+            write_string(char_comp->name_str);
+            write_string(account);
+            for (const auto type : saved_completion_types) {
+                const auto buf = GetCompletionBuffer(char_comp, type);
+                out.push_back(static_cast<uint32_t>(buf->size()));
+                out.insert(out.end(), buf->begin(), buf->end());
+            }
+        }
+        // Write to a temporary file first so a crash mid-save can't lose everyone's progress
+        auto tmp_path = path;
+        tmp_path += L".tmp";
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size() * sizeof(uint32_t)))) {
+            return false;
+        }
+        file.close();
+        std::error_code ec;
+        std::filesystem::rename(tmp_path, path, ec);
+        return !ec;
+    }
+
     bool only_show_account_chars = true;
     // Check login screen; assign missing characters to email account
     void RefreshAccountCharacters()
@@ -685,14 +827,14 @@ bool Mission::Draw(IDirect3DDevice9*)
     else {
         clicked = ImGui::CompositeIconButton("", (ImTextureID*)icons_out, icons_len,  s, 0, s,icon_uv_offset[0],icon_uv_offset[1]);
         if (ImGui::IsItemHovered()) {
-            ImGui::SetTooltip("%s", Name());
+            DrawTooltip();
         }
     }
     if (clicked) {
         OnClick();
     }
     if (hovered) {
-        ImGui::SetTooltip("%s", Name());
+        DrawTooltip();
     }
     ImGui::PopID();
     ImGui::PopStyleColor();
@@ -745,11 +887,10 @@ void Mission::OnClick()
 void Mission::CheckProgress(const std::wstring& player_name)
 {
     is_completed = bonus = false;
-    const auto& completion = character_completion;
-    if (!completion.contains(player_name)) {
+    const auto player_completion = FindCharacterCompletion(player_name);
+    if (!player_completion) {
         return;
     }
-    const auto& player_completion = completion.at(player_name);
     const std::vector<uint32_t>* missions_complete = &player_completion->mission;
     const std::vector<uint32_t>* missions_bonus = &player_completion->mission_bonus;
     if (hard_mode) {
@@ -774,11 +915,10 @@ void Mission::CheckProgress(const std::wstring& player_name)
 }
 
 void OutpostUnlock::CheckProgress(const std::wstring& player_name) {
-    const auto& completion = character_completion;
-    if (!completion.contains(player_name)) {
+    const auto player_completion = FindCharacterCompletion(player_name);
+    if (!player_completion) {
         return;
     }
-    const auto& player_completion = completion.at(player_name);
     is_completed = bonus = map_unlocked = ArrayBoolAt(player_completion->maps_unlocked, std::to_underlying(outpost));
 
     GetOutpostIcons(outpost, icons, 0);
@@ -789,6 +929,11 @@ bool OutpostUnlock::Draw(IDirect3DDevice9* device) {
     return true;
 }
 
+void Mission::DrawTooltip()
+{
+    ImGui::SetTooltip("%s", Name());
+}
+
 bool Mission::IsDaily()
 {
     return false;
@@ -833,14 +978,19 @@ HeroUnlock::HeroUnlock(HeroID _hero_id)
 void HeroUnlock::CheckProgress(const std::wstring& player_name)
 {
     is_completed = false;
-    const auto& skills = character_completion;
-    if (!skills.contains(player_name)) {
+    const auto char_comp = FindCharacterCompletion(player_name);
+    if (!char_comp) {
         return;
     }
-    auto& heroes = skills.at(player_name)->heroes;
+    auto& heroes = char_comp->heroes;
     is_completed = bonus = std::ranges::contains(heroes, std::to_underlying(skill_id));
 }
 
+bool HeroUnlock::IsUnlockedBy(const CharacterCompletion& cc)
+{
+    return cc.heroes.empty() || std::ranges::contains(cc.heroes, std::to_underlying(skill_id));
+}
+
 const char* HeroUnlock::Name()
 {
     return hero_names[std::to_underlying(skill_id)];
@@ -978,14 +1128,42 @@ bool PvESkill::Draw(IDirect3DDevice9* device)
 void PvESkill::CheckProgress(const std::wstring& player_name)
 {
     is_completed = false;
-    const auto& skills = character_completion;
-    if (!skills.contains(player_name)) {
+    const auto char_comp = FindCharacterCompletion(player_name);
+    if (!char_comp) {
         return;
     }
-    const auto& unlocked = skills.at(player_name)->skills;
+    const auto& unlocked = char_comp->skills;
     is_completed = bonus = ArrayBoolAt(unlocked, std::to_underlying(skill_id));
 }
 
+bool PvESkill::IsUnlockedBy(const CharacterCompletion& cc)
+{
+    return cc.skills.empty() || ArrayBoolAt(cc.skills, std::to_underlying(skill_id));
+}
+
+void PvESkill::DrawTooltip()
+{
+    // Which of the characters in the dropdown still need this; one bit test per character
+    ImGui::BeginTooltip();
+    ImGui::TextUnformatted(Name());
+    const auto email = GetAccountEmail();
+    bool needed = false;
+    for (const auto& [_, cc] : character_completion) {
+        if (only_show_account_chars && (!email || cc->account != email)) {
+            continue;
+        }
+        if (IsUnlockedBy(*cc)) {
+            continue;
+        }
+        if (!needed) {
+            ImGui::TextDisabled("Still needed by:");
+            needed = true;
+        }
+        ImGui::BulletText("%s", cc->name_str.c_str());
+    }
+    ImGui::EndTooltip();
+}
+
 FactionsPvESkill::FactionsPvESkill(const SkillID skill_id)
     : PvESkill(skill_id)
 {
@@ -1018,11 +1196,11 @@ bool FactionsPvESkill::Draw(IDirect3DDevice9* device)
 void Vanquish::CheckProgress(const std::wstring& player_name)
 {
     is_completed = false;
-    const auto& completion = character_completion;
-    if (!completion.contains(player_name)) {
+    const auto char_comp = FindCharacterCompletion(player_name);
+    if (!char_comp) {
         return;
     }
-    const auto& unlocked = completion.at(player_name)->vanquishes;
+    const auto& unlocked = char_comp->vanquishes;
     is_completed = bonus = ArrayBoolAt(unlocked, std::to_underlying(outpost));
     mission_state = is_completed ? 0x7 : 0x0;
 
@@ -1960,6 +2138,7 @@ void CompletionWindow::Terminate()
         delete camp.second;
     }
     character_completion.clear();
+    last_completion = nullptr;
 }
 
 void CompletionWindow::Draw(IDirect3DDevice9* device)
@@ -2611,11 +2790,6 @@ void CompletionWindow::DrawSettingsInternal()
 void CompletionWindow::LoadSettings(ToolboxIni* ini)
 {
     ToolboxWindow::LoadSettings(ini);
-    const auto completion_ini = new ToolboxIni(false, false, false);
-    completion_ini->LoadFile(Resources::GetPath(completion_ini_filename).c_str());
-    std::string ini_str;
-    std::wstring name_ws;
-    const char* ini_section;
 
     LOAD_BOOL(show_as_list);
     LOAD_BOOL(hide_unlocked_skills);
@@ -2625,6 +2799,17 @@ void CompletionWindow::LoadSettings(ToolboxIni* ini)
     LOAD_BOOL(hide_collected_hats);
     LOAD_BOOL(only_show_account_chars);
 
+    if (LoadCompletionFile(Resources::GetPath(completion_bin_filename))) {
+        CheckProgress();
+        return;
+    }
+
+    // No binary file yet; migrate from the ini file older versions saved to
+    const auto completion_ini = new ToolboxIni(false, false, false);
+    completion_ini->LoadFile(Resources::GetPath(completion_ini_filename).c_str());
+    std::wstring name_ws;
+    const char* ini_section;
+
     auto read_ini_to_buf = [&](const CompletionType type, const char* section) {
         char ini_key_buf[64];
         snprintf(ini_key_buf, _countof(ini_key_buf), "%s_length", section);
@@ -2663,6 +2848,7 @@ void CompletionWindow::LoadSettings(ToolboxIni* ini)
         c->profession = static_cast<Profession>(completion_ini->GetLongValue(ini_section, "profession", 0));
         c->account = GuiUtils::StringToWString(completion_ini->GetValue(ini_section, "account", ""));
     }
+    delete completion_ini;
     CheckProgress();
 }
 
@@ -2731,8 +2917,6 @@ CompletionWindow* CompletionWindow::CheckProgress(const bool fetch_hom)
 void CompletionWindow::SaveSettings(ToolboxIni* ini)
 {
     ToolboxWindow::SaveSettings(ini);
-    auto completion_ini = new ToolboxIni(false, false, false);
-    std::string ini_str;
 
     SAVE_BOOL(show_as_list);
     SAVE_BOOL(hide_unlocked_skills);
@@ -2742,35 +2926,9 @@ void CompletionWindow::SaveSettings(ToolboxIni* ini)
     SAVE_BOOL(hide_collected_hats);
     SAVE_BOOL(only_show_account_chars);
 
-    auto write_buf_to_ini = [completion_ini](const char* section, const std::vector<uint32_t>* read, std::string& ini_str, const std::string* name) {
-        char ini_key_buf[64];
-        snprintf(ini_key_buf, _countof(ini_key_buf), "%s_length", section);
-        completion_ini->SetLongValue(name->c_str(), ini_key_buf, read->size());
-        ASSERT(GuiUtils::ArrayToIni(read->data(), read->size(), &ini_str));
-        snprintf(ini_key_buf, _countof(ini_key_buf), "%s_values", section);
-        completion_ini->SetValue(name->c_str(), ini_key_buf, ini_str.c_str());
-    };
-
-    for (const auto& char_unlocks : character_completion) {
-        CharacterCompletion* char_comp = char_unlocks.second;
-        const std::string* name = &char_comp->name_str;
-        completion_ini->SetLongValue(name->c_str(), "profession", std::to_underlying(char_comp->profession));
-        completion_ini->SetValue(name->c_str(), "account", GuiUtils::WStringToString(char_comp->account).c_str());
-        write_buf_to_ini("mission", &char_comp->mission, ini_str, name);
-        write_buf_to_ini("mission_bonus", &char_comp->mission_bonus, ini_str, name);
-        write_buf_to_ini("mission_hm", &char_comp->mission_hm, ini_str, name);
-        write_buf_to_ini("mission_bonus_hm", &char_comp->mission_bonus_hm, ini_str, name);
-        write_buf_to_ini("skills", &char_comp->skills, ini_str, name);
-        write_buf_to_ini("vanquishes", &char_comp->vanquishes, ini_str, name);
-        write_buf_to_ini("heros", &char_comp->heroes, ini_str, name);
-        write_buf_to_ini("maps_unlocked", &char_comp->maps_unlocked, ini_str, name);
-        write_buf_to_ini("minipets_unlocked", &char_comp->minipets_unlocked, ini_str, name);
-        write_buf_to_ini("festival_hats", &char_comp->festival_hats, ini_str, name);
-
-        completion_ini->SetValue(name->c_str(), "hom_code", char_comp->hom_code.c_str());
-    }
-    completion_ini->SaveFile(Resources::GetPath(completion_ini_filename).c_str());
-    delete completion_ini;
+    if (!SaveCompletionFile(Resources::GetPath(completion_bin_filename))) {
+        Log::Error("Failed to save %s", completion_bin_filename);
+    }
 }
 
 CharacterCompletion* CompletionWindow::GetCharacterCompletion(const wchar_t* character_name, const bool create_if_not_found)
@@ -2793,22 +2951,22 @@ CharacterCompletion* CompletionWindow::GetCharacterCompletion(const wchar_t* cha
 void MinipetAchievement::CheckProgress(const std::wstring& player_name)
 {
     is_completed = false;
-    const auto& cc = character_completion;
-    if (!cc.contains(player_name)) {
+    const auto char_comp = FindCharacterCompletion(player_name);
+    if (!char_comp) {
         return;
     }
-    const std::vector<uint32_t>& minipets_unlocked = cc.at(player_name)->minipets_unlocked;
+    const std::vector<uint32_t>& minipets_unlocked = char_comp->minipets_unlocked;
     is_completed = bonus = ArrayBoolAt(minipets_unlocked, encoded_name_index);
 }
 
 void WeaponAchievement::CheckProgress(const std::wstring& player_name)
 {
     is_completed = false;
-    const auto& cc = character_completion;
-    if (!cc.contains(player_name)) {
+    const auto char_comp = FindCharacterCompletion(player_name);
+    if (!char_comp) {
         return;
     }
-    const auto& hom = cc.at(player_name)->hom_achievements;
+    const auto& hom = char_comp->hom_achievements;
     if (hom.state != HallOfMonumentsAchievements::State::Done) {
         return;
     }
@@ -2827,11 +2985,11 @@ size_t AchieventWithWikiFile::GetLoadedIcons(IDirect3DTexture9* icons_out[4]) {
 void ArmorAchievement::CheckProgress(const std::wstring& player_name)
 {
     is_completed = false;
-    const auto& cc = character_completion;
-    if (!cc.contains(player_name)) {
+    const auto char_comp = FindCharacterCompletion(player_name);
+    if (!char_comp) {
         return;
     }
-    const auto& hom = cc.at(player_name)->hom_achievements;
+    const auto& hom = char_comp->hom_achievements;
     if (hom.state != HallOfMonumentsAchievements::State::Done) {
         return;
     }
@@ -2842,11 +3000,11 @@ void ArmorAchievement::CheckProgress(const std::wstring& player_name)
 void CompanionAchievement::CheckProgress(const std::wstring& player_name)
 {
     is_completed = false;
-    const auto& cc = character_completion;
-    if (!cc.contains(player_name)) {
+    const auto char_comp = FindCharacterCompletion(player_name);
+    if (!char_comp) {
         return;
     }
-    const auto& hom = cc.at(player_name)->hom_achievements;
+    const auto& hom = char_comp->hom_achievements;
     if (hom.state != HallOfMonumentsAchievements::State::Done) {
         return;
     }
@@ -2857,11 +3015,11 @@ void CompanionAchievement::CheckProgress(const std::wstring& player_name)
 void HonorAchievement::CheckProgress(const std::wstring& player_name)
 {
     is_completed = false;
-    const auto& cc = character_completion;
-    if (!cc.contains(player_name)) {
+    const auto char_comp = FindCharacterCompletion(player_name);
+    if (!char_comp) {
         return;
     }
-    const auto& hom = cc.at(player_name)->hom_achievements;
+    const auto& hom = char_comp->hom_achievements;
     if (hom.state != HallOfMonumentsAchievements::State::Done) {
         return;
     }
@@ -2872,11 +3030,11 @@ void HonorAchievement::CheckProgress(const std::wstring& player_name)
 void FestivalHat::CheckProgress(const std::wstring& player_name)
 {
     is_completed = false;
-    const auto& cc = character_completion;
-    if (!cc.contains(player_name)) {
+    const auto char_comp = FindCharacterCompletion(player_name);
+    if (!char_comp) {
         return;
     }
-    const std::vector<uint32_t>& unlocked = cc.at(player_name)->festival_hats;
+    const std::vector<uint32_t>& unlocked = char_comp->festival_hats;
     is_completed = bonus = ArrayBoolAt(unlocked, encoded_name_index);
 }
 
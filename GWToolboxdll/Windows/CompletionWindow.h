@@ -6,6 +6,7 @@
 #include <ToolboxWindow.h>
 #include <Color.h>
 
+struct CharacterCompletion;
 
 namespace Missions {
 
@@ -40,6 +41,7 @@ namespace Missions {
 
         virtual const char* Name();
         virtual bool Draw(IDirect3DDevice9*);
+        virtual void DrawTooltip();
         virtual void OnClick();
         virtual bool IsDaily();  // True if this mission is ZM or ZB today
         virtual bool HasQuest(); // True if the ZM or ZB is in quest log
@@ -66,9 +68,12 @@ namespace Missions {
         size_t GetLoadedIcons(IDirect3DTexture9* icons_out[4]) override;
 
         bool Draw(IDirect3DDevice9*) override;
+        void DrawTooltip() override;
         void OnClick() override;
 
         void CheckProgress(const std::wstring& player_name) override;
+        // Characters we have no data for count as unlocked
+        virtual bool IsUnlockedBy(const CharacterCompletion& cc);
     };
 
     class HeroUnlock : public PvESkill {
@@ -81,6 +86,7 @@ namespace Missions {
         void OnClick() override;
 
         void CheckProgress(const std::wstring& player_name) override;
+        bool IsUnlockedBy(const CharacterCompletion& cc) override;
         const char* Name() override;
     };
 
@@ -94,6 +100,7 @@ namespace Missions {
         ItemAchievement(size_t _encoded_name_index, const wchar_t* encoded_name);
         size_t GetLoadedIcons(IDirect3DTexture9* icons_out[4]) override;
 
+        void DrawTooltip() override { Mission::DrawTooltip(); }
         void OnClick() override;
         const char* Name() override;
     };
@@ -18,6 +18,7 @@
 #include <Constants/EncStrings.h>
 #include <Modules/Resources.h>
 #include <Utils/ToolboxUtils.h>
+#include <Utils/ListView.h>
 
 
 using GW::Constants::MapID;
@@ -646,69 +647,147 @@ namespace {
     };
     static_assert(_countof(pvp_weekly_bonus_cycles) == WEEKLY_BONUS_PVP_COUNT);
 
-    uint32_t GetZaishenBountyIdx(const time_t* unix)
-    {
-        return static_cast<uint32_t>((*unix - 1244736000) / 86400 % ZAISHEN_BOUNTY_COUNT);
-    }
+    // Each cycle moves on by one entry every period seconds, counting from the epoch it was first seen at
+    struct Rotation {
+        time_t epoch;
+        time_t period;
+        uint32_t count;
 
-    uint32_t GetWeeklyBonusPvEIdx(const time_t* unix)
-    {
-        return static_cast<uint32_t>((*unix - 1368457200) / 604800 % WEEKLY_BONUS_PVE_COUNT);
-    }
-
-    uint32_t GetWeeklyBonusPvPIdx(const time_t* unix)
-    {
-        return static_cast<uint32_t>((*unix - 1368457200) / 604800 % WEEKLY_BONUS_PVP_COUNT);
-    }
+        [[nodiscard]] uint32_t IndexAt(const time_t unix) const
+        {
+            return static_cast<uint32_t>((unix - epoch) / period % count);
+        }
 
-    uint32_t GetZaishenCombatIdx(const time_t* unix)
-    {
-        return static_cast<uint32_t>((*unix - 1256227200) / 86400 % ZAISHEN_COMBAT_COUNT);
-    }
+        // Start of the period after the one unix falls in
+        [[nodiscard]] time_t NextChange(const time_t unix) const
+        {
+            return unix + period - (unix - epoch) % period;
+        }
 
-    uint32_t GetZaishenMissionIdx(const time_t* unix)
-    {
-        return static_cast<uint32_t>((*unix - 1299168000) / 86400 % ZAISHEN_MISSION_COUNT);
-    }
+        // Whole periods until idx comes round again; 0 if it's the current one
+        [[nodiscard]] uint32_t PeriodsUntil(const uint32_t idx, const time_t unix) const
+        {
+            return (idx + count - IndexAt(unix)) % count;
+        }
 
-    uint32_t GetZaishenVanquishIdx(const time_t* unix)
-    {
-        return static_cast<uint32_t>((*unix - 1299168000) / 86400 % ZAISHEN_VANQUISH_COUNT);
-    }
+        // When idx next becomes active, or unix if it already is
+        [[nodiscard]] time_t NextOccurrence(const uint32_t idx, const time_t unix) const
+        {
+            const auto periods = PeriodsUntil(idx, unix);
+            return periods ? NextChange(unix) + (periods - 1) * period : unix;
+        }
+    };
 
-    uint32_t GetNicholasTheTravellerIdx(const time_t* unix)
-    {
-        return static_cast<uint32_t>((*unix - 1323097200) / 604800 % NICHOLAS_POST_COUNT);
-    }
+    constexpr Rotation zaishen_bounty_rotation = {1244736000, 86400, ZAISHEN_BOUNTY_COUNT};
+    constexpr Rotation zaishen_combat_rotation = {1256227200, 86400, ZAISHEN_COMBAT_COUNT};
+    constexpr Rotation zaishen_mission_rotation = {1299168000, 86400, ZAISHEN_MISSION_COUNT};
+    constexpr Rotation zaishen_vanquish_rotation = {1299168000, 86400, ZAISHEN_VANQUISH_COUNT};
+    constexpr Rotation wanted_rotation = {1276012800, 86400, WANTED_COUNT};
+    constexpr Rotation vanguard_rotation = {1299168000, 86400, VANGUARD_COUNT};
+    constexpr Rotation nicholas_sandford_rotation = {1239260400, 86400, NICHOLAS_PRE_COUNT};
+    constexpr Rotation nicholas_rotation = {1323097200, 604800, NICHOLAS_POST_COUNT};
+    constexpr Rotation weekly_bonus_pve_rotation = {1368457200, 604800, WEEKLY_BONUS_PVE_COUNT};
+    constexpr Rotation weekly_bonus_pvp_rotation = {1368457200, 604800, WEEKLY_BONUS_PVP_COUNT};
+    constexpr const Rotation* all_rotations[] = {
+        &zaishen_bounty_rotation, &zaishen_combat_rotation, &zaishen_mission_rotation, &zaishen_vanquish_rotation, &wanted_rotation,
+        &vanguard_rotation, &nicholas_sandford_rotation, &nicholas_rotation, &weekly_bonus_pve_rotation, &weekly_bonus_pvp_rotation
+    };
 
-    uint32_t GetNicholasSandfordIdx(const time_t* unix)
+    // Which rotation a quest belongs to, and its index in that rotation; nullptr if it isn't one of ours
+    const Rotation* GetRotation(const DailyQuests::QuestData* info, uint32_t* idx)
     {
-        return static_cast<uint32_t>((*unix - 1239260400) / 86400 % NICHOLAS_PRE_COUNT);
+        const auto find_in = [info, idx](const auto& cycles) {
+            const size_t count = std::size(cycles);
+            if (!count) {
+                return false;
+            }
+            // Cycles hold derived types, so work out the index from the address and check it maps back to info
+            const auto offset = reinterpret_cast<uintptr_t>(info) - reinterpret_cast<uintptr_t>(static_cast<const DailyQuests::QuestData*>(&cycles[0]));
+            const size_t i = offset / sizeof(cycles[0]);
+            if (i >= count || static_cast<const DailyQuests::QuestData*>(&cycles[i]) != info) {
+                return false;
+            }
+            *idx = static_cast<uint32_t>(i);
+            return true;
+        };
+        if (find_in(zaishen_bounty_cycles)) return &zaishen_bounty_rotation;
+        if (find_in(zaishen_combat_cycles)) return &zaishen_combat_rotation;
+        if (find_in(zaishen_mission_cycles)) return &zaishen_mission_rotation;
+        if (find_in(zaishen_vanquish_cycles)) return &zaishen_vanquish_rotation;
+        if (find_in(wanted_by_shining_blade_cycles)) return &wanted_rotation;
+        if (find_in(vanguard_cycles)) return &vanguard_rotation;
+        if (find_in(nicholas_sandford_cycles)) return &nicholas_sandford_rotation;
+        if (find_in(nicholas_cycles)) return &nicholas_rotation;
+        if (find_in(pve_weekly_bonus_cycles)) return &weekly_bonus_pve_rotation;
+        if (find_in(pvp_weekly_bonus_cycles)) return &weekly_bonus_pvp_rotation;
+        return nullptr;
     }
 
-    uint32_t GetWantedByShiningBladeIdx(const time_t* unix)
-    {
-        return static_cast<uint32_t>((*unix - 1276012800) / 86400 % WANTED_COUNT);
-    }
+    // One row of the window; the rotations and date label only change a few times a day, so rows are built once and reused
+    struct ForecastDay {
+        char date_label[16];
+        uint8_t zaishen_mission;
+        uint8_t zaishen_bounty;
+        uint8_t zaishen_combat;
+        uint8_t zaishen_vanquish;
+        uint8_t wanted;
+        uint8_t nicholas;
+        uint8_t weekly_bonus_pve;
+        uint8_t weekly_bonus_pvp;
+    };
+    static_assert(NICHOLAS_POST_COUNT <= 0x100 && ZAISHEN_VANQUISH_COUNT <= 0x100);
 
-    uint32_t GetVanguardIdx(const time_t* unix)
-    {
-        return static_cast<uint32_t>((*unix - 1299168000) / 86400 % VANGUARD_COUNT);
-    }
+    ListView<ForecastDay> forecast;
+    // Next time any rotation moves on or the local date changes
+    time_t forecast_valid_until = 0;
 
-    time_t GetWeeklyRotationTime(const time_t* unix)
+    void BuildForecast(std::vector<ForecastDay>& rows, const time_t now, const size_t days)
     {
-        return static_cast<time_t>(floor((*unix - 1368457200) / 604800) * 604800) + 1368457200;
-    }
+        rows.resize(days);
+        time_t unix = now;
+        for (size_t i = 0; i < days; i++) {
+            auto& day = rows[i];
+            switch (i) {
+                case 0:
+                    strcpy_s(day.date_label, "Today");
+                    break;
+                case 1:
+                    strcpy_s(day.date_label, "Tomorrow");
+                    break;
+                default:
+                    std::strftime(day.date_label, sizeof(day.date_label), "%a %d %b", std::localtime(&unix));
+                    break;
+            }
+            day.zaishen_mission = static_cast<uint8_t>(zaishen_mission_rotation.IndexAt(unix));
+            day.zaishen_bounty = static_cast<uint8_t>(zaishen_bounty_rotation.IndexAt(unix));
+            day.zaishen_combat = static_cast<uint8_t>(zaishen_combat_rotation.IndexAt(unix));
+            day.zaishen_vanquish = static_cast<uint8_t>(zaishen_vanquish_rotation.IndexAt(unix));
+            day.wanted = static_cast<uint8_t>(wanted_rotation.IndexAt(unix));
+            day.nicholas = static_cast<uint8_t>(nicholas_rotation.IndexAt(unix));
+            day.weekly_bonus_pve = static_cast<uint8_t>(weekly_bonus_pve_rotation.IndexAt(unix));
+            day.weekly_bonus_pvp = static_cast<uint8_t>(weekly_bonus_pvp_rotation.IndexAt(unix));
+            unix += 86400;
+        }
 
-    uint32_t GetWeeklyPvEBonusIdx(const time_t* unix)
-    {
-        return static_cast<uint32_t>((GetWeeklyRotationTime(unix) - 1368457200) / 604800 % WEEKLY_BONUS_PVE_COUNT);
+        std::tm midnight = *std::localtime(&now);
+        midnight.tm_hour = midnight.tm_min = midnight.tm_sec = 0;
+        midnight.tm_mday++;
+        midnight.tm_isdst = -1;
+        forecast_valid_until = std::mktime(&midnight);
+        for (const auto rotation : all_rotations) {
+            forecast_valid_until = std::min(forecast_valid_until, rotation->NextChange(now));
+        }
     }
 
-    uint32_t GetWeeklyPvPBonusIdx(const time_t* unix)
+    void UpdateForecast(const size_t days)
     {
-        return static_cast<uint32_t>((GetWeeklyRotationTime(unix) - 1368457200) / 604800 % WEEKLY_BONUS_PVP_COUNT);
+        const time_t now = time(nullptr);
+        if (now >= forecast_valid_until || forecast.size() != days) {
+            forecast.Invalidate();
+        }
+        forecast.Update([now, days](std::vector<ForecastDay>& rows) {
+            BuildForecast(rows, now, days);
+        });
     }
 
 
@@ -948,6 +1027,29 @@ namespace {
         return GetQuestByName(quest_name) != nullptr;
     }
 
+    // Names of the daily quests in the quest log; gathered once per frame rather than searching the log for every cell drawn
+    std::vector<const std::string*> daily_quests_in_log;
+
+    void RefreshDailyQuestsInLog()
+    {
+        daily_quests_in_log.clear();
+        const auto w = GW::GetWorldContext();
+        const auto decoded_quest_names = w ? GetQuestLogInfo() : nullptr;
+        if (!decoded_quest_names)
+            return;
+        for (auto& entry : w->quest_log) {
+            if (entry.name && IsDailyQuest(entry))
+                daily_quests_in_log.push_back(&decoded_quest_names->at(entry.quest_id)->string());
+        }
+    }
+
+    bool IsDailyQuestInLog(const char* quest_name)
+    {
+        return std::ranges::any_of(daily_quests_in_log, [quest_name](const std::string* name) {
+            return *name == quest_name;
+        });
+    }
+
     const char* you_have_this_quest = "You have this quest in your log";
 
     bool OnDailyQuestContextMenu(void* wparam)
@@ -956,6 +1058,17 @@ namespace {
         const auto has_quest = HasDailyQuest(info->GetQuestName());
         const auto quest_available = IsQuestAvailable(info);
         ImGui::TextUnformatted(info->GetQuestName());
+        uint32_t idx = 0;
+        if (const auto rotation = GetRotation(info, &idx)) {
+            const time_t now = time(nullptr);
+            time_t next = rotation->NextOccurrence(idx, now);
+            if (next == now) {
+                next = rotation->NextChange(now) + static_cast<time_t>(rotation->count - 1) * rotation->period;
+            }
+            char next_str[32];
+            std::strftime(next_str, sizeof(next_str), "Next up on %a %d %b", std::localtime(&next));
+            ImGui::TextDisabled(next_str);
+        }
 
         ImGui::PushStyleVar(ImGuiStyleVar_ButtonTextAlign, ImVec2(0, 0));
         ImGui::PushStyleColor(ImGuiCol_Button, ImColor(0, 0, 0, 0).Value);
@@ -1071,98 +1184,75 @@ void DailyQuests::Draw(IDirect3DDevice9*)
     ImGui::NewLine();
     ImGui::Separator();
     ImGui::BeginChild("dailies_scroll", ImVec2(0, -1 * (20.0f * ImGui::GetIO().FontGlobalScale) - ImGui::GetStyle().ItemInnerSpacing.y));
-    time_t unix = time(nullptr);
-    uint32_t idx = 0;
-
-    for (size_t i = 0; i < static_cast<size_t>(daily_quest_window_count); i++) {
-        offset = 0.0f;
-        switch (i) {
-            case 0:
-                ImGui::Text("Today");
-                break;
-            case 1:
-                ImGui::Text("Tomorrow");
-                break;
-            default:
-                char mbstr[100];
-                std::strftime(mbstr, sizeof(mbstr), "%a %d %b", std::localtime(&unix));
-                ImGui::Text(mbstr);
-                break;
-        }
-        auto write_daily_info = [](bool* subscribed, QuestData* info, bool check_completion) {
-            const auto incomplete_message = check_completion ? GetIncompleteStatusMessage(info->map_id) : nullptr;
-            auto col = &normal_color;
-            if (incomplete_message) col = &incomplete_color;
-            if (*subscribed) col = &subscribed_color;
-            const auto start = ImGui::GetCursorScreenPos();
-            ImGui::TextColored(*col, info->GetQuestName());
-            auto lmb_clicked = ImGui::IsItemClicked();
-            auto rmb_clicked = ImGui::IsItemClicked(ImGuiMouseButton_Right);
-            const auto hovered = ImGui::IsItemHovered();
-            if (HasDailyQuest(info->GetQuestName())) {
-                ImGui::SameLine();
-                ImGui::TextColored(incomplete_color, ICON_FA_EXCLAMATION);
-                if (ImGui::IsItemHovered()) {
-                    ImGui::SetTooltip(you_have_this_quest);
-                }
-                lmb_clicked |= ImGui::IsItemClicked();
-                rmb_clicked |= ImGui::IsItemClicked(ImGuiMouseButton_Right);
-            }
-            if (rmb_clicked) {
-                ImGui::SetContextMenu(OnDailyQuestContextMenu, info);
-            }
-            if (lmb_clicked) {
-                *subscribed = !*subscribed;
-            }
-            if (incomplete_message && hovered) {
-                ImGui::SetTooltip(incomplete_message);
+    RefreshDailyQuestsInLog();
+    const auto write_daily_info = [](bool* subscribed, QuestData* info, bool check_completion) {
+        const auto incomplete_message = check_completion ? GetIncompleteStatusMessage(info->map_id) : nullptr;
+        auto col = &normal_color;
+        if (incomplete_message) col = &incomplete_color;
+        if (*subscribed) col = &subscribed_color;
+        ImGui::TextColored(*col, info->GetQuestName());
+        auto lmb_clicked = ImGui::IsItemClicked();
+        auto rmb_clicked = ImGui::IsItemClicked(ImGuiMouseButton_Right);
+        const auto hovered = ImGui::IsItemHovered();
+        if (IsDailyQuestInLog(info->GetQuestName())) {
+            ImGui::SameLine();
+            ImGui::TextColored(incomplete_color, ICON_FA_EXCLAMATION);
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip(you_have_this_quest);
             }
-        };
-
+            lmb_clicked |= ImGui::IsItemClicked();
+            rmb_clicked |= ImGui::IsItemClicked(ImGuiMouseButton_Right);
+        }
+        if (rmb_clicked) {
+            ImGui::SetContextMenu(OnDailyQuestContextMenu, info);
+        }
+        if (lmb_clicked) {
+            *subscribed = !*subscribed;
+        }
+        if (incomplete_message && hovered) {
+            ImGui::SetTooltip(incomplete_message);
+        }
+    };
 
+    UpdateForecast(static_cast<size_t>(std::max(daily_quest_window_count, 0)));
+    forecast.Draw([&](const ForecastDay& day) {
+        offset = 0.0f;
+        ImGui::TextUnformatted(day.date_label);
         ImGui::SameLine(offset += short_text_width);
         if (show_zaishen_missions_in_window) {
-            idx = GetZaishenMissionIdx(&unix);
-            write_daily_info(&subscribed_zaishen_missions[idx], GetZaishenMission(unix), true);
+            write_daily_info(&subscribed_zaishen_missions[day.zaishen_mission], &zaishen_mission_cycles[day.zaishen_mission], true);
             ImGui::SameLine(offset += zm_width);
         }
         if (show_zaishen_bounty_in_window) {
-            idx = GetZaishenBountyIdx(&unix);
-            write_daily_info(&subscribed_zaishen_bounties[idx], GetZaishenBounty(unix), false);
+            write_daily_info(&subscribed_zaishen_bounties[day.zaishen_bounty], &zaishen_bounty_cycles[day.zaishen_bounty], false);
             ImGui::SameLine(offset += zb_width);
         }
         if (show_zaishen_combat_in_window) {
-            idx = GetZaishenCombatIdx(&unix);
-            write_daily_info(&subscribed_zaishen_combats[idx], GetZaishenCombat(unix), false);
+            write_daily_info(&subscribed_zaishen_combats[day.zaishen_combat], &zaishen_combat_cycles[day.zaishen_combat], false);
             ImGui::SameLine(offset += zc_width);
         }
         if (show_zaishen_vanquishes_in_window) {
-            idx = GetZaishenVanquishIdx(&unix);
-            write_daily_info(&subscribed_zaishen_vanquishes[idx], GetZaishenVanquish(unix), true);
+            write_daily_info(&subscribed_zaishen_vanquishes[day.zaishen_vanquish], &zaishen_vanquish_cycles[day.zaishen_vanquish], true);
             ImGui::SameLine(offset += zv_width);
         }
         if (show_wanted_quests_in_window) {
-            idx = GetWantedByShiningBladeIdx(&unix);
-            write_daily_info(&subscribed_wanted_quests[idx], GetWantedByShiningBlade(unix), false);
+            write_daily_info(&subscribed_wanted_quests[day.wanted], &wanted_by_shining_blade_cycles[day.wanted], false);
             ImGui::SameLine(offset += ws_width);
         }
         if (show_nicholas_in_window) {
-            ImGui::TextUnformatted(GetNicholasTheTraveller(unix)->GetQuestName());
+            ImGui::TextUnformatted(nicholas_cycles[day.nicholas].GetQuestName());
             ImGui::SameLine(offset += nicholas_width);
         }
         if (show_weekly_bonus_pve_in_window) {
-            idx = GetWeeklyBonusPvEIdx(&unix);
-            write_daily_info(&subscribed_weekly_bonus_pve[idx], &pve_weekly_bonus_cycles[idx], false);
+            write_daily_info(&subscribed_weekly_bonus_pve[day.weekly_bonus_pve], &pve_weekly_bonus_cycles[day.weekly_bonus_pve], false);
             ImGui::SameLine(offset += wbe_width);
         }
         if (show_weekly_bonus_pvp_in_window) {
-            idx = GetWeeklyBonusPvPIdx(&unix);
-            write_daily_info(&subscribed_weekly_bonus_pvp[idx], &pvp_weekly_bonus_cycles[idx], false);
+            write_daily_info(&subscribed_weekly_bonus_pvp[day.weekly_bonus_pvp], &pvp_weekly_bonus_cycles[day.weekly_bonus_pvp], false);
             ImGui::SameLine(offset += long_text_width);
         }
         ImGui::NewLine();
-        unix += 86400;
-    }
+    });
     ImGui::EndChild();
     ImGui::TextDisabled("Click on a daily quest to get notified when its coming up. Subscribed quests are highlighted in ");
     ImGui::SameLine(0, 0);
@@ -1459,6 +1549,9 @@ void DailyQuests::Terminate()
         delete it.second;
     }
     region_names.clear();
+    daily_quests_in_log.clear();
+    forecast.Clear();
+    forecast_valid_until = 0;
 
     for (const auto& it : chat_commands) {
         GW::Chat::DeleteCommand(it.first);
@@ -1493,61 +1586,40 @@ void DailyQuests::Update(const float)
     }
     if (GW::Map::GetIsMapLoaded() && time(nullptr) - start_time > 1) {
         checked_subscriptions = true;
-        // Check daily quests for the next 6 days, and send a message if found. Only runs once when TB is opened.
+        // Check subscribed daily quests coming up in the next few days, and send a message if found. Only runs once when TB is opened.
         const time_t now = time(nullptr);
-        time_t unix = now + 0;
-        uint32_t quest_idx;
-        for (auto i = 0u; i < subscriptions_lookahead_days; i++) {
-            char date_str[32];
-            switch (i) {
-                case 0:
-                    sprintf(date_str, "today");
-                    break;
-                case 1:
-                    sprintf(date_str, "tomorrow");
-                    break;
-                default:
-                    std::strftime(date_str, 32, "on %A", std::localtime(&unix));
-                    break;
-            }
-            if (subscribed_zaishen_missions[quest_idx = GetZaishenMissionIdx(&unix)]) {
-                Log::Info("%s is the Zaishen Mission %s", zaishen_mission_cycles[quest_idx].GetQuestName(), date_str);
-            }
-            if (subscribed_zaishen_bounties[quest_idx = GetZaishenBountyIdx(&unix)]) {
-                Log::Info("%s is the Zaishen Bounty %s", zaishen_bounty_cycles[quest_idx].GetQuestName(), date_str);
-            }
-            if (subscribed_zaishen_combats[quest_idx = GetZaishenCombatIdx(&unix)]) {
-                Log::Info("%s is the Zaishen Combat %s", zaishen_combat_cycles[quest_idx].GetQuestName(), date_str);
-            }
-            if (subscribed_zaishen_vanquishes[quest_idx = GetZaishenVanquishIdx(&unix)]) {
-                Log::Info("%s is the Zaishen Vanquish %s", zaishen_vanquish_cycles[quest_idx].GetQuestName(), date_str);
-            }
-            if (subscribed_wanted_quests[quest_idx = GetWantedByShiningBladeIdx(&unix)]) {
-                Log::Info("%s is Wanted by the Shining Blade %s", wanted_by_shining_blade_cycles[quest_idx].GetQuestName(), date_str);
-            }
-            unix += 86400;
-        }
-
-        // Check weekly bonuses / special events
-        unix = GetWeeklyRotationTime(&now);
-        for (auto i = 0u; i < 2; i++) {
-            char date_str[32];
-            switch (i) {
-                case 0:
-                    std::strftime(date_str, 32, "until %R on %A", std::localtime(&unix));
-                    break;
-                default:
-                    std::strftime(date_str, 32, "on %A at %R", std::localtime(&unix));
-                    break;
-            }
-            if (subscribed_weekly_bonus_pve[quest_idx = GetWeeklyBonusPvPIdx(&unix)]) {
-                Log::Info("%s is the Weekly PvE Bonus %s", pve_weekly_bonus_cycles[quest_idx].GetQuestName(), date_str);
-            }
-            if (subscribed_weekly_bonus_pvp[quest_idx = GetWeeklyBonusPvPIdx(&unix)]) {
-                Log::Info("%s is the Weekly PvP Bonus %s", pvp_weekly_bonus_cycles[quest_idx].GetQuestName(), date_str);
+        const auto check_subscriptions = [now](const Rotation& rotation, const bool* subscribed, auto& cycles, const char* label, const uint32_t lookahead) {
+            for (uint32_t idx = 0; idx < rotation.count; idx++) {
+                if (!subscribed[idx]) {
+                    continue;
+                }
+                const auto periods = rotation.PeriodsUntil(idx, now);
+                if (periods >= lookahead) {
+                    continue;
+                }
+                const time_t unix = rotation.NextOccurrence(idx, now);
+                char date_str[32];
+                if (rotation.period == 604800) {
+                    const time_t change = rotation.NextChange(now);
+                    std::strftime(date_str, sizeof(date_str), periods ? "on %A at %R" : "until %R on %A", std::localtime(&change));
+                }
+                else if (periods < 2) {
+                    strcpy_s(date_str, periods ? "tomorrow" : "today");
+                }
+                else {
+                    std::strftime(date_str, sizeof(date_str), "on %A", std::localtime(&unix));
+                }
+                Log::Info("%s is %s %s", cycles[idx].GetQuestName(), label, date_str);
             }
-            unix += 604800;
-        }
+        };
+        check_subscriptions(zaishen_mission_rotation, subscribed_zaishen_missions, zaishen_mission_cycles, "the Zaishen Mission", subscriptions_lookahead_days);
+        check_subscriptions(zaishen_bounty_rotation, subscribed_zaishen_bounties, zaishen_bounty_cycles, "the Zaishen Bounty", subscriptions_lookahead_days);
+        check_subscriptions(zaishen_combat_rotation, subscribed_zaishen_combats, zaishen_combat_cycles, "the Zaishen Combat", subscriptions_lookahead_days);
+        check_subscriptions(zaishen_vanquish_rotation, subscribed_zaishen_vanquishes, zaishen_vanquish_cycles, "the Zaishen Vanquish", subscriptions_lookahead_days);
+        check_subscriptions(wanted_rotation, subscribed_wanted_quests, wanted_by_shining_blade_cycles, "Wanted by the Shining Blade", subscriptions_lookahead_days);
+        // Weekly bonuses; this week and next
+        check_subscriptions(weekly_bonus_pve_rotation, subscribed_weekly_bonus_pve, pve_weekly_bonus_cycles, "the Weekly PvE Bonus", 2);
+        check_subscriptions(weekly_bonus_pvp_rotation, subscribed_weekly_bonus_pvp, pvp_weekly_bonus_cycles, "the Weekly PvP Bonus", 2);
     }
 }
 
@@ -1657,68 +1729,68 @@ DailyQuests::NicholasCycleData* DailyQuests::GetNicholasTheTraveller(time_t unix
 {
     if (!unix)
         unix = time(nullptr);
-    return &nicholas_cycles[GetNicholasTheTravellerIdx(&unix)];
+    return &nicholas_cycles[nicholas_rotation.IndexAt(unix)];
 }
 
 DailyQuests::QuestData* DailyQuests::GetZaishenBounty(time_t unix)
 {
     if (!unix)
         unix = time(nullptr);
-    return &zaishen_bounty_cycles[GetZaishenBountyIdx(&unix)];
+    return &zaishen_bounty_cycles[zaishen_bounty_rotation.IndexAt(unix)];
 }
 
 DailyQuests::QuestData* DailyQuests::GetZaishenMission(time_t unix)
 {
     if (!unix)
         unix = time(nullptr);
-    return &zaishen_mission_cycles[GetZaishenMissionIdx(&unix)];
+    return &zaishen_mission_cycles[zaishen_mission_rotation.IndexAt(unix)];
 }
 
 DailyQuests::QuestData* DailyQuests::GetZaishenCombat(time_t unix)
 {
     if (!unix)
         unix = time(nullptr);
-    return &zaishen_combat_cycles[GetZaishenCombatIdx(&unix)];
+    return &zaishen_combat_cycles[zaishen_combat_rotation.IndexAt(unix)];
 }
 
 DailyQuests::QuestData* DailyQuests::GetZaishenVanquish(time_t unix)
 {
     if (!unix)
         unix = time(nullptr);
-    return &zaishen_vanquish_cycles[GetZaishenVanquishIdx(&unix)];
+    return &zaishen_vanquish_cycles[zaishen_vanquish_rotation.IndexAt(unix)];
 }
 
 DailyQuests::QuestData* DailyQuests::GetNicholasSandford(time_t unix)
 {
     if (!unix)
         unix = time(nullptr);
-    return &nicholas_sandford_cycles[GetNicholasSandfordIdx(&unix)];
+    return &nicholas_sandford_cycles[nicholas_sandford_rotation.IndexAt(unix)];
 }
 
 DailyQuests::QuestData* DailyQuests::GetVanguardQuest(time_t unix)
 {
     if (!unix)
         unix = time(nullptr);
-    return &vanguard_cycles[GetVanguardIdx(&unix)];
+    return &vanguard_cycles[vanguard_rotation.IndexAt(unix)];
 }
 
 DailyQuests::QuestData* DailyQuests::GetWantedByShiningBlade(time_t unix)
 {
     if (!unix)
         unix = time(nullptr);
-    return &wanted_by_shining_blade_cycles[GetWantedByShiningBladeIdx(&unix)];
+    return &wanted_by_shining_blade_cycles[wanted_rotation.IndexAt(unix)];
 }
 
 DailyQuests::QuestData* DailyQuests::GetWeeklyPvEBonus(time_t unix)
 {
     if (!unix)
         unix = time(nullptr);
-    return &pve_weekly_bonus_cycles[GetWeeklyPvEBonusIdx(&unix)];
+    return &pve_weekly_bonus_cycles[weekly_bonus_pve_rotation.IndexAt(unix)];
 }
 
 DailyQuests::QuestData* DailyQuests::GetWeeklyPvPBonus(time_t unix)
 {
     if (!unix)
         unix = time(nullptr);
-    return &pvp_weekly_bonus_cycles[GetWeeklyPvPBonusIdx(&unix)];
+    return &pvp_weekly_bonus_cycles[weekly_bonus_pvp_rotation.IndexAt(unix)];
 }
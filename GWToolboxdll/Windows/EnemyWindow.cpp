@@ -11,6 +11,7 @@
 #include <GWCA/Managers/MapMgr.h>
 
 #include <Utils/GuiUtils.h>
+#include <Utils/AgentSnapshot.h>
 #include <Windows/EnemyWindow.h>
 #include <Modules/Resources.h>
 
@@ -243,19 +244,16 @@ void EnemyWindow::Draw(IDirect3DDevice9*)
 
     all_enemies.clear();
 
-    const GW::AgentArray* agents = GW::Agents::GetAgentArray();
-    const GW::Agent* player = agents ? GW::Agents::GetObservingAgent() : nullptr;
+    const auto& snapshot = AgentSnapshot::Get();
+    const GW::Agent* player = snapshot.Size() ? GW::Agents::GetObservingAgent() : nullptr;
 
-    if (player && agents) {
-        int enemy_count = 0;
-        for (auto* agent : *agents) {
-            const GW::AgentLiving* living = agent ? agent->GetAsAgentLiving() : nullptr;
-
-            if (!living || living->allegiance != GW::Constants::Allegiance::Enemy || !living->GetIsAlive()) {
+    if (player) {
+        for (size_t i = 0; i < snapshot.Size(); i++) {
+            if (snapshot.allegiances[i] != GW::Constants::Allegiance::Enemy || !snapshot.IsAliveLiving(i)) {
                 continue;
             }
 
-            switch (living->player_number) {
+            switch (snapshot.player_numbers[i]) {
                 case 2338:
                 case 2325:
                     continue;
@@ -263,9 +261,8 @@ void EnemyWindow::Draw(IDirect3DDevice9*)
                     break;
             }
 
-            enemy_count++;
-
-            if (living->hp <= enemies_threshhold) {
+            if (snapshot.hp[i] <= enemies_threshhold) {
+                const GW::AgentLiving* living = snapshot.GetLiving(i);
                 all_enemies.insert(living->agent_id);
 
                 const bool is_casting = living->skill != static_cast<uint16_t>(GW::Constants::SkillID::No_Skill);
@@ -27,6 +27,8 @@
 #include <Windows/FriendListWindow.h>
 
 #include <Utils/ToolboxUtils.h>
+#include <Utils/StringPool.h>
+#include <Utils/ListView.h>
 
 
 /* Out of scope namespecey lookups */
@@ -100,7 +102,6 @@ namespace {
     bool poll_queued = false; // Used to avoid overloading the thread queue.
     bool friends_changed = false;
     bool friend_list_ready = false; // Allow processing when this is true.
-    bool need_to_reorder_friends = true;
 
     enum class FriendAliasType {
         NONE,
@@ -133,11 +134,38 @@ namespace {
 
     uint8_t poll_interval_seconds = 10;
 
-    // Mapping of Name > UUID
-    std::unordered_map<std::wstring, FriendListWindow::Friend*> uuid_by_name{};
+    // Character names and aliases, interned so that name lookups for incoming messages don't allocate.
+    // Case insensitive like the game's own names, so e.g. a typed /whisper target still finds its friend.
+    StringPool names(true);
+    // Mapping of Name > Friend, keyed by handle into names
+    std::unordered_map<StringPool::Handle, FriendListWindow::Friend*> uuid_by_name{};
+
+    void MapName(const std::wstring_view name, FriendListWindow::Friend* lf, const bool overwrite = false)
+    {
+        const auto handle = names.Intern(name);
+        if (handle == StringPool::InvalidHandle) {
+            return;
+        }
+        if (overwrite) {
+            uuid_by_name[handle] = lf;
+        }
+        else {
+            uuid_by_name.emplace(handle, lf);
+        }
+    }
+
+    void UnmapName(const std::wstring_view name)
+    {
+        const auto handle = names.Find(name);
+        if (handle != StringPool::InvalidHandle) {
+            uuid_by_name.erase(handle);
+        }
+    }
 
     // Main store of Friend info
     std::unordered_map<std::string, FriendListWindow::Friend*> friends{};
+    // Online friends sorted by alias; invalidated when a friend's status or alias changes, or a friend is removed
+    ListView<FriendListWindow::Friend*> online_friends;
 
     bool show_location = true;
 
@@ -148,22 +176,17 @@ namespace {
         CSimpleIni::TNamesDepend values{};
         inifile.GetAllValues(section, "charname", values);
         for (auto i = values.cbegin(); i != values.cend(); ++i) {
-            std::wstring char_wstr = GuiUtils::StringToWString(i->pItem);
-            std::wstring temp;
-            std::vector<std::wstring> parts{};
-            std::wstringstream wss(char_wstr);
-            while (std::getline(wss, temp, L',')) {
-                parts.push_back(temp);
-            }
-            std::wstring name = parts[0];
+            // "Char Name,profession"
+            const std::wstring char_wstr = GuiUtils::StringToWString(i->pItem);
+            const auto comma = char_wstr.find(L',');
             uint8_t profession = 0;
-            if (parts.size() > 1) {
-                const auto p = _wtoi(&parts[1][0]);
+            if (comma != std::wstring::npos) {
+                const auto p = _wtoi(char_wstr.c_str() + comma + 1);
                 if (p > 0 && p < 11) {
                     profession = static_cast<uint8_t>(p);
                 }
             }
-            out->emplace(name, profession);
+            out->emplace(std::wstring_view(char_wstr).substr(0, comma), profession);
         }
     }
 
@@ -552,9 +575,9 @@ namespace {
         }
         if (alias && alias_changed) {
             // Friend's alias for this uuid has changed, or the uuid for this alias has changed.
-            uuid_by_name.erase(lf->GetAliasW());
+            UnmapName(lf->GetAliasW());
             lf->setAlias(alias);
-            uuid_by_name.emplace(lf->GetAliasW(), lf);
+            MapName(lf->GetAliasW(), lf);
         }
         if (lf->current_map_id != map_id) {
             // Map changed
@@ -567,13 +590,13 @@ namespace {
         }
         if (status != GW::FriendStatus::Offline && charname) {
             lf->current_char = lf->SetCharacter(charname);
-            uuid_by_name.emplace(charname, lf);
+            MapName(charname, lf);
         }
         const bool status_changed = lf->status != status;
         lf->status = status;
 
         if (status_changed || alias_changed || uuid_changed || type_changed) {
-            need_to_reorder_friends = true;
+            online_friends.Invalidate();
         }
 
         friends_changed = true;
@@ -806,7 +829,14 @@ std::string FriendListWindow::Friend::GetCharactersHover(const bool include_char
 // Find existing record for friend by char name.
 FriendListWindow::Friend* FriendListWindow::GetFriend(const wchar_t* name)
 {
-    const auto it = uuid_by_name.find(name);
+    if (!name) {
+        return nullptr;
+    }
+    const auto handle = names.Find(name);
+    if (handle == StringPool::InvalidHandle) {
+        return nullptr;
+    }
+    const auto it = uuid_by_name.find(handle);
     return it == uuid_by_name.end() ? nullptr : it->second;
 }
 
@@ -834,11 +864,15 @@ bool FriendListWindow::RemoveFriend(const Friend* f)
         return false;
     }
     friends.erase(f->uuid);
+    online_friends.Invalidate();
     for (const auto& char_key : f->characters | std::views::keys) {
-        uuid_by_name.erase(char_key);
+        UnmapName(char_key);
     }
-    uuid_by_name.erase(f->GetAliasW());
-    delete f;
+    UnmapName(f->GetAliasW());
+    // online_friends may still be drawing this friend; free it on the render thread, by which point the rows have been rebuilt
+    Resources::EnqueueDxTask([f](IDirect3DDevice9*) {
+        delete f;
+    });
     return true;
 }
 
@@ -896,11 +930,14 @@ void FriendListWindow::Terminate()
     ToolboxWindow::Terminate();
     // Try to remove callbacks AGAIN here.
     SignalTerminate();
-    // Free memory for Friends list.
-    while (friends.begin() != friends.end()) {
-        RemoveFriend(friends.begin()->second);
+    // Free memory for Friends list. Nothing draws the list any more, so no need to wait for the render thread.
+    online_friends.Clear();
+    for (const auto f : friends | std::views::values) {
+        delete f;
     }
     friends.clear();
+    uuid_by_name.clear();
+    names.Clear();
     if (settings_thread.joinable()) {
         settings_thread.join();
     }
@@ -1096,26 +1133,26 @@ void FriendListWindow::Draw(IDirect3DDevice9*)
             GW::FriendListMgr::SetFriendListStatus(static_cast<GW::FriendStatus>(status));
         }
     }
-    std::vector<Friend*> friends_online;
-    for (const auto& it : friends) {
-        Friend* lfp = it.second;
-        if (lfp->type != GW::FriendType::Friend) {
-            continue;
-        }
-        // Get actual object instead of pointer just in case it becomes invalid half way through the draw.
-        if (lfp->IsOffline()) {
-            continue;
-        }
-        if (lfp->GetAliasW().empty()) {
-            continue;
+    online_friends.Update([](std::vector<Friend*>& rows) {
+        for (const auto& it : friends) {
+            Friend* lfp = it.second;
+            if (lfp->type != GW::FriendType::Friend) {
+                continue;
+            }
+            if (lfp->IsOffline()) {
+                continue;
+            }
+            if (lfp->GetAliasW().empty()) {
+                continue;
+            }
+            rows.push_back(lfp);
         }
-        friends_online.push_back(lfp);
-    }
-    std::ranges::sort(friends_online, [](const Friend* lhs, const Friend* rhs) {
-        return lhs->GetAliasW().compare(rhs->GetAliasW()) < 0;
+        std::ranges::sort(rows, [](const Friend* lhs, const Friend* rhs) {
+            return lhs->GetAliasW().compare(rhs->GetAliasW()) < 0;
+        });
     });
     char tmpbuf[32];
-    for (Friend* lfp : friends_online) {
+    online_friends.Draw([&](Friend* lfp) {
         colIdx = 0;
         ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0, 0, 0, 0));
         ImGui::PushStyleColor(ImGuiCol_ButtonHovered, hover_background_color);
@@ -1199,7 +1236,7 @@ void FriendListWindow::Draw(IDirect3DDevice9*)
             lfp->StartWhisper();
         }
         if (right_clicked) { }
-    }
+    });
     if (!is_widget) {
         ImGui::EndChild();
     }
@@ -1346,6 +1383,7 @@ void FriendListWindow::LoadFromFile()
     settings_thread = std::thread([this] {
         // clear builds from toolbox
         uuid_by_name.clear();
+        names.Clear();
         while (friends.begin() != friends.end()) {
             RemoveFriend(friends.begin()->second);
         }
@@ -1380,9 +1418,9 @@ void FriendListWindow::LoadFromFile()
             }
             friends.emplace(lf->uuid, lf);
             for (const auto& it : lf->characters) {
-                uuid_by_name[it.first] = lf;
+                MapName(it.first, lf, true);
             }
-            uuid_by_name[lf->GetAliasW()] = lf;
+            MapName(lf->GetAliasW(), lf, true);
         }
         Log::Log("%s: Loaded friends from ini\n", Name());
         friends_list_checked = false;
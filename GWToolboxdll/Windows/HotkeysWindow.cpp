@@ -26,6 +26,35 @@ namespace {
     // Subset of hotkeys that are valid to current character/map combo
     std::vector<TBHotkey*> valid_hotkeys;
 
+    // Hotkeys bound to the same key and modifiers, in list order.
+    // The buckets only change when the hotkey list does; the validity mask is refreshed when the character/map context changes
+    struct HotkeyBucket {
+        std::vector<TBHotkey*> hotkeys;
+        std::vector<bool> valid;
+    };
+    std::unordered_map<uint64_t, HotkeyBucket> buckets_by_combo;
+    // All hotkeys bound to a key regardless of modifiers or validity, used to release them on key up
+    std::unordered_map<long, std::vector<TBHotkey*>> hotkeys_by_key;
+
+    uint64_t GetComboKey(const long key, const long modifier)
+    {
+        return static_cast<uint64_t>(static_cast<uint32_t>(key)) << 32 | static_cast<uint32_t>(modifier);
+    }
+
+    // Character/map context that the validity masks were last computed for
+    struct ValidityContext {
+        std::string player_name;
+        GW::Constants::InstanceType instance_type = GW::Constants::InstanceType::Loading;
+        GW::Constants::MapID map_id = GW::Constants::MapID::None;
+        GW::Constants::Profession primary = GW::Constants::Profession::None;
+        bool is_pvp = false;
+
+        bool operator==(const ValidityContext&) const = default;
+    };
+    ValidityContext valid_context;
+    // Set when the hotkey list (or any hotkey in it) has changed since the last time valid_hotkeys was populated
+    bool hotkeys_dirty = true;
+
     // Ordered subsets
     enum class GroupBy : int {
         None [[maybe_unused]],
@@ -106,6 +135,21 @@ namespace {
             && IsFrameCreated(GW::UI::GetFrameByLabel(L"Skillbar"));
     }
 
+    // Rebuilds the key lookups from the hotkey list. Must be called whenever a hotkey is added, removed, rebound or reordered.
+    void BuildHotkeyBuckets()
+    {
+        buckets_by_combo.clear();
+        hotkeys_by_key.clear();
+        for (auto* hotkey : hotkeys) {
+            auto& bucket = buckets_by_combo[GetComboKey(hotkey->hotkey, hotkey->modifier)];
+            bucket.hotkeys.push_back(hotkey);
+            bucket.valid.push_back(false);
+            hotkeys_by_key[hotkey->hotkey].push_back(hotkey);
+        }
+        valid_hotkeys.clear();
+        hotkeys_dirty = true;
+    }
+
     // Repopulates applicable_hotkeys based on current character/map context.
     // Used because its not necessary to check these vars on every keystroke, only when they change
     bool CheckSetValidHotkeys()
@@ -118,12 +162,26 @@ namespace {
         if (!me) {
             return false;
         }
-        const std::string player_name = GuiUtils::WStringToString(c->player_name);
-        const GW::Constants::InstanceType instance_type = GW::Map::GetInstanceType();
-        const GW::Constants::MapID map_id = GW::Map::GetMapID();
-        const auto primary = static_cast<GW::Constants::Profession>(me->primary);
-        const bool is_pvp = me->IsPvP();
+        ValidityContext context = {
+            GuiUtils::WStringToString(c->player_name),
+            GW::Map::GetInstanceType(),
+            GW::Map::GetMapID(),
+            static_cast<GW::Constants::Profession>(me->primary),
+            me->IsPvP()
+        };
+        if (!hotkeys_dirty && context == valid_context) {
+            return true;
+        }
+        valid_context = std::move(context);
+        hotkeys_dirty = false;
+
+        const auto& [player_name, instance_type, map_id, primary, is_pvp] = valid_context;
         valid_hotkeys.clear();
+        for (auto& [hotkeys_in_bucket, valid] : buckets_by_combo | std::views::values) {
+            for (size_t i = 0; i < hotkeys_in_bucket.size(); i++) {
+                valid[i] = hotkeys_in_bucket[i]->IsValid(player_name.c_str(), instance_type, primary, map_id, is_pvp);
+            }
+        }
         by_profession.clear();
         by_map.clear();
         by_instance_type.clear();
@@ -167,6 +225,17 @@ namespace {
         return true;
     }
 
+    void ReleaseHotkeys(const long key)
+    {
+        const auto found = hotkeys_by_key.find(key);
+        if (found == hotkeys_by_key.end()) {
+            return;
+        }
+        for (TBHotkey* hk : found->second) {
+            hk->pressed = false;
+        }
+    }
+
     bool OnMapChanged()
     {
         if (!IsMapReady()) {
@@ -248,6 +317,7 @@ void HotkeysWindow::Terminate()
         delete hotkey;
     }
     hotkeys.clear();
+    BuildHotkeyBuckets();
     for (auto& label : HotkeyGWKey::control_labels | std::views::values) {
         delete label;
         label = nullptr;
@@ -497,6 +567,7 @@ void HotkeysWindow::Draw(IDirect3DDevice9*)
         }
     }
     if (hotkeys_changed) {
+        BuildHotkeyBuckets();
         CheckSetValidHotkeys();
         TBHotkey::hotkeys_changed = true;
     }
@@ -534,6 +605,7 @@ void HotkeysWindow::LoadSettings(ToolboxIni* ini)
             hotkeys.push_back(hk);
         }
     }
+    BuildHotkeyBuckets();
     CheckSetValidHotkeys();
     TBHotkey::hotkeys_changed = false;
 }
@@ -628,12 +700,15 @@ bool HotkeysWindow::WndProc(const UINT Message, const WPARAM wParam, LPARAM)
                 modifier |= ModKey_Alt;
             }
 
+            const auto found = buckets_by_combo.find(GetComboKey(keyData, modifier));
+            if (found == buckets_by_combo.end()) {
+                return false;
+            }
             bool triggered = false;
-            for (TBHotkey* hk : valid_hotkeys) {
-                if (!block_hotkeys
-                    && !hk->pressed
-                    && keyData == hk->hotkey
-                    && modifier == hk->modifier) {
+            const auto& [bucket_hotkeys, valid] = found->second;
+            for (size_t i = 0; i < bucket_hotkeys.size(); i++) {
+                TBHotkey* hk = bucket_hotkeys[i];
+                if (valid[i] && !hk->pressed) {
                     PushPendingHotkey(hk);
                     if (hk->block_gw) {
                         triggered = true;
@@ -645,26 +720,15 @@ bool HotkeysWindow::WndProc(const UINT Message, const WPARAM wParam, LPARAM)
 
         case WM_KEYUP:
         case WM_SYSKEYUP:
-            for (TBHotkey* hk : hotkeys) {
-                if (hk->pressed && keyData == hk->hotkey) {
-                    hk->pressed = false;
-                }
-            }
+            ReleaseHotkeys(keyData);
             return false;
 
         case WM_XBUTTONUP:
-            for (TBHotkey* hk : hotkeys) {
-                if (hk->pressed && (hk->hotkey == VK_XBUTTON1 || hk->hotkey == VK_XBUTTON2)) {
-                    hk->pressed = false;
-                }
-            }
+            ReleaseHotkeys(VK_XBUTTON1);
+            ReleaseHotkeys(VK_XBUTTON2);
             return false;
         case WM_MBUTTONUP:
-            for (TBHotkey* hk : hotkeys) {
-                if (hk->pressed && hk->hotkey == VK_MBUTTON) {
-                    hk->pressed = false;
-                }
-            }
+            ReleaseHotkeys(VK_MBUTTON);
         default:
             return false;
     }
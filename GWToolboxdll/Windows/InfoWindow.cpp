@@ -35,6 +35,7 @@
 #include <GWCA/Managers/SkillbarMgr.h>
 
 #include <Logger.h>
+#include <Utf8.h>
 
 #include <Widgets/AlcoholWidget.h>
 #include <Widgets/Minimap/Minimap.h>
@@ -51,6 +52,7 @@
 #include <Modules/Resources.h>
 #include <GWCA/Utilities/Hooker.h>
 #include <Modules/GwDatTextureModule.h>
+#include <Utils/GenericPacketBus.h>
 #include <Utils/ToolboxUtils.h>
 #include <GWCA/Context/MapContext.h>
 #include <Modules/ItemDescriptionHandler.h>
@@ -397,7 +399,7 @@ namespace {
         if (ImGui::TreeNodeEx("Guild Info", ImGuiTreeNodeFlags_FramePadding | ImGuiTreeNodeFlags_SpanAvailWidth)) {
             ImGui::PushID("guild_info");
             InfoField("Addr", "0x%p", guild);
-            InfoField("Name", "%s [%s]", GuiUtils::WStringToString(guild->name).c_str(), GuiUtils::WStringToString(guild->tag).c_str());
+            InfoField("Name", "%s [%s]", utf8::Buffer(guild->name).c_str(), utf8::Buffer(guild->tag).c_str());
             InfoField("Faction", "%d (%s)", guild->faction_point, guild->faction ? "Luxon" : "Kurzick");
             ImGui::PopID();
             ImGui::TreePop();
@@ -520,7 +522,7 @@ namespace {
             if (ImGui::TreeNodeEx("Player Info", ImGuiTreeNodeFlags_FramePadding | ImGuiTreeNodeFlags_SpanAvailWidth)) {
                 ImGui::PushID("player_info");
                 InfoField("Addr", "%p", player);
-                InfoField("Name", "%s", GuiUtils::WStringToString(player->name).c_str());
+                InfoField("Name", "%s", utf8::Buffer(player->name).c_str());
                 if (player->active_title_tier) {
                     const GW::TitleTier& tier = GW::GetGameContext()->world->title_tiers[player->active_title_tier];
                     static GuiUtils::EncString title_enc_string;
@@ -705,7 +707,7 @@ namespace {
     void OnRecordedAsyncDecode_Decoded(void* param, const wchar_t* decoded) {
         auto e = (RecordedAsyncDecode*)param;
         e->decoded = decoded;
-        e->decoded_str = GuiUtils::WStringToString(e->decoded);
+        GuiUtils::WStringToString(e->decoded, e->decoded_str);
     }
 
     void __fastcall OnValidateAsyncDecodeStr(void* ecx, void* edx, const wchar_t* s, void* cb, void* wParam) {
@@ -938,6 +940,52 @@ namespace {
             ImGui::PopID();
         }
 
+        if (ImGui::CollapsingHeader("Packet Bus")) {
+            ImGui::PushID("packet_bus");
+            if (ImGui::SmallButton("Reset")) {
+                GenericPacketBus::ResetStats();
+            }
+            const auto capture_path = Resources::GetPath(L"packet_capture.bin");
+            ImGui::SameLine();
+            if (GenericPacketBus::IsRecording()) {
+                if (ImGui::SmallButton("Stop Recording")) {
+                    GenericPacketBus::StopRecording();
+                }
+            }
+            else if (GenericPacketBus::IsReplaying()) {
+                if (ImGui::SmallButton("Stop Replay")) {
+                    GenericPacketBus::StopReplay();
+                }
+            }
+            else {
+                if (ImGui::SmallButton("Record")) {
+                    GenericPacketBus::StartRecording(capture_path);
+                }
+                ImGui::SameLine();
+                if (ImGui::SmallButton("Replay")) {
+                    GenericPacketBus::StartReplay(capture_path, true);
+                }
+                ImGui::SameLine();
+                if (ImGui::SmallButton("Replay (max speed)")) {
+                    GenericPacketBus::StartReplay(capture_path, false);
+                }
+            }
+            ImGui::ShowHelp("Records the generic value packets passing through the bus to packet_capture.bin in the toolbox folder.\n"
+                            "Replayed packets are sent to the modules listening on the bus, but not to the game; modules will show the replayed fight.");
+            if (const auto replay = GenericPacketBus::GetReplayStats(); replay.packets) {
+                const double avg_us = replay.packets_replayed ? replay.dispatch_ms * 1000.0 / replay.packets_replayed : 0.0;
+                ImGui::Text("Replay: %zu/%zu packets, %.2f ms dispatching, avg %.2f us", replay.packets_replayed, replay.packets, replay.dispatch_ms, avg_us);
+            }
+            for (size_t i = 0; i < static_cast<size_t>(GenericPacketBus::Header::Count); i++) {
+                const auto header = static_cast<GenericPacketBus::Header>(i);
+                const auto stats = GenericPacketBus::GetStats(header);
+                const double avg_us = stats.packets ? stats.total_ms * 1000.0 / stats.packets : 0.0;
+                ImGui::Text("%s: %zu subscribers, %llu packets, %llu callbacks, avg %.2f us, max %.3f ms",
+                            GenericPacketBus::GetHeaderName(header), stats.subscribers, stats.packets, stats.callbacks, avg_us, stats.max_ms);
+            }
+            ImGui::PopID();
+        }
+
 
         // For debugging changes to flags/arrays etc
         [[maybe_unused]] const GW::GameContext* g = GW::GetGameContext();
@@ -181,10 +181,10 @@ bool PartySearchWindow::TBParty::FromRegionParty(const GW::PartySearch* party)
     district = party->district;
     language = static_cast<uint8_t>(party->language);
     region_id = static_cast<uint8_t>(GW::Map::GetRegion());
-    message = GuiUtils::WStringToString(party->message);
+    GuiUtils::WStringToString(party->message, message);
     primary = party->primary;
     secondary = party->secondary;
-    player_name = GuiUtils::WStringToString(party->party_leader);
+    GuiUtils::WStringToString(party->party_leader, player_name);
     Log::Log("Party %d updated\n", concat_party_id);
     return true;
 #pragma warning (pop)
@@ -209,7 +209,7 @@ bool PartySearchWindow::TBParty::FromPlayerInMap(const GW::Player* player)
     region_id = static_cast<uint8_t>(GW::Map::GetRegion());
     primary = player->primary;
     secondary = player->secondary;
-    player_name = GuiUtils::WStringToString(player->name);
+    GuiUtils::WStringToString(player->name, player_name);
     Log::Log("Party %d updated\n", concat_party_id);
     return true;
 #pragma warning (pop)
@@ -238,7 +238,7 @@ bool PartySearchWindow::TBParty::FromLocalParty(GW::PartyInfo* party)
     region_id = static_cast<uint8_t>(GW::Map::GetRegion());
     primary = player->primary;
     secondary = player->secondary;
-    player_name = GuiUtils::WStringToString(player->name);
+    GuiUtils::WStringToString(player->name, player_name);
     Log::Log("Party %d updated\n", concat_party_id);
     return true;
 #pragma warning (pop)
@@ -288,10 +288,12 @@ void PartySearchWindow::Initialize()
 
 void PartySearchWindow::ClearParties()
 {
+    const std::lock_guard lock(party_mutex);
     for (const auto& it : party_advertisements) {
         delete it.second;
     }
     party_advertisements.clear();
+    party_rows.Clear();
 }
 
 void PartySearchWindow::FillParties()
@@ -457,6 +459,7 @@ void PartySearchWindow::OnRegionPartyUpdated(GW::HookStatus*, GW::Packet::StoC::
         break;
     }
     if (party_name) {
+        instance.party_rows.Invalidate();
         instance.party_advertisements[party_name] = party;
         if (!party) {
             instance.party_advertisements.erase(party_name);
@@ -656,7 +659,9 @@ void PartySearchWindow::Draw(IDirect3DDevice9*)
             if (i > 0) {
                 ImGui::SameLine(start_x += btn_width);
             }
-            ImGui::Checkbox(party_types[i], &display_party_types[i]);
+            if (ImGui::Checkbox(party_types[i], &display_party_types[i])) {
+                party_rows.Invalidate();
+            }
         }
         ImGui::PopItemWidth();
         ImGui::Text("Party Leader");
@@ -680,33 +685,43 @@ void PartySearchWindow::Draw(IDirect3DDevice9*)
         const auto district = GW::Map::GetDistrict();
         const auto map = static_cast<uint8_t>(GW::Map::GetMapID());
         //auto& parties = party_ctx->party_search;
-        for (const auto& it : party_advertisements) {
-            auto* party = it.second;
-            if (!party) {
-                continue;
-            }
-            if (!display_party_types[party->search_type]) {
-                continue;
-            }
-            if (ignore_party_types[party->search_type]) {
-                continue;
+        // Rows point into party_advertisements, which packet callbacks change and free on the game thread
+        const std::lock_guard lock(party_mutex);
+        party_rows.Update([this](std::vector<PartyRow>& rows) {
+            for (const auto& it : party_advertisements) {
+                auto* party = it.second;
+                if (!party) {
+                    continue;
+                }
+                if (!display_party_types[party->search_type]) {
+                    continue;
+                }
+                if (ignore_party_types[party->search_type]) {
+                    continue;
+                }
+                auto& row = rows.emplace_back();
+                row.party = party;
+                if (party->secondary) {
+                    snprintf(row.label, _countof(row.label), "%s/%s %s",
+                             GetProfessionAcronym(static_cast<GW::Constants::Profession>(party->primary)),
+                             GetProfessionAcronym(static_cast<GW::Constants::Profession>(party->secondary)),
+                             party->player_name.c_str());
+                }
+                else {
+                    snprintf(row.label, _countof(row.label), "%s %s",
+                             GetProfessionAcronym(static_cast<GW::Constants::Profession>(party->primary)),
+                             party->player_name.c_str());
+                }
             }
+            std::ranges::sort(rows, [](const PartyRow& a, const PartyRow& b) {
+                return a.party->player_name < b.party->player_name;
+            });
+        });
+        party_rows.Draw([&](const PartyRow& row) {
+            const auto party = row.party;
             ImGui::PushID(static_cast<int>(party->concat_party_id));
 
-            char label[64];
-            if (party->secondary) {
-                snprintf(label, 64, "%s/%s %s",
-                         GetProfessionAcronym(static_cast<GW::Constants::Profession>(party->primary)),
-                         GetProfessionAcronym(static_cast<GW::Constants::Profession>(party->secondary)),
-                         party->player_name.c_str());
-            }
-            else {
-                snprintf(label, 64, "%s %s",
-                         GetProfessionAcronym(static_cast<GW::Constants::Profession>(party->primary)),
-                         party->player_name.c_str());
-            }
-
-            if (ImGui::Button(label, ImVec2(playernamewidth, 0))) {
+            if (ImGui::Button(row.label, ImVec2(playernamewidth, 0))) {
                 std::wstring leader_name = GuiUtils::StringToWString(party->player_name);
                 // open whisper to player
                 GW::GameThread::Enqueue([leader_name] {
@@ -732,7 +747,7 @@ void PartySearchWindow::Draw(IDirect3DDevice9*)
             ImGui::SameLine(message_left);
             ImGui::Text(party->is_hard_mode ? "[Hard Mode] [%s] %s" : "[%s] %s", party_types[party->search_type], party->message.c_str());
             ImGui::PopID();
-        }
+        });
         ImGui::EndChild();
     }
 
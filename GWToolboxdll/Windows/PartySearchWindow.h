@@ -3,6 +3,7 @@
 #include <CircurlarBuffer.h>
 #include <ToolboxWindow.h>
 #include <Utils/RateLimiter.h>
+#include <Utils/ListView.h>
 
 class PartySearchWindow : public ToolboxWindow {
 public:
@@ -75,6 +76,14 @@ private:
 
     std::unordered_map<std::wstring, TBParty*> party_advertisements{};
 
+    struct PartyRow {
+        TBParty* party = nullptr;
+        char label[64]{};
+    };
+    // Parties shown in the window sorted by leader; invalidated whenever party_advertisements or the type filters change.
+    // Built and drawn with party_mutex held, since the rows point into party_advertisements.
+    ListView<PartyRow> party_rows;
+
     WSAData wsaData = {0};
 
     bool show_alert_window = false;
@@ -13,6 +13,10 @@
 
 #include <Windows/TargetInfoWindow.h>
 #include <Utils/GuiUtils.h>
+#include <Utils/HtmlTokenizer.h>
+#include <Utils/WikiCache.h>
+
+using nlohmann::json;
 
 namespace {
 
@@ -53,27 +57,6 @@ namespace {
     {
         return ltrim(rtrim(s, t), t);
     }
-    // Make sure you pass valid html e.g. start with a < tag
-    std::string& strip_tags(std::string& html) {
-        while (1)
-        {
-            auto startpos = html.find("<");
-            if (startpos == std::string::npos)
-                break;
-            auto endpos = html.find(">", startpos) + 1;
-            if (endpos == std::string::npos)
-                break;
-            html.erase(startpos, endpos - startpos);
-        }
-
-        return html;
-    }
-    std::string& from_html(std::string& html) {
-        strip_tags(html);
-        trim(html);
-        return html;
-    }
-
 
     struct AgentInfo {
         GuiUtils::EncString name;
@@ -110,6 +93,137 @@ namespace {
         }
     };
 
+    constexpr std::string_view wiki_cache_name = "target_info";
+
+    // Value of the first title attribute in html, decoded
+    std::string GetFirstTitle(const std::string_view html)
+    {
+        Html::Tokenizer tokenizer(html);
+        Html::Token token;
+        while (tokenizer.Next(token)) {
+            if (token.type != Html::Token::Type::StartTag) {
+                continue;
+            }
+            const auto title = Html::GetAttribute(token.attributes, "title");
+            if (!title.empty()) {
+                return Html::DecodeEntities(title);
+            }
+        }
+        return {};
+    }
+
+    void AddWikiSkill(AgentInfo* agent_info, const std::string& skill_name)
+    {
+        const auto found = skill_ids_by_name.find(skill_name);
+        if (found != skill_ids_by_name.end() && !std::ranges::contains(agent_info->wiki_skills, found->second)) {
+            agent_info->wiki_skills.push_back(found->second);
+        }
+    }
+
+    void SetWikiImage(AgentInfo* agent_info, const std::string& image_url)
+    {
+        if (image_url.empty()) {
+            return;
+        }
+        agent_info->image_url = image_url;
+        agent_info->image = Resources::GetGuildWarsWikiImage(image_url.c_str());
+    }
+
+    void ParseWikiPage(AgentInfo* agent_info)
+    {
+        const std::string_view page = agent_info->wiki_content;
+
+        // Skills listed under the "Skills" heading
+        Html::ForEachLink(Html::FindSection(page, "Skills", "ul"), [agent_info](const std::string_view title, const std::string_view href) {
+            if (!href.empty()) {
+                AddWikiSkill(agent_info, Html::DecodeEntities(title));
+            }
+        });
+
+        // Armor ratings table; cells come in pairs of linked rating type and value
+        Html::ForEachTableRow(Html::FindSection(page, "Armor_ratings", "table"), [agent_info](const std::vector<std::string_view>& cells) {
+            for (size_t i = 0; i + 1 < cells.size(); i++) {
+                const auto key = GetFirstTitle(cells[i]);
+                const auto val = Html::ToText(cells[i + 1]);
+                if (key.empty() || val.empty() || val.find_first_not_of("0123456789 ()") != std::string::npos) {
+                    continue;
+                }
+                agent_info->wiki_armor_ratings[key] = val;
+                i++;
+            }
+        });
+
+        const auto infobox_content = Html::FindElement(page, "table", [](const std::string_view attributes) {
+            return Html::HasClass(attributes, "infobox");
+        });
+        if (infobox_content.empty()) {
+            return;
+        }
+        const auto infobox_image = Html::FindElement(infobox_content, "td", [](const std::string_view attributes) {
+            return Html::GetAttribute(attributes, "class").contains("infobox-image");
+        });
+        // Image links don't always have a title, so ForEachLink won't do here
+        Html::Tokenizer tokenizer(infobox_image);
+        Html::Token token;
+        while (agent_info->image_url.empty() && tokenizer.Next(token)) {
+            if (token.type != Html::Token::Type::StartTag || token.name != "a") {
+                continue;
+            }
+            const auto href = Html::GetAttribute(token.attributes, "href");
+            if (const auto file = href.find("File:"); file != std::string_view::npos) {
+                SetWikiImage(agent_info, std::string(href.substr(file + 5)));
+            }
+        }
+
+        Html::ForEachInfoboxRow(infobox_content, [agent_info](const std::string_view th, const std::string_view td) {
+            auto key = Html::ToText(th);
+            auto val = Html::ToText(td);
+            if (key.empty() || val.empty()) {
+                return;
+            }
+            agent_info->infobox_deets[key] = val;
+        });
+    }
+
+    void SaveToWikiCache(const AgentInfo* agent_info, const uint32_t revision)
+    {
+        auto skills = json::array();
+        for (const auto skill_id : agent_info->wiki_skills) {
+            skills.push_back(static_cast<uint32_t>(skill_id));
+        }
+        const json result = {
+            {"skills", skills},
+            {"armor_ratings", agent_info->wiki_armor_ratings},
+            {"infobox", agent_info->infobox_deets},
+            {"image_url", agent_info->image_url}
+        };
+        WikiCache::Set(wiki_cache_name, agent_info->wiki_search_term, revision, result);
+    }
+
+    void LoadFromWikiCache(AgentInfo* agent_info, const json& result)
+    {
+        if (const auto skills = result.find("skills"); skills != result.end() && skills->is_array()) {
+            for (const auto& skill_id : *skills) {
+                if (skill_id.is_number_unsigned()) {
+                    agent_info->wiki_skills.push_back(static_cast<GW::Constants::SkillID>(skill_id.get<uint32_t>()));
+                }
+            }
+        }
+        const auto load_map = [](const json& obj, std::unordered_map<std::string, std::string>& out) {
+            if (!obj.is_object()) {
+                return;
+            }
+            for (const auto& [key, val] : obj.items()) {
+                if (val.is_string()) {
+                    out[key] = val.get<std::string>();
+                }
+            }
+        };
+        load_map(result.value("armor_ratings", json::object()), agent_info->wiki_armor_ratings);
+        load_map(result.value("infobox", json::object()), agent_info->infobox_deets);
+        SetWikiImage(agent_info, result.value("image_url", std::string()));
+    }
+
     std::unordered_map<std::wstring,AgentInfo*> agent_info_by_name;
 
     GW::Agent* info_target = 0;
@@ -180,91 +294,38 @@ namespace {
                     agent_info->state = AgentInfo::TargetInfoState::Done;
                     break;
                 }
+                // Cache is read on a worker the first time; try again next frame
+                if (!WikiCache::IsLoaded(wiki_cache_name))
+                    break;
                 agent_info->state = AgentInfo::TargetInfoState::FetchingWikiPage;
 
                 agent_info->wiki_search_term = GuiUtils::WStringToString(
                     GuiUtils::SanitizePlayerName(agent_info->name.wstring())
                 );
                 trim(agent_info->wiki_search_term);
+                if (json cached; WikiCache::Get(wiki_cache_name, agent_info->wiki_search_term, cached, std::chrono::days(7))) {
+                    LoadFromWikiCache(agent_info, cached);
+                    agent_info->state = AgentInfo::TargetInfoState::Done;
+                    break;
+                }
                 std::string wiki_url = "https://wiki.guildwars.com/wiki/?search=";
                 wiki_url.append(GuiUtils::UrlEncode(agent_info->wiki_search_term, '_'));
                 Resources::Download(wiki_url, AgentInfo::OnFetchedWikiPage, agent_info);
             } break;
-            case AgentInfo::TargetInfoState::ParsingWikiPage:
-                Log::InfoW(L"Got wiki page for %ls, need to write the code to parse!!", agent_info->name.wstring().c_str());
-
-                static const std::regex skill_list_regex("<h2><span class=\"mw-headline\" id=\"Skills\">([\\s\\S]*?)</ul>");
-                std::smatch m;
-                if (std::regex_search(agent_info->wiki_content, m, skill_list_regex)) {
-                    std::string skill_list_found = m[1].str();
-
-                    // Iterate over all skills in this list.
-                    const auto skill_link_regex = std::regex("<a href=\"[^\"]+\" title=\"([^\"]+)\"");
-                    auto words_begin = std::sregex_iterator(skill_list_found.begin(), skill_list_found.end(), skill_link_regex);
-                    auto words_end = std::sregex_iterator();
-                    for (std::sregex_iterator i = words_begin; i != words_end; ++i)
-                    {
-                        const auto skill_name = i->str(1);
-                        const auto found = skill_ids_by_name.find(skill_name);
-                        if (found == skill_ids_by_name.end())
-                            continue;
-                        if (std::ranges::contains(agent_info->wiki_skills, found->second))
-                            continue;
-                        agent_info->wiki_skills.push_back(found->second);
-                    }
+            case AgentInfo::TargetInfoState::ParsingWikiPage: {
+                const auto revision = Html::GetWikiRevision(agent_info->wiki_content);
+                if (json cached; WikiCache::GetForRevision(wiki_cache_name, agent_info->wiki_search_term, revision, cached)) {
+                    LoadFromWikiCache(agent_info, cached);
                 }
-
-                static const std::regex armor_ratings_regex("<h2><span class=\"mw-headline\" id=\"Armor_ratings\">([\\s\\S]*?)</table>");
-                if (std::regex_search(agent_info->wiki_content, m, armor_ratings_regex)) {
-                    std::string armor_table_found = m[1].str();
-                    armor_table_found.erase(std::ranges::remove(armor_table_found, '\n').begin(), armor_table_found.end());
-
-                    // Iterate over all skills in this list.
-                    static const std::regex armor_cell_regex(R"regex(<td>[\s\S]*?title="([^"]+)"[\s\S]*?<td>([0-9 \(\)]+).*?<\/td>)regex");
-                    auto words_begin = std::sregex_iterator(armor_table_found.begin(), armor_table_found.end(), armor_cell_regex);
-                    auto words_end = std::sregex_iterator();
-                    for (auto i = words_begin; i != words_end; ++i)
-                    {
-                        auto key = i->str(1);
-                        auto val = i->str(2);
-                        from_html(key);
-                        from_html(val);
-                        if (key.empty() || val.empty())
-                            continue;
-                        agent_info->wiki_armor_ratings[key] = val;
-                    }
+                else {
+                    ParseWikiPage(agent_info);
+                    SaveToWikiCache(agent_info, revision);
                 }
-
-                const std::regex infobox_regex("<table[^>]+ class=\"[^\"]+infobox([\\s\\S]*?)</table>");
-                if (std::regex_search(agent_info->wiki_content, m, infobox_regex)) {
-                    std::string infobox_content = m[1].str();
-
-                    const auto infobox_image_regex = std::regex("<td[^>]+class=\"[^\"]*?infobox-image[\\s\\S]*?<a [\\s\\S]*?href=\"[^\"]*?File:([^\"]+)");
-                    if (std::regex_search(infobox_content, m, infobox_image_regex)) {
-                        const auto img_src = m[1].str();
-                        agent_info->image_url = img_src;
-                        agent_info->image = Resources::GetGuildWarsWikiImage(img_src.c_str());
-                    }
-
-                    // Iterate over all skills in this list.
-                    const auto infobox_row_regex = std::regex(
-                        "(?:<tr>|<tr[^>]+>)[\\s\\S]*?(?:<th>|<th[^>]+>)([\\s\\S]*?)</th>[\\s\\S]*?(?:<td>|<td[^>]+>)([\\s\\S]*?)</td>[\\s\\S]*?</tr>"
-                    );
-                    auto words_begin = std::sregex_iterator(infobox_content.begin(), infobox_content.end(), infobox_row_regex);
-                    auto words_end = std::sregex_iterator();
-                    for (std::sregex_iterator i = words_begin; i != words_end; ++i)
-                    {
-                        auto key = i->str(1);
-                        auto val = i->str(2);
-                        from_html(key);
-                        from_html(val);
-                        if (key.empty() || val.empty())
-                            continue;
-                        agent_info->infobox_deets[key] = val;
-                    }
-                }
-
+                agent_info->wiki_content.clear();
+                agent_info->wiki_content.shrink_to_fit();
                 agent_info->state = AgentInfo::TargetInfoState::Done;
+            } break;
+            default:
                 break;
             }
         }
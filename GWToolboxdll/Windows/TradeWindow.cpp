@@ -198,8 +198,8 @@ void TradeWindow::OnMessageLocal(GW::HookStatus* status, const GW::Packet::StoC:
         end = &message[i];
     }
 
-    // std::string temp(start, end);
-    std::string message_utf8 = GuiUtils::WStringToString(std::wstring(start, end));
+    static std::string message_utf8;
+    GuiUtils::WStringToString({start, static_cast<size_t>(end - start)}, message_utf8);
     if (!Instance().IsTradeAlert(message_utf8)) {
         status->blocked = true;
     }
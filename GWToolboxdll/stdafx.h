@@ -17,6 +17,7 @@
 // c++ headers
 #include <array>
 #include <algorithm>
+#include <bit>
 #include <bitset>
 #include <chrono>
 #include <concepts>
@@ -0,0 +1,495 @@
+// Turns the binary log GWToolbox writes (log.bin) back into text; see GWToolboxdll/BinaryLogFormat.h for the layout.
+// Standard C++ only, so it can be built anywhere a log needs reading:
+//   cmake -S LogDecoder -B build && cmake --build build
+//   LogDecoder [--level <name>] [--category <name>]... [--utc] <log.bin>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <BinaryLogFormat.h>
+
+using namespace BinaryLog;
+
+namespace {
+    struct Format {
+        std::string text;
+        bool wide = false;
+    };
+
+    struct Line {
+        uint64_t time_us = 0;
+        uint32_t thread_id = 0;
+        Level level = Level::Info;
+        Category category = Category::General;
+        std::string message;
+    };
+
+    // Reads little endian values out of the file, remembering when it runs past the end
+    class Reader {
+    public:
+        Reader(const uint8_t* _data, const size_t _size)
+            : data(_data), size(_size) { }
+
+        template <typename T>
+        T Get()
+        {
+            T value{};
+            if (!Has(sizeof(T))) {
+                failed = true;
+                pos = size;
+                return value;
+            }
+            memcpy(&value, data + pos, sizeof(T));
+            pos += sizeof(T);
+            return value;
+        }
+
+        const uint8_t* Bytes(const size_t count)
+        {
+            if (!Has(count)) {
+                failed = true;
+                pos = size;
+                return nullptr;
+            }
+            const uint8_t* bytes = data + pos;
+            pos += count;
+            return bytes;
+        }
+
+        [[nodiscard]] bool Has(const size_t count) const { return size - pos >= count; }
+        [[nodiscard]] bool AtEnd() const { return pos >= size; }
+        [[nodiscard]] size_t Position() const { return pos; }
+
+        bool failed = false;
+
+    private:
+        const uint8_t* data;
+        size_t size;
+        size_t pos = 0;
+    };
+
+    void AppendUtf8(std::string& out, const uint32_t code_point)
+    {
+        if (code_point < 0x80) {
+            out += static_cast<char>(code_point);
+        }
+        else if (code_point < 0x800) {
+            out += static_cast<char>(0xC0 | code_point >> 6);
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+        else if (code_point < 0x10000) {
+            out += static_cast<char>(0xE0 | code_point >> 12);
+            out += static_cast<char>(0x80 | (code_point >> 6 & 0x3F));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+        else {
+            out += static_cast<char>(0xF0 | code_point >> 18);
+            out += static_cast<char>(0x80 | (code_point >> 12 & 0x3F));
+            out += static_cast<char>(0x80 | (code_point >> 6 & 0x3F));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+    }
+
+    std::string FromUtf16(const uint8_t* units, const size_t count)
+    {
+        std::string out;
+        out.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            uint16_t unit;
+            memcpy(&unit, units + i * 2, sizeof(unit));
+            uint32_t code_point = unit;
+            if (unit >= 0xD800 && unit < 0xDC00 && i + 1 < count) {
+                uint16_t low;
+                memcpy(&low, units + (i + 1) * 2, sizeof(low));
+                if (low >= 0xDC00 && low < 0xE000) {
+                    code_point = 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+                    i++;
+                }
+            }
+            else if (unit >= 0xD800 && unit < 0xE000) {
+                code_point = 0xFFFD;
+            }
+            AppendUtf8(out, code_point);
+        }
+        return out;
+    }
+
+    // One argument as the logging process stored it
+    struct Argument {
+        ArgType type{};
+        int64_t integer = 0;
+        double real = 0;
+        std::string text;
+    };
+
+    bool ReadArgument(Reader& reader, Argument& arg)
+    {
+        arg = {};
+        arg.type = reader.Get<ArgType>();
+        switch (arg.type) {
+            case ArgType::Int32:
+                arg.integer = reader.Get<int32_t>();
+                break;
+            case ArgType::Int64:
+                arg.integer = reader.Get<int64_t>();
+                break;
+            case ArgType::Double:
+                arg.real = reader.Get<double>();
+                break;
+            case ArgType::Pointer:
+                arg.integer = static_cast<int64_t>(reader.Get<uint64_t>());
+                break;
+            case ArgType::String: {
+                const auto len = reader.Get<uint16_t>();
+                if (const auto bytes = reader.Bytes(len)) {
+                    arg.text.assign(reinterpret_cast<const char*>(bytes), len);
+                }
+                break;
+            }
+            case ArgType::WideString: {
+                const auto len = reader.Get<uint16_t>();
+                if (const auto bytes = reader.Bytes(len * size_t{2})) {
+                    arg.text = FromUtf16(bytes, len);
+                }
+                break;
+            }
+            case ArgType::NullString:
+                arg.text = "(null)";
+                break;
+            default:
+                return false;
+        }
+        return !reader.failed;
+    }
+
+    // Literal text between specifications, with %% collapsed
+    void AppendLiteral(std::string& out, const char* begin, const char* end)
+    {
+        for (const char* p = begin; p < end; p++) {
+            out += *p;
+            if (*p == '%' && p + 1 < end && p[1] == '%') {
+                p++;
+            }
+        }
+    }
+
+    // snprintf into out
+    template <typename... Args>
+    void AppendFormatted(std::string& out, const std::string& format, Args... args)
+    {
+        const int len = snprintf(nullptr, 0, format.c_str(), args...);
+        if (len <= 0) {
+            return;
+        }
+        const size_t offset = out.size();
+        out.resize(offset + static_cast<size_t>(len) + 1);
+        snprintf(out.data() + offset, static_cast<size_t>(len) + 1, format.c_str(), args...);
+        out.resize(offset + static_cast<size_t>(len));
+    }
+
+    // Substitutes the stored arguments into format, the same way the logging process would have
+    std::string Render(const Format& format, Reader& args, const uint32_t pointer_size)
+    {
+        std::string out;
+        const char* literal = format.text.c_str();
+        FormatSpec<char> spec;
+        const char* next = literal;
+        Argument arg;
+        while ((next = NextFormatSpec(next, format.wide, spec)) != nullptr) {
+            if (spec.conversion == Conversion::Invalid) {
+                // Arguments can't be followed past this; the rest, this specification included, goes out as text
+                break;
+            }
+            AppendLiteral(out, literal, spec.begin);
+            literal = spec.end;
+            // Flags, width and precision carry over as they are, with any * filled in
+            std::string c_spec = "%";
+            const char* p = spec.begin + 1;
+            const auto fill_star = [&] {
+                if (*p != '*') {
+                    return true;
+                }
+                p++;
+                if (!ReadArgument(args, arg)) {
+                    return false;
+                }
+                c_spec += std::to_string(arg.integer);
+                return true;
+            };
+            while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0') {
+                c_spec += *p++;
+            }
+            if (!fill_star()) {
+                out += "<missing>";
+                return out;
+            }
+            while (*p >= '0' && *p <= '9') {
+                c_spec += *p++;
+            }
+            if (*p == '.') {
+                c_spec += *p++;
+                if (!fill_star()) {
+                    out += "<missing>";
+                    return out;
+                }
+                while (*p >= '0' && *p <= '9') {
+                    c_spec += *p++;
+                }
+            }
+            if (!ReadArgument(args, arg)) {
+                out += "<missing>";
+                return out;
+            }
+            const char conversion = spec.end[-1];
+            switch (spec.conversion) {
+                case Conversion::Int:
+                case Conversion::LongLong:
+                case Conversion::Size:
+                    // The stored width says how much of the value is meaningful
+                    if (conversion == 'd' || conversion == 'i') {
+                        const auto value = arg.type == ArgType::Int32 ? static_cast<int32_t>(arg.integer) : arg.integer;
+                        AppendFormatted(out, c_spec + "ll" + conversion, static_cast<long long>(value));
+                    }
+                    else {
+                        const auto value = arg.type == ArgType::Int32 ? static_cast<uint32_t>(arg.integer) : static_cast<uint64_t>(arg.integer);
+                        AppendFormatted(out, c_spec + "ll" + conversion, static_cast<unsigned long long>(value));
+                    }
+                    break;
+                case Conversion::Double:
+                    AppendFormatted(out, c_spec + conversion, arg.real);
+                    break;
+                case Conversion::Pointer:
+                    if (conversion == 'p') {
+                        // MSVC prints pointers as upper case hex, padded to the pointer size
+                        AppendFormatted(out, std::string("%0*llX"), static_cast<int>(pointer_size * 2), static_cast<unsigned long long>(arg.integer));
+                    }
+                    break;
+                case Conversion::Char: {
+                    std::string ch(1, static_cast<char>(arg.integer));
+                    AppendFormatted(out, c_spec + 's', ch.c_str());
+                    break;
+                }
+                case Conversion::WideChar: {
+                    std::string ch;
+                    AppendUtf8(ch, static_cast<uint16_t>(arg.integer));
+                    AppendFormatted(out, c_spec + 's', ch.c_str());
+                    break;
+                }
+                case Conversion::String:
+                case Conversion::WideString:
+                    AppendFormatted(out, c_spec + 's', arg.text.c_str());
+                    break;
+                default:
+                    break;
+            }
+        }
+        AppendLiteral(out, literal, format.text.c_str() + format.text.size());
+        return out;
+    }
+
+    template <size_t N>
+    int FindName(const char* const (&names)[N], const std::string_view name)
+    {
+        for (size_t i = 0; i < N; i++) {
+            if (name.size() == strlen(names[i]) && std::equal(name.begin(), name.end(), names[i], [](const char a, const char b) {
+                return tolower(static_cast<unsigned char>(a)) == tolower(static_cast<unsigned char>(b));
+            })) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    std::string FormatTime(const int64_t unix_us, const bool utc)
+    {
+        const time_t seconds = static_cast<time_t>(unix_us / 1000000);
+        tm parts{};
+#ifdef _WIN32
+        utc ? gmtime_s(&parts, &seconds) : localtime_s(&parts, &seconds);
+#else
+        utc ? gmtime_r(&seconds, &parts) : localtime_r(&seconds, &parts);
+#endif
+        char buffer[32];
+        const size_t len = strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &parts);
+        snprintf(buffer + len, sizeof(buffer) - len, ".%03d", static_cast<int>(unix_us / 1000 % 1000));
+        return buffer;
+    }
+
+    int Usage()
+    {
+        fprintf(stderr, "Usage: LogDecoder [--level <minimum level>] [--category <category>]... [--utc] <log.bin>\n");
+        fprintf(stderr, "Levels:");
+        for (const auto name : level_names) {
+            fprintf(stderr, " %s", name);
+        }
+        fprintf(stderr, "\nCategories:");
+        for (const auto name : category_names) {
+            fprintf(stderr, " %s", name);
+        }
+        fprintf(stderr, "\n");
+        return 1;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int minimum_level = 0;
+    std::vector<bool> categories;
+    bool utc = false;
+    const char* path = nullptr;
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        if ((arg == "--level" || arg == "-l") && i + 1 < argc) {
+            minimum_level = FindName(level_names, argv[++i]);
+            if (minimum_level < 0) {
+                fprintf(stderr, "Unknown level %s\n", argv[i]);
+                return Usage();
+            }
+        }
+        else if ((arg == "--category" || arg == "-c") && i + 1 < argc) {
+            const int category = FindName(category_names, argv[++i]);
+            if (category < 0) {
+                fprintf(stderr, "Unknown category %s\n", argv[i]);
+                return Usage();
+            }
+            categories.resize(std::size(category_names));
+            categories[category] = true;
+        }
+        else if (arg == "--utc") {
+            utc = true;
+        }
+        else if (!path && !arg.starts_with('-')) {
+            path = argv[i];
+        }
+        else {
+            return Usage();
+        }
+    }
+    if (!path) {
+        return Usage();
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        fprintf(stderr, "Failed to open %s\n", path);
+        return 1;
+    }
+    const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    Reader reader(data.data(), data.size());
+
+    const auto file_magic = reader.Bytes(sizeof(magic));
+    if (!file_magic || memcmp(file_magic, magic, sizeof(magic)) != 0) {
+        fprintf(stderr, "%s isn't a GWToolbox binary log\n", path);
+        return 1;
+    }
+    const auto file_version = reader.Get<uint32_t>();
+    if (file_version != version) {
+        fprintf(stderr, "%s is version %u; this decoder reads version %u\n", path, file_version, version);
+        return 1;
+    }
+    const auto pointer_size = reader.Get<uint32_t>();
+    const auto start_unix_us = reader.Get<int64_t>();
+    if (reader.failed) {
+        fprintf(stderr, "%s is truncated\n", path);
+        return 1;
+    }
+
+    std::unordered_map<uint32_t, Format> formats;
+    std::vector<Line> lines;
+    const auto read_header = [&](Line& line) {
+        line.time_us = reader.Get<uint64_t>();
+        line.thread_id = reader.Get<uint32_t>();
+        line.level = reader.Get<Level>();
+        line.category = reader.Get<Category>();
+    };
+    size_t record_start = 0;
+    while (!reader.AtEnd() && !reader.failed) {
+        record_start = reader.Position();
+        Line line;
+        switch (reader.Get<RecordType>()) {
+            case RecordType::Format: {
+                const auto id = reader.Get<uint32_t>();
+                Format& format = formats[id];
+                format.wide = reader.Get<uint8_t>() != 0;
+                const auto len = reader.Get<uint16_t>();
+                if (const auto bytes = reader.Bytes(len)) {
+                    format.text.assign(reinterpret_cast<const char*>(bytes), len);
+                }
+                continue;
+            }
+            case RecordType::Entry: {
+                read_header(line);
+                const auto id = reader.Get<uint32_t>();
+                const auto len = reader.Get<uint16_t>();
+                const auto bytes = reader.Bytes(len);
+                if (!bytes) {
+                    break;
+                }
+                const auto found = formats.find(id);
+                if (found == formats.end()) {
+                    line.message = "<unknown format " + std::to_string(id) + ">";
+                }
+                else {
+                    Reader args(bytes, len);
+                    line.message = Render(found->second, args, pointer_size);
+                }
+                break;
+            }
+            case RecordType::Text: {
+                read_header(line);
+                Argument text;
+                if (ReadArgument(reader, text)) {
+                    line.message = std::move(text.text);
+                }
+                break;
+            }
+            case RecordType::Dropped:
+                line.time_us = reader.Get<uint64_t>();
+                line.thread_id = reader.Get<uint32_t>();
+                line.level = Level::Warning;
+                line.message = std::to_string(reader.Get<uint32_t>()) + " entries dropped; the thread logged faster than they could be written";
+                break;
+            default:
+                fprintf(stderr, "Unknown record at offset %zu; stopping there\n", record_start);
+                reader.failed = true;
+                continue;
+        }
+        if (reader.failed) {
+            break;
+        }
+        if (static_cast<int>(line.level) < minimum_level || (!categories.empty() && (static_cast<size_t>(line.category) >= categories.size() || !categories[static_cast<size_t>(line.category)]))) {
+            continue;
+        }
+        lines.push_back(std::move(line));
+    }
+    if (reader.failed) {
+        // Most likely the process died mid-write; everything before that is still good
+        fprintf(stderr, "%s ends partway through a record at offset %zu\n", path, record_start);
+    }
+
+    // Each thread's entries are in order, but threads are written out in batches
+    std::ranges::stable_sort(lines, {}, &Line::time_us);
+
+    for (auto& line : lines) {
+        while (!line.message.empty() && (line.message.back() == '\n' || line.message.back() == '\r')) {
+            line.message.pop_back();
+        }
+        const auto level = static_cast<size_t>(line.level);
+        const auto category = static_cast<size_t>(line.category);
+        printf("[%s] [%u] [%s] [%s] %s\n",
+               FormatTime(start_unix_us + static_cast<int64_t>(line.time_us), utc).c_str(),
+               line.thread_id,
+               level < std::size(level_names) ? level_names[level] : "?",
+               category < std::size(category_names) ? category_names[category] : "?",
+               line.message.c_str());
+    }
+    return 0;
+}
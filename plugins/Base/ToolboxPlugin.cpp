@@ -4,6 +4,33 @@
 
 import PluginUtils;
 
+namespace {
+    void __cdecl RunTask(void* context)
+    {
+        const auto task = static_cast<std::function<void()>*>(context);
+        (*task)();
+        delete task;
+    }
+
+    bool EnqueueTask(const HMODULE toolbox_dll, const PluginTaskThread thread, std::function<void()>&& task)
+    {
+        if (!toolbox_dll || !task) {
+            return false;
+        }
+        const auto enqueue_fn = reinterpret_cast<ToolboxPluginEnqueueTaskFn>(GetProcAddress(toolbox_dll, ToolboxPluginEnqueueTaskName));
+        if (!enqueue_fn) {
+            return false; // Older toolbox without async support
+        }
+        // Allocated and freed on our side of the dll boundary
+        const auto context = new std::function<void()>(std::move(task));
+        if (!enqueue_fn(plugin_handle, thread, RunTask, context)) {
+            delete context;
+            return false;
+        }
+        return true;
+    }
+}
+
 std::filesystem::path ToolboxPlugin::GetSettingFile(const wchar_t* folder) const
 {
     const auto wname = PluginUtils::StringToWString(Name());
@@ -17,3 +44,13 @@ void ToolboxPlugin::Initialize(ImGuiContext* ctx, const ImGuiAllocFns allocator_
     ImGui::SetAllocatorFunctions(allocator_fns.alloc_func, allocator_fns.free_func, allocator_fns.user_data);
     toolbox_handle = toolbox_dll;
 }
+
+bool ToolboxPlugin::EnqueueWorkerTask(std::function<void()> task) const
+{
+    return EnqueueTask(toolbox_handle, PluginTaskThread::Worker, std::move(task));
+}
+
+bool ToolboxPlugin::EnqueueMainTask(std::function<void()> task) const
+{
+    return EnqueueTask(toolbox_handle, PluginTaskThread::Main, std::move(task));
+}
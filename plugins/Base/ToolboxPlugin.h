@@ -27,6 +27,21 @@ struct ImGuiAllocFns {
     void* user_data = nullptr;
 };
 
+//
+// Async task interface, exported by GWToolbox.dll.
+// Plugins should use ToolboxPlugin::EnqueueWorkerTask/EnqueueMainTask instead of calling this directly.
+//
+enum class PluginTaskThread : uint32_t {
+    // Toolbox worker thread, away from the game and render loops e.g. file or web requests
+    Worker,
+    // Next update of the game thread
+    Main
+};
+using PluginTaskFn = void(__cdecl*)(void* context);
+// Returns false if the task wasn't queued, e.g. because the plugin is being unloaded; fn won't be called in that case.
+using ToolboxPluginEnqueueTaskFn = bool(__cdecl*)(HMODULE plugin, PluginTaskThread thread, PluginTaskFn fn, void* context);
+inline constexpr auto ToolboxPluginEnqueueTaskName = "ToolboxPluginEnqueueTask";
+
 //
 // Dll interface.
 //
@@ -76,9 +91,11 @@ public:
 
     // Update. Will be called once every frame unless the world map is showing and ShowInWorldMap returns false.
     // Delta is in milliseconds.
+    // Runs on the game thread and is timed by Toolbox; move anything slow to EnqueueWorkerTask().
     virtual void Update(float) {}
 
     // Draw. Will always be called once every frame.
+    // Runs on the render thread and is timed by Toolbox; keep it to ImGui and device calls.
     virtual void Draw(IDirect3DDevice9*) {}
 
     // Optional. Prefer using ImGui::GetIO() during update or render, if possible.
@@ -97,6 +114,12 @@ public:
     virtual bool DrawTabButton(bool, bool, bool) { return false; }
 
 protected:
+    // Run task on the Toolbox worker thread. Returns false if Toolbox refused it, e.g. because this plugin is being unloaded.
+    // The plugin won't be unloaded until every task it queued has run.
+    bool EnqueueWorkerTask(std::function<void()> task) const;
+    // Run task on the game thread, during the next Toolbox update. Use this to hand the result of a worker task back.
+    bool EnqueueMainTask(std::function<void()> task) const;
+
     HMODULE toolbox_handle = nullptr;
     CSimpleIniA ini{};
 };
@@ -17,6 +17,7 @@
 // c++ headers
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <bitset>
 #include <chrono>
 #include <concepts>
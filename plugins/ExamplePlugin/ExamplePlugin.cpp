@@ -12,6 +12,27 @@
 
 namespace {
     bool redirect_slash_ee_to_eee = false;
+
+    // Benchmark: CPU time to burn every frame, either in Update() or on the Toolbox worker thread.
+    // Watch the Update timing and over budget count in Settings > Plugins while changing these.
+    float simulated_work_ms = 0.f;
+    bool offload_simulated_work = false;
+
+    std::atomic_uint32_t tasks_in_flight = 0;
+    uint32_t tasks_completed = 0;
+    double last_task_ms = 0.0;
+
+    // Stand-in for real work a plugin might do each frame; returns the time actually taken
+    double SimulateWork(const float ms)
+    {
+        const auto started = std::chrono::steady_clock::now();
+        const auto until = started + std::chrono::duration<float, std::milli>(ms);
+        volatile uint32_t sink = 0;
+        while (std::chrono::steady_clock::now() < until) {
+            sink = sink * 1664525u + 1013904223u;
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    }
 }
 
 DLLAPI ToolboxPlugin* ToolboxPluginInstance()
@@ -24,12 +45,16 @@ void ExamplePlugin::LoadSettings(const wchar_t* folder)
 {
     ToolboxUIPlugin::LoadSettings(folder);
     PLUGIN_LOAD_BOOL(redirect_slash_ee_to_eee);
+    PLUGIN_LOAD_FLOAT(simulated_work_ms);
+    PLUGIN_LOAD_BOOL(offload_simulated_work);
 }
 
 void ExamplePlugin::SaveSettings(const wchar_t* folder)
 {
     ToolboxUIPlugin::SaveSettings(folder);
     PLUGIN_SAVE_BOOL(redirect_slash_ee_to_eee);
+    PLUGIN_SAVE_FLOAT(simulated_work_ms);
+    PLUGIN_SAVE_BOOL(offload_simulated_work);
     PLUGIN_ASSERT(ini.SaveFile(GetSettingFile(folder).c_str()) == SI_OK);
 }
 
@@ -39,6 +64,39 @@ void ExamplePlugin::DrawSettings()
         return;
     }
     ImGui::Checkbox("Redirect ee to eee", &redirect_slash_ee_to_eee);
+    ImGui::Separator();
+    ImGui::DragFloat("Simulated work per frame", &simulated_work_ms, 0.1f, 0.f, 50.f, "%.1f ms");
+    ImGui::Checkbox("Run simulated work on the worker thread", &offload_simulated_work);
+    ImGui::Text("Worker tasks completed: %u, last took %.2f ms", tasks_completed, last_task_ms);
+}
+
+void ExamplePlugin::Update(float)
+{
+    if (simulated_work_ms <= 0.f) {
+        return;
+    }
+    if (!offload_simulated_work) {
+        SimulateWork(simulated_work_ms);
+        return;
+    }
+    if (tasks_in_flight) {
+        return; // One at a time, so a slow worker doesn't pile up tasks
+    }
+    ++tasks_in_flight;
+    const bool queued = EnqueueWorkerTask([this, ms = simulated_work_ms] {
+        const double elapsed = SimulateWork(ms);
+        // Hand the result back to the game thread
+        if (!EnqueueMainTask([elapsed] {
+            last_task_ms = elapsed;
+            tasks_completed++;
+            --tasks_in_flight;
+        })) {
+            --tasks_in_flight;
+        }
+    });
+    if (!queued) {
+        --tasks_in_flight;
+    }
 }
 
 void ExamplePlugin::Initialize(ImGuiContext* ctx, const ImGuiAllocFns allocator_fns, const HMODULE toolbox_dll)
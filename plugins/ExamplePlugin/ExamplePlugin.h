@@ -21,6 +21,8 @@ public:
     void Initialize(ImGuiContext* ctx, ImGuiAllocFns allocator_fns, HMODULE toolbox_dll) override;
     void SignalTerminate() override;
     bool CanTerminate() override;
+    // Burns simulated_work_ms each frame, here or on the worker thread, to exercise plugin timing and the async API
+    void Update(float) override;
     // Draw user interface. Will be called every frame if the element is visible
     void Draw(IDirect3DDevice9* pDevice) override;
 };